@@ -0,0 +1,211 @@
+#include <random>
+#include <fstream>
+
+#include "catalog.hpp"
+
+using namespace MBench;
+
+namespace {
+	const char *firstNames[] = {"John", "Jane", "Alex", "Sam", "Robin", "Kim", "Lee", "Morgan", "Casey", "Drew",
+		"Jordan", "Taylor", "Avery", "Riley", "Quinn", "Dr. Pat"};
+	const char *lastNames[] = {"Doe", "Smith", "Nguyen", "Garcia", "Miller", "Okafor", "Ivanova", "Tanaka",
+		"Schmidt", "Rossi", "Kowalski", "Haddad"};
+	const char *types[] = {"collection", "ssm", "csm", "res"};
+	const char *licenses[] = {"MIT", "Apache-2.0", "GPL-3.0", "BSD-3-Clause"};
+
+	// [string] Version string drawn from a release history with occasional prereleases
+	std::string randomVersion(std::mt19937 &rng) {
+		std::string v = std::to_string(rng() % 5) + "." + std::to_string(rng() % 15) + "." + std::to_string(rng() % 20);
+		if (rng() % 10 == 0)
+			v += std::string(rng() % 2 ? "-beta." : "-rc.") + std::to_string(1 + rng() % 5);
+		return v;
+	}
+
+	// [string] Range string in one of the shapes manifests commonly use
+	std::string randomRange(std::mt19937 &rng) {
+		unsigned int major = rng() % 5;
+		unsigned int minor = rng() % 10;
+		switch (rng() % 4) {
+			case 0:
+				return std::to_string(major) + "." + std::to_string(minor) + ".0";
+			case 1:
+				return ">=" + std::to_string(major) + "." + std::to_string(minor) + ".0";
+			case 2:
+				return ">=" + std::to_string(major) + "." + std::to_string(minor) + ".0 <" + std::to_string(major + 1) + ".0.0";
+			default:
+				return ">=0." + std::to_string(minor) + ".0 <1.0.0 || >=" + std::to_string(major + 1) + ".0.0";
+		}
+	}
+
+	// [string] Person string from a small pool, so authors recur across packages as in real catalogs
+	std::string randomPerson(std::mt19937 &rng) {
+		std::string first = firstNames[rng() % 16];
+		std::string last = lastNames[rng() % 12];
+		std::string person = first + " " + last;
+		std::string handle = std::string(1, std::tolower(first.back())) + std::to_string(rng() % 4);
+
+		if (rng() % 2)
+			person += " <" + handle + "@example.com>";
+		if (rng() % 3 == 0)
+			person += " (https://example.com/~" + handle + ")";
+		return person;
+	}
+}
+
+/* Catalog Package Class */
+
+// [constructor] Forward to Package
+CatalogPackage::CatalogPackage(std::string path, const Json::Value &obj): Package(std::move(path), obj) {}
+CatalogPackage::CatalogPackage(std::string path, std::string_view manifest): Package(std::move(path), manifest) {}
+CatalogPackage::CatalogPackage(std::string path, const MPackages::Manifest &manifest): Package(std::move(path), manifest) {}
+CatalogPackage::CatalogPackage(std::string path, Package::checked &&fields): Package(std::move(path), std::move(fields)) {}
+
+// [bool] Nothing to run
+bool CatalogPackage::run() {
+	return true;
+}
+
+// [vector of strings] Generate manifests for `count` packages; dependencies only point at earlier packages
+std::vector<std::string> MBench::catalogManifests(std::size_t count, unsigned int seed) {
+	std::mt19937 rng(seed);
+	std::vector<std::string> out;
+	Json::StreamWriterBuilder builder;
+	builder["indentation"] = "\t";
+
+	for (std::size_t i = 0; i < count; i++) {
+		std::string name = "pkg-" + std::to_string(i);
+		Json::Value pkg;
+
+		pkg["name"] = name;
+		pkg["version"] = randomVersion(rng);
+		pkg["title"] = "Package " + std::to_string(i);
+		pkg["description"] = "Synthetic package number " + std::to_string(i) + " for benchmarking manifest loading.";
+		pkg["keywords"].append("synthetic");
+		pkg["keywords"].append("bench");
+		pkg["homepage"] = "https://example.com/packages/" + name;
+		pkg["bugs"]["url"] = "https://example.com/packages/" + name + "/issues";
+		pkg["bugs"]["email"] = "bugs@example.com";
+		pkg["license"] = licenses[rng() % 4];
+
+		if (rng() % 4 == 0) {
+			Json::Value author;
+			author["name"] = std::string(firstNames[rng() % 16]) + " " + lastNames[rng() % 12];
+			author["email"] = "author@example.com";
+			pkg["author"] = author;
+		} else {
+			pkg["author"] = randomPerson(rng);
+		}
+
+		unsigned int contributors = rng() % 6;
+		for (unsigned int c = 0; c < contributors; c++)
+			pkg["contributors"].append(randomPerson(rng));
+
+		pkg["repository"] = "https://example.com/git/" + name + ".git";
+
+		unsigned int dependencies = (i == 0) ? 0 : rng() % 8;
+		for (unsigned int d = 0; d < dependencies; d++)
+			pkg["dependencies"][std::string(types[rng() % 4]) + ":pkg-" + std::to_string(rng() % i)] = randomRange(rng);
+
+		unsigned int optional = (i == 0) ? 0 : rng() % 3;
+		for (unsigned int d = 0; d < optional; d++)
+			pkg["optionalDependencies"]["res:pkg-" + std::to_string(rng() % i)] = randomRange(rng);
+
+		pkg["private"] = (rng() % 10 == 0);
+
+		out.push_back(Json::writeString(builder, pkg));
+	}
+
+	return out;
+}
+
+// [vector of strings] Generate dependency graph manifests; versions run 1.0.0 to 1.4.0, 2.0.0 to 2.4.0, ...
+std::vector<std::string> MBench::dependencyGraph(std::size_t packages, std::size_t versions, bool conflicts,
+		unsigned int seed) {
+	std::mt19937 rng(seed);
+	std::vector<std::string> out;
+	out.reserve(packages * versions);
+	Json::StreamWriterBuilder builder;
+	builder["indentation"] = "";
+
+	for (std::size_t i = 0; i < packages; i++) {
+		// Each package depends on a few of the next 200 packages, across all of its versions
+		std::vector<std::size_t> targets;
+		unsigned int count = (i + 1 < packages) ? 2 + rng() % 4 : 0;
+		for (unsigned int d = 0; d < count; d++)
+			targets.push_back(std::min(packages - 1, i + 1 + rng() % 200));
+		bool broken = conflicts && i + 1 < packages && rng() % 10 == 0;
+
+		for (std::size_t v = 0; v < versions; v++) {
+			std::size_t major = 1 + v / 5;
+			Json::Value pkg;
+			pkg["name"] = "pkg-" + std::to_string(i);
+			pkg["version"] = std::to_string(major) + "." + std::to_string(v % 5) + ".0";
+
+			// Later minors require later minors of the same major
+			for (std::size_t t: targets)
+				pkg["dependencies"]["res:pkg-" + std::to_string(t)] = ">=" + std::to_string(major) + "." +
+					((v % 5 >= 3) ? "2" : "0") + ".0 <" + std::to_string(major + 1) + ".0.0";
+
+			if (broken && v + 5 >= versions)
+				pkg["dependencies"]["res:pkg-" + std::to_string(i + 1)] = "<1.0.0";
+
+			out.push_back(Json::writeString(builder, pkg));
+		}
+	}
+
+	return out;
+}
+
+// [vector of strings] Generate person strings
+std::vector<std::string> MBench::personStrings(std::size_t count, unsigned int seed) {
+	std::mt19937 rng(seed);
+	std::vector<std::string> out;
+	for (std::size_t i = 0; i < count; i++)
+		out.push_back(randomPerson(rng));
+	return out;
+}
+
+// [vector of strings] Generate version strings
+std::vector<std::string> MBench::versionStrings(std::size_t count, unsigned int seed) {
+	std::mt19937 rng(seed);
+	std::vector<std::string> out;
+	for (std::size_t i = 0; i < count; i++)
+		out.push_back(randomVersion(rng));
+	return out;
+}
+
+// [vector of strings] Generate range strings
+std::vector<std::string> MBench::rangeStrings(std::size_t count, unsigned int seed) {
+	std::mt19937 rng(seed);
+	std::vector<std::string> out;
+	for (std::size_t i = 0; i < count; i++)
+		out.push_back(randomRange(rng));
+	return out;
+}
+
+// [path] Write `count` files below a temporary root; a marker tells later runs that the tree is complete
+std::filesystem::path MBench::writeTree(const std::string &name, std::size_t count,
+		const std::function<std::pair<std::string, std::string>(std::size_t)> &file) {
+	namespace fs = std::filesystem;
+	fs::path root = fs::temp_directory_path() / ("eden-" + name + "-bench-" + std::to_string(count));
+	if (fs::exists(root / "complete"))
+		return root;
+
+	fs::remove_all(root);
+	for (std::size_t i = 0; i < count; i++) {
+		std::pair<std::string, std::string> f = file(i);
+		fs::create_directories((root / f.first).parent_path());
+		std::ofstream(root / f.first, std::ios::binary) << f.second;
+	}
+
+	std::ofstream(root / "complete");
+	return root;
+}
+
+// [path] Write manifests below a temporary root, as group-N/pkg-I/package.json
+std::filesystem::path MBench::writeTree(const std::string &name, const std::vector<std::string> &manifests) {
+	return MBench::writeTree(name, manifests.size(), [&manifests](std::size_t i) {
+		return std::make_pair("group-" + std::to_string(i / 100) + "/pkg-" + std::to_string(i) + "/" +
+			MPackages::Loader::manifestName, manifests[i]);
+	});
+}
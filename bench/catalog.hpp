@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <filesystem>
+#include <json/json.h>
+
+#include <packages/package.hpp>
+#include <packages/manifest.hpp>
+#include <packages/loader.hpp>
+
+namespace MBench {
+
+// [class] Concrete package used to construct synthetic catalogs
+class CatalogPackage: public MPackages::Package {
+	public:
+		CatalogPackage(std::string path, const Json::Value &obj);
+		CatalogPackage(std::string path, std::string_view manifest);
+		CatalogPackage(std::string path, const MPackages::Manifest &manifest);
+		CatalogPackage(std::string path, MPackages::Package::checked &&fields);
+
+		bool run();
+};
+
+// Deterministic synthetic data shaped like a community package catalog
+std::vector<std::string> catalogManifests(std::size_t count, unsigned int seed = 1);
+std::vector<std::string> personStrings(std::size_t count, unsigned int seed = 1);
+std::vector<std::string> versionStrings(std::size_t count, unsigned int seed = 1);
+std::vector<std::string> rangeStrings(std::size_t count, unsigned int seed = 1);
+
+// Manifests of `packages` packages with `versions` versions each, depending only on packages with higher
+// numbers; with conflicts, some newest versions need a version that does not exist, forcing backtracking
+std::vector<std::string> dependencyGraph(std::size_t packages, std::size_t versions, bool conflicts,
+	unsigned int seed = 1);
+
+// Write `count` files below a temporary root named after the benchmark, once; file(i) gives the path of file i,
+// relative to the root, and its contents
+std::filesystem::path writeTree(const std::string &name, std::size_t count,
+	const std::function<std::pair<std::string, std::string>(std::size_t)> &file);
+// Write manifests below a temporary root, once, in directories of 100 packages
+std::filesystem::path writeTree(const std::string &name, const std::vector<std::string> &manifests);
+
+}
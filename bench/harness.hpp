@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace MBench {
+
+// Heap allocation counters, maintained by the replaced global operator new and delete
+extern std::atomic<std::uint64_t> allocations;
+extern std::atomic<std::uint64_t> allocatedBytes;
+extern std::atomic<std::uint64_t> deallocations;
+
+// [class] Per-benchmark measurement state
+class State {
+	public:
+		State(double minSeconds, std::size_t size);
+
+		// [void] Time the operation, growing the iteration count until the minimum run time is reached
+		template<typename F> void measure(F operation) {
+			std::size_t iterations = 1;
+			while (true) {
+				std::uint64_t allocs = allocations.load(std::memory_order_relaxed);
+				std::uint64_t bytes = allocatedBytes.load(std::memory_order_relaxed);
+				auto start = std::chrono::steady_clock::now();
+				for (std::size_t i = 0; i < iterations; i++)
+					operation();
+				double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+				if (elapsed >= this->minSeconds || iterations >= (std::size_t(1) << 40)) {
+					this->iterations = iterations;
+					this->nsPerOp = (elapsed * 1e9) / iterations;
+					this->allocsPerOp = double(allocations.load(std::memory_order_relaxed) - allocs) / iterations;
+					this->bytesPerOp = double(allocatedBytes.load(std::memory_order_relaxed) - bytes) / iterations;
+					return;
+				}
+
+				iterations *= 2;
+			}
+		}
+
+		double minSeconds;
+		std::size_t size; // Synthetic catalog size requested on the command line
+		std::size_t iterations = 0;
+		double nsPerOp = 0;
+		double allocsPerOp = 0;
+		double bytesPerOp = 0;
+		std::vector<std::pair<std::string, double>> counters; // Extra named results, e.g. bytes per package
+};
+
+// [void] Keep the compiler from discarding a computed value
+template<typename T> inline void doNotOptimize(const T &value) {
+	asm volatile("" : : "g"(&value) : "memory");
+}
+
+typedef std::function<void(State &state)> Function;
+
+// [class] Registers a benchmark at static initialization time
+class Registrar {
+	public:
+		Registrar(const std::string &name, Function fn);
+};
+
+struct Benchmark {
+	std::string name;
+	Function fn;
+};
+
+std::vector<Benchmark> &benchmarks();
+
+}
+
+#define MBENCH_CONCAT_IMPL(a, b) a##b
+#define MBENCH_CONCAT(a, b) MBENCH_CONCAT_IMPL(a, b)
+
+// Define a benchmark body receiving `MBench::State &state`
+#define BENCHMARK_CASE(name) \
+	static void MBENCH_CONCAT(mbenchCase, __LINE__)(MBench::State &state); \
+	static MBench::Registrar MBENCH_CONCAT(mbenchRegistrar, __LINE__)(name, MBENCH_CONCAT(mbenchCase, __LINE__)); \
+	static void MBENCH_CONCAT(mbenchCase, __LINE__)(MBench::State &state)
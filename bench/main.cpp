@@ -0,0 +1,122 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+#include <json/json.h>
+
+#include "harness.hpp"
+
+using namespace MBench;
+
+std::atomic<std::uint64_t> MBench::allocations(0);
+std::atomic<std::uint64_t> MBench::allocatedBytes(0);
+std::atomic<std::uint64_t> MBench::deallocations(0);
+
+// Count every heap allocation made through operator new, and every release
+void *operator new(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+	if (void *p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+void *operator new[](std::size_t size) {
+	return operator new(size);
+}
+void operator delete(void *p) noexcept {
+	if (p)
+		deallocations.fetch_add(1, std::memory_order_relaxed);
+	std::free(p);
+}
+void operator delete[](void *p) noexcept {
+	operator delete(p);
+}
+void operator delete(void *p, std::size_t) noexcept {
+	operator delete(p);
+}
+void operator delete[](void *p, std::size_t) noexcept {
+	operator delete(p);
+}
+
+/* Benchmark Harness */
+
+// [constructor] With minimum run time in seconds and synthetic catalog size
+State::State(double minSeconds, std::size_t size): minSeconds(minSeconds), size(size) {}
+
+// [constructor] Add benchmark to the global list
+Registrar::Registrar(const std::string &name, Function fn) {
+	benchmarks().push_back({name, fn});
+}
+
+// [vector of benchmarks] Get global benchmark list
+std::vector<Benchmark> &MBench::benchmarks() {
+	static std::vector<Benchmark> list;
+	return list;
+}
+
+// Usage: Benchmarks [name filter] [--time seconds] [--size packages] [--json file]
+int main(int argc, char **argv) {
+	std::string filter = "";
+	std::string jsonPath = "";
+	double minSeconds = 0.2;
+	std::size_t size = 1000;
+
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+			minSeconds = std::stod(argv[++i]);
+		} else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+			size = std::stoul(argv[++i]);
+		} else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+			jsonPath = argv[++i];
+		} else {
+			filter = argv[i];
+		}
+	}
+
+	Json::Value results(Json::arrayValue);
+
+	std::printf("%-52s %12s %14s %12s %12s\n", "benchmark", "iterations", "ns/op", "allocs/op", "bytes/op");
+	for (auto const &b: benchmarks()) {
+		if (!filter.empty() && b.name.find(filter) == std::string::npos)
+			continue;
+
+		State state(minSeconds, size);
+		b.fn(state);
+		std::printf("%-52s %12zu %14.2f %12.2f %12.1f\n", b.name.c_str(), state.iterations, state.nsPerOp,
+			state.allocsPerOp, state.bytesPerOp);
+		for (auto const &c: state.counters)
+			std::printf("    %-48s %14.2f\n", c.first.c_str(), c.second);
+
+		Json::Value result;
+		result["name"] = b.name;
+		result["iterations"] = Json::UInt64(state.iterations);
+		result["nsPerOp"] = state.nsPerOp;
+		result["allocsPerOp"] = state.allocsPerOp;
+		result["bytesPerOp"] = state.bytesPerOp;
+		for (auto const &c: state.counters)
+			result["counters"][c.first] = c.second;
+		results.append(result);
+	}
+
+	// Write machine-readable results for comparison between releases
+	if (!jsonPath.empty()) {
+		Json::Value root;
+		root["catalogSize"] = Json::UInt64(size);
+		root["minSeconds"] = minSeconds;
+		root["benchmarks"] = results;
+
+		std::ofstream out(jsonPath);
+		Json::StreamWriterBuilder builder;
+		builder["indentation"] = "\t";
+		out << Json::writeString(builder, root) << std::endl;
+		if (!out) {
+			std::fprintf(stderr, "Failed to write %s\n", jsonPath.c_str());
+			return 1;
+		}
+	}
+
+	return 0;
+}
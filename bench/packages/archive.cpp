@@ -0,0 +1,104 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <packages/archive.hpp>
+
+using namespace MPackages;
+
+namespace fs = std::filesystem;
+
+namespace {
+	const std::size_t fileSize = 4096;
+
+	// [path] Write a package directory of --size files of 4 KiB in nested directories, and pack it
+	fs::path writePackage(std::size_t size) {
+		fs::path root = MBench::writeTree("archive", size, [](std::size_t i) {
+			return std::make_pair("package/group-" + std::to_string(i / 100) + "/file-" + std::to_string(i) + ".dat",
+				std::string(fileSize, static_cast<char>('a' + i % 26)));
+		});
+		if (!fs::exists(root / "package.epk"))
+			Archive::pack((root / "package").string(), (root / "package.epk").string());
+		return root;
+	}
+
+	// [uint64] Touch one byte per cache line, so that reading is measured rather than hashing
+	std::uint64_t touch(std::string_view bytes) {
+		std::uint64_t sum = 0;
+		for (std::size_t i = 0; i < bytes.size(); i += 64)
+			sum += static_cast<unsigned char>(bytes[i]);
+		return sum;
+	}
+
+	// [vector of strings] Paths of the files, relative to the package directory
+	std::vector<std::string> paths(std::size_t size) {
+		std::vector<std::string> out;
+		for (std::size_t i = 0; i < size; i++)
+			out.push_back("group-" + std::to_string(i / 100) + "/file-" + std::to_string(i) + ".dat");
+		return out;
+	}
+}
+
+BENCHMARK_CASE("archive/read every file from a directory") {
+	fs::path root = writePackage(state.size);
+	std::vector<std::string> files = paths(state.size);
+	std::string buffer(fileSize, '\0');
+
+	state.measure([&] {
+		std::uint64_t sum = 0;
+		for (auto const &f: files) {
+			std::ifstream in(root / "package" / f, std::ios::binary);
+			in.read(&buffer[0], fileSize);
+			sum += touch(std::string_view(buffer.data(), static_cast<std::size_t>(in.gcount())));
+		}
+		MBench::doNotOptimize(sum);
+	});
+
+	state.counters.push_back({"files", static_cast<double>(files.size())});
+	state.counters.push_back({"ns/file", state.nsPerOp / files.size()});
+}
+
+BENCHMARK_CASE("archive/read every file from an archive") {
+	fs::path root = writePackage(state.size);
+	std::vector<std::string> files = paths(state.size);
+
+	state.measure([&] {
+		Archive archive((root / "package.epk").string());
+		std::uint64_t sum = 0;
+		for (auto const &f: files)
+			sum += touch(archive.read(f));
+		MBench::doNotOptimize(sum);
+	});
+
+	state.counters.push_back({"files", static_cast<double>(files.size())});
+	state.counters.push_back({"ns/file", state.nsPerOp / files.size()});
+}
+
+BENCHMARK_CASE("archive/open archive") {
+	fs::path root = writePackage(state.size);
+
+	state.measure([&] {
+		Archive archive((root / "package.epk").string());
+		MBench::doNotOptimize(archive);
+	});
+
+	state.counters.push_back({"ns/file", state.nsPerOp / state.size});
+}
+
+BENCHMARK_CASE("archive/find files by path") {
+	fs::path root = writePackage(state.size);
+	std::vector<std::string> files = paths(state.size);
+	Archive archive((root / "package.epk").string());
+
+	state.measure([&] {
+		std::size_t found = 0;
+		for (auto const &f: files)
+			found += archive.find(f) != nullptr;
+		MBench::doNotOptimize(found);
+	});
+
+	state.counters.push_back({"ns/lookup", state.nsPerOp / files.size()});
+}
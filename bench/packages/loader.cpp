@@ -0,0 +1,58 @@
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <packages/loader.hpp>
+
+using namespace MPackages;
+
+namespace fs = std::filesystem;
+
+namespace {
+	// [void] Load the catalog with the given number of threads; files are usually in the page cache
+	void loadCatalog(MBench::State &state, std::size_t threads, bool cached = false) {
+		Loader loader([](std::string path, const Manifest &manifest) {
+			return std::unique_ptr<Package>(new MBench::CatalogPackage(std::move(path), manifest));
+		}, threads);
+		fs::path root = MBench::writeTree("loader", MBench::catalogManifests(state.size));
+		loader.addRoot(root.string());
+
+		// Warm the cache outside of the measurement
+		if (cached) {
+			loader.setCache((root / "manifests.cache").string());
+			loader.load();
+		}
+
+		Loader::result last;
+		state.measure([&] {
+			last = loader.load();
+			MBench::doNotOptimize(last);
+		});
+
+		auto ms = [](std::chrono::nanoseconds ns) { return ns.count() / 1e6; };
+		state.counters.push_back({"packages", static_cast<double>(last.packages.size())});
+		state.counters.push_back({"scan ms", ms(last.time.scan)});
+		state.counters.push_back({"read ms (summed)", ms(last.time.read)});
+		state.counters.push_back({"parse ms (summed)", ms(last.time.parse)});
+		state.counters.push_back({"validate ms", ms(last.time.validate)});
+		state.counters.push_back({"cache ms", ms(last.time.cache)});
+		state.counters.push_back({"cached", static_cast<double>(last.cached)});
+		state.counters.push_back({"total ms", ms(last.time.total)});
+	}
+}
+
+BENCHMARK_CASE("loader/load catalog 1 thread") {
+	loadCatalog(state, 1);
+}
+
+BENCHMARK_CASE("loader/load catalog warm cache") {
+	loadCatalog(state, 1, true);
+}
+
+BENCHMARK_CASE("loader/load catalog all threads") {
+	loadCatalog(state, std::thread::hardware_concurrency());
+	state.counters.push_back({"threads", static_cast<double>(std::thread::hardware_concurrency())});
+}
@@ -0,0 +1,114 @@
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <packages/loader.hpp>
+#include <packages/lockfile.hpp>
+#include <packages/resolver.hpp>
+
+using namespace MPackages;
+
+namespace fs = std::filesystem;
+
+namespace {
+	const std::size_t versions = 5;
+
+	// [path] Write a synthetic dependency graph (--size packages, 5 versions each) below a temporary root
+	fs::path writeGraph(std::size_t size) {
+		return MBench::writeTree("lockfile", MBench::dependencyGraph(size, versions, false));
+	}
+
+	// [Loader] Loader of catalog packages on every hardware thread
+	Loader makeLoader(const fs::path &root) {
+		Loader loader([](std::string path, const Manifest &manifest) {
+			return std::unique_ptr<Package>(new MBench::CatalogPackage(std::move(path), manifest));
+		});
+		loader.addRoot(root.string());
+		return loader;
+	}
+
+	// [map] Requirements of the synthetic graph: its first ten packages
+	std::map<std::string, MUtilities::Range> requirements(std::size_t packages) {
+		std::map<std::string, MUtilities::Range> out;
+		for (std::size_t i = 0; i < 10 && i < packages; i++)
+			out.emplace("res:pkg-" + std::to_string(i), MUtilities::Range::all());
+		return out;
+	}
+
+	// [path] Resolve the graph once and lock the solution, in the text and binary forms
+	fs::path writeLock(const fs::path &root, std::size_t size) {
+		Registry registry(makeLoader(root).load().packages);
+		Resolver resolver(registry);
+		Lockfile lock(registry, resolver.resolve(requirements(size)).packages);
+
+		lock.write((root / "packages.lock").string());
+		lock.writeBinary((root / "packages.lockb").string());
+		return root / "packages.lock";
+	}
+}
+
+BENCHMARK_CASE("lockfile/boot by scanning and resolving") {
+	fs::path root = writeGraph(state.size);
+	Loader loader = makeLoader(root);
+	std::size_t chosen = 0;
+
+	state.measure([&] {
+		Registry registry(loader.load().packages);
+		Resolver resolver(registry);
+		chosen = resolver.resolve(requirements(state.size)).packages.size();
+		MBench::doNotOptimize(chosen);
+	});
+
+	state.counters.push_back({"manifests", static_cast<double>(state.size * versions)});
+	state.counters.push_back({"chosen", static_cast<double>(chosen)});
+	state.counters.push_back({"ms", state.nsPerOp / 1e6});
+}
+
+BENCHMARK_CASE("lockfile/boot from lockfile") {
+	fs::path root = writeGraph(state.size);
+	fs::path path = writeLock(root, state.size);
+	Loader loader = makeLoader(root);
+	Loader::result last;
+
+	state.measure([&] {
+		Lockfile lock((root / "packages.lockb").string());
+		last = loader.load(lock);
+		MBench::doNotOptimize(last);
+	});
+
+	state.counters.push_back({"chosen", static_cast<double>(last.packages.size())});
+	state.counters.push_back({"errors", static_cast<double>(last.errors.size())});
+	state.counters.push_back({"ms", state.nsPerOp / 1e6});
+	state.counters.push_back({"text bytes", static_cast<double>(fs::file_size(path))});
+}
+
+BENCHMARK_CASE("lockfile/verify hashes") {
+	fs::path root = writeGraph(state.size);
+	writeLock(root, state.size);
+	Lockfile lock((root / "packages.lockb").string());
+	std::size_t changed = 0;
+
+	state.measure([&] {
+		changed = lock.verify().size();
+		MBench::doNotOptimize(changed);
+	});
+
+	state.counters.push_back({"entries", static_cast<double>(lock.size())});
+	state.counters.push_back({"changed", static_cast<double>(changed)});
+	state.counters.push_back({"us per entry", state.nsPerOp / 1e3 / std::max<std::size_t>(lock.size(), 1)});
+}
+
+BENCHMARK_CASE("lockfile/read text and binary forms") {
+	fs::path root = writeGraph(state.size);
+	fs::path path = writeLock(root, state.size);
+	std::size_t entries = 0;
+
+	state.measure([&] {
+		entries = Lockfile(path.string()).size() + Lockfile((root / "packages.lockb").string()).size();
+		MBench::doNotOptimize(entries);
+	});
+
+	state.counters.push_back({"entries", static_cast<double>(entries / 2)});
+}
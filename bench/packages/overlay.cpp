@@ -0,0 +1,123 @@
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <packages/overlay.hpp>
+
+using namespace MPackages;
+
+namespace fs = std::filesystem;
+
+namespace {
+	const std::size_t filesPerPackage = 50;
+	const std::size_t sharedFiles = 10; // Of each package, at paths every package has
+
+	// [vector of strings] Archives of --size / 10 packages with 50 small files each, packed below a temporary root
+	std::vector<std::string> writePackages(std::size_t size) {
+		std::size_t packages = std::max<std::size_t>(1, size / 10);
+		fs::path root = MBench::writeTree("overlay", packages * filesPerPackage, [](std::size_t i) {
+			std::size_t p = i / filesPerPackage, f = i % filesPerPackage;
+			std::string dir = "pkg-" + std::to_string(p) + "/";
+			return std::make_pair((f < sharedFiles) ? dir + "shared/file-" + std::to_string(f) :
+				dir + "own/pkg-" + std::to_string(p) + "/file-" + std::to_string(f), std::string("contents"));
+		});
+
+		std::vector<std::string> out;
+		for (std::size_t p = 0; p < packages; p++) {
+			fs::path dir = root / ("pkg-" + std::to_string(p));
+			out.push_back(dir.string() + Archive::extension);
+			if (!fs::exists(out.back()))
+				Archive::pack(dir.string(), out.back());
+		}
+		return out;
+	}
+
+	// [vector of strings] Every visible path
+	std::vector<std::string> paths(std::size_t packages) {
+		std::vector<std::string> out;
+		for (std::size_t p = 0; p < packages; p++)
+			for (std::size_t f = 0; f < filesPerPackage; f++)
+				out.push_back((f < sharedFiles) ? (p == 0 ? "shared/file-" + std::to_string(f) : "") :
+					"own/pkg-" + std::to_string(p) + "/file-" + std::to_string(f));
+		out.erase(std::remove(out.begin(), out.end(), ""), out.end());
+		return out;
+	}
+
+	// [void] Mount every package
+	void mountAll(Overlay &overlay, const std::vector<std::string> &archives) {
+		for (std::size_t p = 0; p < archives.size(); p++)
+			overlay.mount("pkg-" + std::to_string(p), archives[p]);
+	}
+}
+
+BENCHMARK_CASE("overlay/mount every package") {
+	std::vector<std::string> archives = writePackages(state.size);
+	std::size_t visible = 0;
+
+	state.measure([&] {
+		Overlay overlay;
+		mountAll(overlay, archives);
+		visible = overlay.size();
+		MBench::doNotOptimize(overlay);
+	});
+
+	state.counters.push_back({"packages", static_cast<double>(archives.size())});
+	state.counters.push_back({"visible paths", static_cast<double>(visible)});
+	state.counters.push_back({"ns/file", state.nsPerOp / (archives.size() * filesPerPackage)});
+}
+
+BENCHMARK_CASE("overlay/find paths in the index") {
+	std::vector<std::string> archives = writePackages(state.size);
+	std::vector<std::string> files = paths(archives.size());
+	Overlay overlay;
+	mountAll(overlay, archives);
+
+	state.measure([&] {
+		std::size_t found = 0;
+		for (auto const &f: files)
+			found += overlay.owner(f) != Overlay::none;
+		MBench::doNotOptimize(found);
+	});
+
+	state.counters.push_back({"ns/lookup", state.nsPerOp / files.size()});
+}
+
+// Baseline for the index: asking every mount in turn, from the last
+BENCHMARK_CASE("overlay/find paths by probing every mount") {
+	std::vector<std::string> archives = writePackages(state.size);
+	std::vector<std::string> files = paths(archives.size());
+	std::vector<Archive> mounts;
+	for (auto const &a: archives)
+		mounts.emplace_back(a);
+
+	state.measure([&] {
+		std::size_t found = 0;
+		for (auto const &f: files) {
+			for (std::size_t m = mounts.size(); m-- > 0;) {
+				if (mounts[m].find(f)) {
+					found++;
+					break;
+				}
+			}
+		}
+		MBench::doNotOptimize(found);
+	});
+
+	state.counters.push_back({"ns/lookup", state.nsPerOp / files.size()});
+}
+
+BENCHMARK_CASE("overlay/remount one package") {
+	std::vector<std::string> archives = writePackages(state.size);
+	Overlay overlay;
+	mountAll(overlay, archives);
+	Overlay::handle middle = overlay.mounts()[archives.size() / 2];
+
+	state.measure([&] {
+		overlay.remount(middle);
+	});
+
+	state.counters.push_back({"visible paths", static_cast<double>(overlay.size())});
+	state.counters.push_back({"us", state.nsPerOp / 1e3});
+}
@@ -0,0 +1,189 @@
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <json/json.h>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <packages/package.hpp>
+#include <packages/cache.hpp>
+#include <utilities/utility.hpp>
+
+using namespace MUtilities;
+
+BENCHMARK_CASE("package/construct from json") {
+	auto manifests = MBench::catalogManifests(256);
+	std::vector<Json::Value> values;
+	for (auto const &m: manifests)
+		values.push_back(Utility::stojson(m));
+
+	std::size_t i = 0;
+	state.measure([&] {
+		MBench::CatalogPackage p("", values[i++ & 255]);
+		MBench::doNotOptimize(p);
+	});
+}
+
+// One operation loads the whole synthetic catalog (--size packages) from manifest strings
+BENCHMARK_CASE("package/load catalog") {
+	auto manifests = MBench::catalogManifests(state.size);
+	state.measure([&] {
+		std::vector<std::unique_ptr<MBench::CatalogPackage>> catalog;
+		catalog.reserve(manifests.size());
+		for (auto const &m: manifests)
+			catalog.emplace_back(new MBench::CatalogPackage("", Utility::stojson(m)));
+		MBench::doNotOptimize(catalog);
+	});
+
+	state.counters.push_back({"ns per package", state.nsPerOp / state.size});
+	state.counters.push_back({"allocs per package", state.allocsPerOp / state.size});
+}
+
+// Same catalog, streamed from manifest text without building a JSON document
+BENCHMARK_CASE("package/stream catalog") {
+	auto manifests = MBench::catalogManifests(state.size);
+	state.measure([&] {
+		std::vector<std::unique_ptr<MBench::CatalogPackage>> catalog;
+		catalog.reserve(manifests.size());
+		for (auto const &m: manifests)
+			catalog.emplace_back(new MBench::CatalogPackage("", std::string_view(m)));
+		MBench::doNotOptimize(catalog);
+	});
+
+	state.counters.push_back({"ns per package", state.nsPerOp / state.size});
+	state.counters.push_back({"allocs per package", state.allocsPerOp / state.size});
+}
+
+// Same catalog, decoded from manifest cache records
+BENCHMARK_CASE("package/decode catalog records") {
+	std::vector<std::string> records;
+	for (auto const &m: MBench::catalogManifests(state.size))
+		records.push_back(MPackages::ManifestCache::encode(MBench::CatalogPackage("", std::string_view(m))));
+
+	state.measure([&] {
+		std::vector<std::unique_ptr<MBench::CatalogPackage>> catalog;
+		catalog.reserve(records.size());
+		for (auto const &r: records)
+			catalog.emplace_back(new MBench::CatalogPackage("", MPackages::Manifest(r, MPackages::Manifest::Format::record)));
+		MBench::doNotOptimize(catalog);
+	});
+
+	state.counters.push_back({"ns per package", state.nsPerOp / state.size});
+	state.counters.push_back({"allocs per package", state.allocsPerOp / state.size});
+}
+
+// Same catalog streamed again; reports what each package keeps on the heap and the time to free the catalog
+BENCHMARK_CASE("package/stream and free catalog") {
+	auto manifests = MBench::catalogManifests(state.size);
+	double blocks = 0, bytes = 0;
+	std::chrono::nanoseconds freeing(0);
+	std::size_t runs = 0;
+
+	state.measure([&] {
+		std::vector<std::unique_ptr<MBench::CatalogPackage>> catalog;
+		catalog.reserve(manifests.size());
+		std::uint64_t allocated = MBench::allocations.load(std::memory_order_relaxed);
+		std::uint64_t released = MBench::deallocations.load(std::memory_order_relaxed);
+		for (auto const &m: manifests)
+			catalog.emplace_back(new MBench::CatalogPackage("", std::string_view(m)));
+
+		// Blocks allocated and not released while loading, less the package objects themselves
+		blocks = static_cast<double>((MBench::allocations.load(std::memory_order_relaxed) - allocated) -
+			(MBench::deallocations.load(std::memory_order_relaxed) - released)) / catalog.size() - 1;
+		bytes = 0;
+		for (auto const &p: catalog)
+			bytes += p->memoryUsage();
+
+		auto start = std::chrono::steady_clock::now();
+		catalog.clear();
+		freeing += std::chrono::steady_clock::now() - start;
+		runs++;
+	});
+
+	state.counters.push_back({"heap blocks per package", blocks});
+	state.counters.push_back({"bytes per package", bytes / state.size});
+	state.counters.push_back({"ns to free per package", static_cast<double>(freeing.count()) / runs / state.size});
+}
+
+namespace {
+	// [vector of JSON values] Catalog manifests with an invalid private status, the last field validated, so that
+	// throwing and reporting both check every field
+	std::vector<Json::Value> brokenManifests(std::size_t size) {
+		std::vector<Json::Value> values;
+		for (auto const &m: MBench::catalogManifests(size)) {
+			values.push_back(Utility::stojson(m));
+			values.back()["private"] = "no";
+		}
+		return values;
+	}
+}
+
+// Baseline for tryParse: rejecting each broken manifest (--size) by catching the constructor's exception
+BENCHMARK_CASE("package/reject broken manifests by exception") {
+	auto values = brokenManifests(state.size);
+	std::size_t rejected = 0;
+
+	state.measure([&] {
+		for (auto const &v: values) {
+			try {
+				MBench::CatalogPackage p("", v);
+				MBench::doNotOptimize(p);
+			} catch (const char *) {
+				rejected++;
+			}
+		}
+	});
+
+	MBench::doNotOptimize(rejected);
+	state.counters.push_back({"ns per manifest", state.nsPerOp / state.size});
+}
+
+// Reports every error of each broken manifest, without throwing
+BENCHMARK_CASE("package/diagnose broken manifests") {
+	auto values = brokenManifests(state.size);
+	std::size_t diagnostics = 0;
+
+	state.measure([&] {
+		for (auto const &v: values)
+			diagnostics += MPackages::Package::tryParse<MBench::CatalogPackage>("", v).diagnostics.size();
+	});
+
+	MBench::doNotOptimize(diagnostics);
+	state.counters.push_back({"ns per manifest", state.nsPerOp / state.size});
+}
+
+// Valid manifests are checked once, then sealed into the package as with the constructor
+BENCHMARK_CASE("package/try parse catalog") {
+	auto manifests = MBench::catalogManifests(state.size);
+	std::vector<Json::Value> values;
+	for (auto const &m: manifests)
+		values.push_back(Utility::stojson(m));
+
+	state.measure([&] {
+		for (auto const &v: values) {
+			auto result = MPackages::Package::tryParse<MBench::CatalogPackage>("", v);
+			MBench::doNotOptimize(result);
+		}
+	});
+
+	state.counters.push_back({"ns per package", state.nsPerOp / state.size});
+}
+
+// Walks every dependency of every package, as a resolver would; must not copy any manifest data
+BENCHMARK_CASE("package/walk dependencies") {
+	auto manifests = MBench::catalogManifests(state.size);
+	std::vector<std::unique_ptr<MBench::CatalogPackage>> catalog;
+	for (auto const &m: manifests)
+		catalog.emplace_back(new MBench::CatalogPackage("", Utility::stojson(m)));
+
+	state.measure([&] {
+		std::size_t edges = 0;
+		for (auto const &p: catalog)
+			for (auto const &[name, range]: p->dependencies())
+				edges += name.size() + range.intervals().size() + p->version().major();
+		MBench::doNotOptimize(edges);
+	});
+
+	state.counters.push_back({"ns per package", state.nsPerOp / state.size});
+}
@@ -0,0 +1,36 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <packages/registry.hpp>
+
+using namespace MPackages;
+
+// One operation looks up the best match of every dependency in the catalog (--size packages), as a
+// resolver's first pass would; also reports the memory the registry holds per package
+BENCHMARK_CASE("registry/match dependencies") {
+	std::vector<std::unique_ptr<Package>> packages;
+	for (auto const &m: MBench::catalogManifests(state.size))
+		packages.emplace_back(new MBench::CatalogPackage("", std::string_view(m)));
+	Registry registry(std::move(packages));
+
+	std::size_t found = 0, dependencies = 0;
+	state.measure([&] {
+		found = dependencies = 0;
+		for (Registry::id i = 0; i < registry.size(); i++) {
+			for (auto const &d: registry.get(i).dependencies()) {
+				found += registry.maxSatisfying(d.first, d.second) != Registry::none;
+				dependencies++;
+			}
+		}
+		MBench::doNotOptimize(found);
+	});
+
+	Registry::memory m = registry.memoryUsage();
+	state.counters.push_back({"ns per lookup", state.nsPerOp / dependencies});
+	state.counters.push_back({"matched", static_cast<double>(found) / dependencies});
+	state.counters.push_back({"package bytes per package", static_cast<double>(m.packages) / m.count});
+	state.counters.push_back({"index bytes per package", m.perPackage()});
+}
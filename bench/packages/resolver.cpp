@@ -0,0 +1,111 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <packages/resolver.hpp>
+
+using namespace MPackages;
+
+namespace {
+	// [map] Requirements of the synthetic graphs: their first ten packages
+	std::map<std::string, MUtilities::Range> requirements(std::size_t packages) {
+		std::map<std::string, MUtilities::Range> out;
+		for (std::size_t i = 0; i < 10 && i < packages; i++)
+			out.emplace("res:pkg-" + std::to_string(i), MUtilities::Range::all());
+		return out;
+	}
+
+	// [size_t] Number of a synthetic graph package, from its name
+	std::size_t number(const Package &pkg) {
+		return std::stoul(std::string(pkg.name().substr(4)));
+	}
+
+	// [void] Resolve a synthetic graph of --size packages with 20 versions each
+	void resolveGraph(MBench::State &state, bool conflicts) {
+		Registry registry;
+		for (auto const &m: MBench::dependencyGraph(state.size, 20, conflicts))
+			registry.add(std::unique_ptr<Package>(new MBench::CatalogPackage("", std::string_view(m))));
+
+		std::map<std::string, MUtilities::Range> requirements = ::requirements(state.size);
+		Resolver resolver(registry);
+		Resolver::result last;
+		state.measure([&] {
+			last = resolver.resolve(requirements);
+			MBench::doNotOptimize(last);
+		});
+
+		state.counters.push_back({"solved", last.solved ? 1.0 : 0.0});
+		state.counters.push_back({"chosen packages", static_cast<double>(last.packages.size())});
+		state.counters.push_back({"decisions", static_cast<double>(last.decisions)});
+		state.counters.push_back({"conflicts", static_cast<double>(last.conflicts)});
+		state.counters.push_back({"incompatibilities", static_cast<double>(last.incompatibilities)});
+		state.counters.push_back({"ms", state.nsPerOp / 1e6});
+	}
+
+	// [void] Update a resolved synthetic graph after one chosen package changes its manifest, each time
+	// adding a dependency on another chosen package, on one of two ranges. Unless conflicting, both ranges
+	// hold for the version chosen before.
+	void updateGraph(MBench::State &state, bool conflicting) {
+		std::vector<std::string> graph = MBench::dependencyGraph(state.size, 20, false);
+		Registry registry;
+		for (auto const &m: graph)
+			registry.add(std::unique_ptr<Package>(new MBench::CatalogPackage("", std::string_view(m))));
+
+		Resolver resolver(registry);
+		Resolver::result last = resolver.resolve(requirements(state.size));
+
+		// The changed package, and a package chosen at a newest minor version that it does not depend on yet
+		const std::string prefix = R"({"dependencies":{)";
+		Registry::id changed = Registry::none, target = Registry::none;
+		for (std::size_t i = last.packages.size() / 2; i < last.packages.size() && changed == Registry::none; i++) {
+			const Package &pkg = registry.get(last.packages[i]);
+			const MUtilities::Version &v = pkg.version();
+			if (graph[number(pkg) * 20 + (v.major() - 1) * 5 + v.minor()].compare(0, prefix.size(), prefix) == 0)
+				changed = last.packages[i];
+		}
+		for (Registry::id id: last.packages)
+			if (number(registry.get(id)) < number(registry.get(changed)) && registry.get(id).version().minor() == 4)
+				target = id;
+
+		const Package &pkg = registry.get(changed);
+		std::string manifest = graph[number(pkg) * 20 + (pkg.version().major() - 1) * 5 + pkg.version().minor()];
+		std::string version = registry.get(target).version().str();
+		std::string key = "\"res:" + std::string(registry.get(target).name()) + "\":\"";
+
+		std::string variants[2] = {manifest, manifest};
+		variants[0].insert(prefix.size(), key + (conflicting ? "<" : "<=") + version + "\",");
+		variants[1].insert(prefix.size(), key + ">=" + version + "\",");
+
+		std::size_t iteration = 0;
+		state.measure([&] {
+			registry.replace(changed, std::unique_ptr<Package>(new MBench::CatalogPackage("",
+				std::string_view(variants[iteration++ % 2]))));
+			last = resolver.update({changed});
+			MBench::doNotOptimize(last);
+		});
+
+		state.counters.push_back({"solved", last.solved ? 1.0 : 0.0});
+		state.counters.push_back({"chosen packages", static_cast<double>(last.packages.size())});
+		state.counters.push_back({"swaps", static_cast<double>(last.delta.size())});
+		state.counters.push_back({"decisions", static_cast<double>(last.decisions)});
+		state.counters.push_back({"ms", state.nsPerOp / 1e6});
+	}
+}
+
+BENCHMARK_CASE("resolver/resolve graph") {
+	resolveGraph(state, false);
+}
+
+BENCHMARK_CASE("resolver/resolve graph with conflicts") {
+	resolveGraph(state, true);
+}
+
+BENCHMARK_CASE("resolver/update still satisfied") {
+	updateGraph(state, false);
+}
+
+BENCHMARK_CASE("resolver/update with a swap") {
+	updateGraph(state, true);
+}
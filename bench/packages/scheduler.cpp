@@ -0,0 +1,75 @@
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <packages/resolver.hpp>
+#include <packages/scheduler.hpp>
+
+using namespace MPackages;
+
+namespace {
+	// [class] Package whose run keeps a thread busy for a while, like initialising a subsystem
+	class WorkPackage: public MBench::CatalogPackage {
+		public:
+			WorkPackage(std::string_view manifest, std::chrono::microseconds work):
+				MBench::CatalogPackage("", manifest), _work(work) {}
+
+			bool run() {
+				auto end = std::chrono::steady_clock::now() + this->_work;
+				while (std::chrono::steady_clock::now() < end) {}
+				return true;
+			}
+		private:
+			std::chrono::microseconds _work;
+	};
+
+	// [void] Run the packages chosen for a synthetic graph of --size packages, each busy for microseconds,
+	// on the given number of threads (0 uses one per hardware thread)
+	void runGraph(MBench::State &state, std::size_t threads, long microseconds) {
+		Registry registry;
+		for (auto const &m: MBench::dependencyGraph(state.size, 5, false))
+			registry.add(std::unique_ptr<Package>(new WorkPackage(m, std::chrono::microseconds(microseconds))));
+
+		std::map<std::string, MUtilities::Range> requirements;
+		for (std::size_t i = 0; i < 10 && i < state.size; i++)
+			requirements.emplace("res:pkg-" + std::to_string(i), MUtilities::Range::all());
+		std::vector<Registry::id> packages = Resolver(registry).resolve(requirements).packages;
+
+		Scheduler scheduler(registry, threads);
+		Scheduler::result last;
+		state.measure([&] {
+			last = scheduler.run(packages);
+			MBench::doNotOptimize(last);
+		});
+
+		double wall = std::chrono::duration<double, std::milli>(last.wall).count();
+		double work = std::chrono::duration<double, std::milli>(last.work).count();
+		double critical = std::chrono::duration<double, std::milli>(last.criticalLength).count();
+		state.counters.push_back({"packages", static_cast<double>(packages.size())});
+		state.counters.push_back({"workers", static_cast<double>(last.workers)});
+		state.counters.push_back({"critical path length", static_cast<double>(last.criticalPath.size())});
+		state.counters.push_back({"critical path ms", critical});
+		state.counters.push_back({"work ms", work});
+		state.counters.push_back({"wall ms", wall});
+		state.counters.push_back({"parallelism", (wall > 0) ? work / wall : 0.0}); // Achieved
+		state.counters.push_back({"max parallelism", (critical > 0) ? work / critical : 0.0}); // With unlimited workers
+		state.counters.push_back({"steals", static_cast<double>(last.steals)});
+		state.counters.push_back({"overhead ns/package", (state.nsPerOp - (work / last.workers) * 1e6) /
+			static_cast<double>(packages.size())});
+	}
+}
+
+BENCHMARK_CASE("scheduler/run graph of empty packages") {
+	runGraph(state, 0, 0);
+}
+
+BENCHMARK_CASE("scheduler/run graph, 50us per package, one thread") {
+	runGraph(state, 1, 50);
+}
+
+BENCHMARK_CASE("scheduler/run graph, 50us per package") {
+	runGraph(state, 0, 50);
+}
@@ -0,0 +1,74 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <packages/watcher.hpp>
+
+using namespace MPackages;
+
+namespace fs = std::filesystem;
+
+namespace {
+	// [Loader] Single threaded loader of the catalog
+	Loader makeLoader(std::size_t size) {
+		Loader loader([](std::string path, const Manifest &manifest) {
+			return std::unique_ptr<Package>(new MBench::CatalogPackage(std::move(path), manifest));
+		}, 1);
+		loader.addRoot(MBench::writeTree("watcher", MBench::catalogManifests(size)).string());
+		return loader;
+	}
+}
+
+BENCHMARK_CASE("watcher/start watching the catalog") {
+	Loader loader = makeLoader(state.size);
+	Registry registry(loader.load().packages);
+	std::size_t watches = 0;
+
+	state.measure([&] {
+		Watcher watcher(registry, loader, std::chrono::milliseconds(0), 1);
+		watches = watcher.watches();
+	});
+
+	state.counters.push_back({"watches", static_cast<double>(watches)});
+	state.counters.push_back({"ms", state.nsPerOp / 1e6});
+}
+
+BENCHMARK_CASE("watcher/reload one changed manifest") {
+	Loader loader = makeLoader(state.size);
+	Registry registry(loader.load().packages);
+	Watcher watcher(registry, loader, std::chrono::milliseconds(0), 1);
+
+	// Rewriting the first package's manifest unchanged still reloads it
+	std::string manifest = (fs::path(registry.get(0).path()) / Loader::manifestName).string();
+	std::string text = MBench::catalogManifests(1)[0];
+	std::size_t changed = 0;
+
+	state.measure([&] {
+		std::ofstream(manifest) << text;
+		std::vector<std::string> paths;
+		while (paths.empty())
+			paths = watcher.poll();
+		changed += watcher.reload(paths).changed.size();
+	});
+
+	MBench::doNotOptimize(changed);
+	state.counters.push_back({"us", state.nsPerOp / 1e3});
+}
+
+// Baseline for the watcher: restarting to load every manifest again
+BENCHMARK_CASE("watcher/reload by loading the catalog again") {
+	Loader loader = makeLoader(state.size);
+	std::size_t packages = 0;
+
+	state.measure([&] {
+		Registry registry(loader.load().packages);
+		packages = registry.size();
+	});
+
+	state.counters.push_back({"packages", static_cast<double>(packages)});
+	state.counters.push_back({"ms", state.nsPerOp / 1e6});
+}
@@ -0,0 +1,117 @@
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <resources/loader.hpp>
+
+using namespace MResources;
+
+namespace fs = std::filesystem;
+
+namespace {
+	const std::size_t fileSize = 16384;
+
+	// [string] Path of a numbered file
+	std::string texture(std::size_t i) {
+		return "textures/" + std::to_string(i) + ".png";
+	}
+
+	// [string] Directory of --size files of 16 KB below a temporary root
+	std::string writeFiles(std::size_t size) {
+		return MBench::writeTree("resources", size, [](std::size_t i) {
+			return std::make_pair(texture(i), std::string(fileSize, static_cast<char>('a' + i % 26)));
+		}).string();
+	}
+}
+
+BENCHMARK_CASE("resources/load files through the loader") {
+	MPackages::Overlay overlay;
+	overlay.mount("base", writeFiles(state.size));
+	Loader loader(overlay);
+	std::size_t bytes = 0;
+
+	state.measure([&] {
+		for (std::size_t i = 0; i < state.size; i++)
+			loader.request(texture(i), Loader::Priority::soon, [&bytes](const Loader::resource &res) {
+				bytes += res.data.size();
+			});
+		loader.wait();
+		loader.deliver(std::chrono::seconds(1));
+	});
+
+	MBench::doNotOptimize(bytes);
+	state.counters.push_back({"ns/file", state.nsPerOp / state.size});
+}
+
+// Baseline for the loader: blocking reads on the calling thread
+BENCHMARK_CASE("resources/load files on the calling thread") {
+	MPackages::Overlay overlay;
+	overlay.mount("base", writeFiles(state.size));
+	std::string buffer;
+	std::size_t bytes = 0;
+
+	state.measure([&] {
+		for (std::size_t i = 0; i < state.size; i++)
+			bytes += overlay.read(texture(i), buffer).size();
+	});
+
+	MBench::doNotOptimize(bytes);
+	state.counters.push_back({"ns/file", state.nsPerOp / state.size});
+}
+
+BENCHMARK_CASE("resources/coalesce requests for one file") {
+	MPackages::Overlay overlay;
+	overlay.mount("base", writeFiles(state.size));
+	Loader loader(overlay);
+	std::size_t delivered = 0;
+
+	state.measure([&] {
+		for (std::size_t i = 0; i < state.size; i++)
+			loader.request(texture(0), Loader::Priority::soon, [&delivered](const Loader::resource &) {
+				delivered++;
+			});
+		loader.wait();
+		loader.deliver(std::chrono::seconds(1));
+	});
+
+	MBench::doNotOptimize(delivered);
+	state.counters.push_back({"ns/request", state.nsPerOp / state.size});
+	state.counters.push_back({"reads/run", static_cast<double>(loader.stats().reads) /
+		(loader.stats().requests / state.size)});
+}
+
+// Time until an urgent file is delivered while --size prefetches are queued
+BENCHMARK_CASE("resources/urgent request behind prefetches") {
+	MPackages::Overlay overlay;
+	overlay.mount("base", writeFiles(state.size));
+	Loader loader(overlay);
+	std::chrono::nanoseconds latency(0);
+	std::size_t runs = 0;
+
+	state.measure([&] {
+		for (std::size_t i = 1; i < state.size; i++)
+			loader.request(texture(i), Loader::Priority::background, [](const Loader::resource &) {});
+		bool loaded = false;
+		auto start = std::chrono::steady_clock::now();
+		loader.request(texture(0), Loader::Priority::now, [&loaded](const Loader::resource &) {
+			loaded = true;
+		});
+		while (!loaded) {
+			loader.deliver(std::chrono::nanoseconds(0));
+			std::this_thread::sleep_for(std::chrono::microseconds(100)); // Rest of a frame
+		}
+		latency += std::chrono::steady_clock::now() - start;
+		runs++;
+
+		// Leave the prefetches out of the next run
+		loader.wait();
+		loader.deliver(std::chrono::seconds(1));
+	});
+
+	state.counters.push_back({"us to urgent file", latency.count() / 1e3 / runs});
+	state.counters.push_back({"us to every file", state.nsPerOp / 1e3});
+}
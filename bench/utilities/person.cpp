@@ -0,0 +1,54 @@
+#include <string>
+#include <vector>
+#include <json/json.h>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <utilities/person.hpp>
+#include <utilities/utility.hpp>
+
+using namespace MUtilities;
+
+BENCHMARK_CASE("person/parse string") {
+	auto people = MBench::personStrings(1024);
+	std::size_t i = 0;
+	state.measure([&] {
+		Person p(people[i++ & 1023]);
+		MBench::doNotOptimize(p);
+	});
+}
+
+BENCHMARK_CASE("person/parse json") {
+	Json::Value obj = Utility::stojson(R"({"name": "Jane Doe", "email": "j@doe.com", "url": "https://doe.com"})");
+	state.measure([&] {
+		Person p(obj);
+		MBench::doNotOptimize(p);
+	});
+}
+
+BENCHMARK_CASE("person/compare with string") {
+	Person p(std::string("John Doe <j@doe.com> (https://doe.com)"));
+	std::string other = "John Doe <j@doe.com>";
+	state.measure([&] {
+		bool r = (p == other);
+		MBench::doNotOptimize(r);
+	});
+}
+
+BENCHMARK_CASE("person/compare objects") {
+	Person a(std::string("John Doe <j@doe.com> (https://doe.com)"));
+	Person b(Utility::stojson(R"({"name": "John Doe", "email": "j@doe.com", "url": "https://doe.com"})"));
+	state.measure([&] {
+		bool r = (a == b);
+		MBench::doNotOptimize(r);
+	});
+}
+
+BENCHMARK_CASE("person/intern string") {
+	auto people = MBench::personStrings(1024);
+	std::size_t i = 0;
+	state.measure([&] {
+		auto p = Person::intern(people[i++ & 1023]);
+		MBench::doNotOptimize(p);
+	});
+}
@@ -0,0 +1,116 @@
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <utilities/range.hpp>
+#include <utilities/version.hpp>
+
+using namespace MUtilities;
+
+namespace {
+	// [string] Build a range of `sets` disjoint comparator sets joined by logical ORs
+	std::string wideRange(int sets) {
+		std::string range = "";
+		for (int i = 0; i < sets; i++) {
+			if (i > 0)
+				range += " || ";
+			range += ">=" + std::to_string(i * 2) + ".0.0 <" + std::to_string(i * 2 + 1) + ".0.0";
+		}
+		return range;
+	}
+
+	// Comparator parsing prior to the lexer, kept as a comparison baseline
+	Version legacyComparator(const std::string &comp) {
+		std::regex rgx(R"(^\s*(>|<|<=|>=|=|)([\w\.\-\+]+)\s*$)");
+		std::smatch match;
+
+		if (!std::regex_search(comp, match, rgx))
+			throw "invalidComparatorString";
+		return Version(match[2].str());
+	}
+
+	std::vector<Version> candidates(std::size_t count) {
+		std::mt19937 rng(7);
+		std::vector<Version> out;
+		for (std::size_t i = 0; i < count; i++)
+			out.push_back(Version(std::to_string(rng() % 40) + "." + std::to_string(rng() % 10) + ".0"));
+		return out;
+	}
+}
+
+BENCHMARK_CASE("range/satisfiedBy 1 set") {
+	Range range(">=1.2.0 <2.0.0");
+	auto vs = candidates(1024);
+	std::size_t i = 0;
+	state.measure([&] {
+		bool r = range.satisfiedBy(vs[i++ & 1023]);
+		MBench::doNotOptimize(r);
+	});
+}
+
+BENCHMARK_CASE("range/satisfiedBy 20 sets") {
+	Range range(wideRange(20));
+	auto vs = candidates(1024);
+	std::size_t i = 0;
+	state.measure([&] {
+		bool r = range.satisfiedBy(vs[i++ & 1023]);
+		MBench::doNotOptimize(r);
+	});
+}
+
+BENCHMARK_CASE("range/intersect 20 x 20 sets") {
+	Range a(wideRange(20));
+	Range b(">=3.0.0 <20.0.0 || >=25.0.0");
+	state.measure([&] {
+		Range r = a.intersect(b);
+		MBench::doNotOptimize(r);
+	});
+}
+
+BENCHMARK_CASE("range/parse/legacy regex >=0.2.0 <1.0.0") {
+	std::string a = ">=0.2.0";
+	std::string b = "<1.0.0";
+	state.measure([&] {
+		Version x = legacyComparator(a);
+		Version y = legacyComparator(b);
+		MBench::doNotOptimize(x);
+		MBench::doNotOptimize(y);
+	});
+}
+
+BENCHMARK_CASE("range/parse/lexer >=0.2.0 <1.0.0") {
+	std::string str = ">=0.2.0 <1.0.0";
+	state.measure([&] {
+		Range r(str);
+		MBench::doNotOptimize(r);
+	});
+}
+
+BENCHMARK_CASE("range/parse/lexer 20 sets") {
+	std::string str = wideRange(20);
+	state.measure([&] {
+		Range r(str);
+		MBench::doNotOptimize(r);
+	});
+}
+
+BENCHMARK_CASE("range/intern hit >=0.2.0 <1.0.0") {
+	std::string str = ">=0.2.0 <1.0.0";
+	Range::intern(str);
+	state.measure([&] {
+		auto r = Range::intern(str);
+		MBench::doNotOptimize(r);
+	});
+}
+
+BENCHMARK_CASE("range/parse catalog ranges") {
+	auto strs = MBench::rangeStrings(1024);
+	std::size_t i = 0;
+	state.measure([&] {
+		Range r(strs[i++ & 1023]);
+		MBench::doNotOptimize(r);
+	});
+}
@@ -0,0 +1,62 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <json/json.h>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <utilities/utility.hpp>
+
+using namespace MUtilities;
+
+BENCHMARK_CASE("utility/stojson manifest") {
+	auto manifests = MBench::catalogManifests(256);
+	std::size_t i = 0;
+	state.measure([&] {
+		Json::Value v = Utility::stojson(manifests[i++ & 255]);
+		MBench::doNotOptimize(v);
+	});
+}
+
+namespace {
+	// [vector of strings] Write 256 catalog manifests into a temporary directory, getting their paths
+	std::vector<std::string> manifestFiles() {
+		std::filesystem::path dir = std::filesystem::temp_directory_path() / "eden-utility-bench";
+		std::filesystem::create_directories(dir);
+
+		std::vector<std::string> paths;
+		auto manifests = MBench::catalogManifests(256);
+		for (std::size_t i = 0; i < manifests.size(); i++) {
+			paths.push_back((dir / (std::to_string(i) + ".json")).string());
+			std::ofstream(paths.back()) << manifests[i];
+		}
+		return paths;
+	}
+}
+
+// Baseline for ftojson: reading each file into a string first
+BENCHMARK_CASE("utility/read and stojson manifest file") {
+	auto paths = manifestFiles();
+	std::size_t i = 0;
+	state.measure([&] {
+		std::ifstream file(paths[i++ & 255]);
+		std::stringstream text;
+		text << file.rdbuf();
+		Json::Value v = Utility::stojson(text.str());
+		MBench::doNotOptimize(v);
+	});
+}
+
+BENCHMARK_CASE("utility/ftojson manifest file") {
+	auto paths = manifestFiles();
+	std::size_t i = 0;
+	Json::Value v;
+	std::string errors;
+	state.measure([&] {
+		bool parsed = Utility::ftojson(paths[i++ & 255], v, errors);
+		MBench::doNotOptimize(parsed);
+		MBench::doNotOptimize(v);
+	});
+}
@@ -0,0 +1,63 @@
+#include <string>
+#include <vector>
+
+#include <catalog.hpp>
+#include <harness.hpp>
+#include <utilities/validate.hpp>
+
+using namespace MUtilities;
+
+namespace {
+	const std::vector<std::string> emails = {"j@doe.com", "bugs@example.com", "first.last@sub.example.org",
+		"not-an-email", "j@@doe.com"};
+	const std::vector<std::string> urls = {"https://example.com/packages/pkg-1", "http://hello.world.doe.com",
+		"https://example.com/git/pkg-12.git", "doe.com", "ftp://user@host:21/path?query#fragment"};
+	const std::vector<std::string> names = {"pkg-1", "package-2_more.io", "_invalid", "NaMe", "a"};
+	const std::vector<std::string> dependNames = {"collection:pkg-1", "ssm:pkg-200", "res:textures.hd",
+		"invalid:pkg", "csm:_pkg"};
+}
+
+BENCHMARK_CASE("validate/email") {
+	std::size_t i = 0;
+	state.measure([&] {
+		bool r = Validate::email(emails[i++ % emails.size()]);
+		MBench::doNotOptimize(r);
+	});
+}
+
+BENCHMARK_CASE("validate/url") {
+	std::size_t i = 0;
+	state.measure([&] {
+		bool r = Validate::url(urls[i++ % urls.size()]);
+		MBench::doNotOptimize(r);
+	});
+}
+
+BENCHMARK_CASE("validate/packageName") {
+	std::size_t i = 0;
+	state.measure([&] {
+		bool r = Validate::packageName(names[i++ % names.size()]);
+		MBench::doNotOptimize(r);
+	});
+}
+
+BENCHMARK_CASE("validate/dependName") {
+	std::size_t i = 0;
+	state.measure([&] {
+		bool r = Validate::dependName(dependNames[i++ % dependNames.size()]);
+		MBench::doNotOptimize(r);
+	});
+}
+
+BENCHMARK_CASE("validate/many packageName") {
+	std::vector<std::string> catalog;
+	for (std::size_t i = 0; i < state.size; i++)
+		catalog.push_back(names[i % names.size()]);
+
+	state.measure([&] {
+		std::vector<bool> r = Validate::validateMany(Validate::packageName, catalog);
+		MBench::doNotOptimize(r);
+	});
+
+	state.counters.push_back({"ns per name", state.nsPerOp / state.size});
+}
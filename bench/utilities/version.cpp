@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <harness.hpp>
+#include <utilities/version.hpp>
+
+using namespace MUtilities;
+
+namespace {
+	// Field layout and operators of Version prior to the packed key, kept as a comparison baseline
+	struct LegacyVersion {
+		unsigned int major;
+		unsigned int minor;
+		unsigned int patch;
+		std::string type;
+		int version;
+		int typeWeight;
+
+		bool preEqual(const LegacyVersion &b) const {
+			return (this->type == b.type) && (this->version == b.version);
+		}
+		bool preLess(const LegacyVersion &b) const {
+			if (this->type.empty() && this->version == -1 && b.type.empty() && b.version == -1)
+				return false;
+			if (b.type.empty() && b.version == -1)
+				return true;
+			if (this->typeWeight < b.typeWeight)
+				return true;
+			if (this->typeWeight == b.typeWeight) {
+				if ((this->version == -1 && b.version > 0) || this->version < b.version)
+					return true;
+			}
+			return false;
+		}
+
+		bool operator == (const LegacyVersion &b) const {
+			return (this->major == b.major) && (this->minor == b.minor) && (this->patch == b.patch) && this->preEqual(b);
+		}
+		bool operator != (const LegacyVersion &b) const {
+			return !(*this == b);
+		}
+		bool operator < (const LegacyVersion &b) const {
+			if (this->major < b.major)
+				return true;
+			else if (this->major == b.major && this->minor < b.minor)
+				return true;
+			else if (this->major == b.major && this->minor == b.minor && this->patch < b.patch)
+				return true;
+			else if (this->major == b.major && this->minor == b.minor && this->patch == b.patch && this->preLess(b))
+				return true;
+			return false;
+		}
+		bool operator > (const LegacyVersion &b) const {
+			return !(*this < b) && *this != b;
+		}
+		bool operator <= (const LegacyVersion &b) const {
+			return *this < b || *this == b;
+		}
+		bool operator >= (const LegacyVersion &b) const {
+			return !(*this <= b) || *this == b;
+		}
+	};
+
+	const char *types[] = {"alpha", "beta", "rc"};
+
+	// [vector of strings] Generate a deterministic list of version strings
+	std::vector<std::string> versionStrings(std::size_t count, bool prereleases, bool sameRelease = false) {
+		std::mt19937 rng(42);
+		std::vector<std::string> out;
+		for (std::size_t i = 0; i < count; i++) {
+			std::string v = std::to_string(rng() % 4) + "." + std::to_string(rng() % 12) + "." + std::to_string(rng() % 30);
+			if (sameRelease)
+				v = "1.4.2";
+			if (prereleases && (sameRelease || rng() % 4 == 0)) {
+				v += std::string("-") + types[rng() % 3];
+				if (rng() % 2)
+					v += "." + std::to_string(1 + rng() % 9);
+			}
+			out.push_back(v);
+		}
+		return out;
+	}
+
+	std::vector<Version> versions(std::size_t count, bool prereleases = true, bool sameRelease = false) {
+		std::vector<Version> out;
+		for (auto const &s: versionStrings(count, prereleases, sameRelease))
+			out.push_back(Version(s));
+		return out;
+	}
+
+	std::vector<LegacyVersion> legacyVersions(std::size_t count, bool prereleases = true, bool sameRelease = false) {
+		std::vector<LegacyVersion> out;
+		for (auto &v: versions(count, prereleases, sameRelease)) {
+			auto pre = v.prerelease();
+			int weight = pre.first.empty() ? -1 : (pre.first == "alpha" ? 0 : (pre.first == "beta" ? 1 : 2));
+			out.push_back({v.major(), v.minor(), v.patch(), std::string(pre.first), pre.second, weight});
+		}
+		return out;
+	}
+}
+
+BENCHMARK_CASE("version/compare/legacy >=") {
+	auto vs = legacyVersions(1024);
+	std::size_t i = 0;
+	state.measure([&] {
+		bool r = vs[i & 1023] >= vs[(i + 7) & 1023];
+		MBench::doNotOptimize(r);
+		i++;
+	});
+}
+
+BENCHMARK_CASE("version/compare/packed >=") {
+	auto vs = versions(1024);
+	std::size_t i = 0;
+	state.measure([&] {
+		bool r = vs[i & 1023] >= vs[(i + 7) & 1023];
+		MBench::doNotOptimize(r);
+		i++;
+	});
+}
+
+// Prereleases of one release: the legacy operators fall through to string comparisons
+BENCHMARK_CASE("version/compare/legacy >= prerelease") {
+	auto vs = legacyVersions(1024, true, true);
+	std::size_t i = 0;
+	state.measure([&] {
+		bool r = vs[i & 1023] >= vs[(i + 7) & 1023];
+		MBench::doNotOptimize(r);
+		i++;
+	});
+}
+
+BENCHMARK_CASE("version/compare/packed >= prerelease") {
+	auto vs = versions(1024, true, true);
+	std::size_t i = 0;
+	state.measure([&] {
+		bool r = vs[i & 1023] >= vs[(i + 7) & 1023];
+		MBench::doNotOptimize(r);
+		i++;
+	});
+}
+
+// Sorting uses releases only: the legacy prerelease ordering is not a strict weak ordering
+BENCHMARK_CASE("version/sort/legacy 10k") {
+	auto vs = legacyVersions(10000, false);
+	state.measure([&] {
+		auto copy = vs;
+		std::sort(copy.begin(), copy.end());
+		MBench::doNotOptimize(copy);
+	});
+}
+
+BENCHMARK_CASE("version/sort/packed 10k") {
+	auto vs = versions(10000, false);
+	state.measure([&] {
+		auto copy = vs;
+		std::sort(copy.begin(), copy.end());
+		MBench::doNotOptimize(copy);
+	});
+}
+
+BENCHMARK_CASE("version/parse X.Y.Z") {
+	auto strs = versionStrings(1024, false);
+	Version v;
+	std::size_t i = 0;
+	state.measure([&] {
+		auto error = Version::parse(strs[i & 1023], v);
+		MBench::doNotOptimize(error);
+		i++;
+	});
+}
+
+BENCHMARK_CASE("version/parse with prerelease and meta") {
+	std::string str = "12.4.19-beta.3+build-2018.10";
+	Version v;
+	state.measure([&] {
+		auto error = Version::parse(str, v);
+		MBench::doNotOptimize(error);
+	});
+}
+
+BENCHMARK_CASE("version/parse malformed (error code)") {
+	std::string str = "1.2.x";
+	Version v;
+	state.measure([&] {
+		auto error = Version::parse(str, v);
+		MBench::doNotOptimize(error);
+	});
+}
+
+BENCHMARK_CASE("version/construct malformed (exception)") {
+	std::string str = "1.2.x";
+	state.measure([&] {
+		try {
+			Version v(str);
+			MBench::doNotOptimize(v);
+		} catch (const char *e) {
+			MBench::doNotOptimize(e);
+		}
+	});
+}
@@ -0,0 +1,61 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <harness.hpp>
+#include <utilities/range.hpp>
+#include <utilities/version.hpp>
+#include <utilities/versionindex.hpp>
+
+using namespace MUtilities;
+
+namespace {
+	// [vector of versions] All versions of a package with a long release history
+	std::vector<Version> history(int majors, int minors, int patches) {
+		std::vector<Version> out;
+		for (int a = 0; a < majors; a++)
+			for (int b = 0; b < minors; b++)
+				for (int c = 0; c < patches; c++)
+					out.push_back(Version(std::to_string(a) + "." + std::to_string(b) + "." + std::to_string(c)));
+		return out;
+	}
+
+	std::vector<Range> queries(std::size_t count, int majors) {
+		std::mt19937 rng(3);
+		std::vector<Range> out;
+		for (std::size_t i = 0; i < count; i++) {
+			int m = rng() % majors;
+			out.push_back(Range(">=" + std::to_string(m) + ".2.0 <" + std::to_string(m + 1) + ".0.0"));
+		}
+		return out;
+	}
+}
+
+BENCHMARK_CASE("versionindex/maxSatisfiedBy linear 1000 versions") {
+	auto versions = history(10, 10, 10);
+	auto ranges = queries(256, 10);
+	std::size_t i = 0;
+	state.measure([&] {
+		Version v = ranges[i++ & 255].maxSatisfiedBy(versions);
+		MBench::doNotOptimize(v);
+	});
+}
+
+BENCHMARK_CASE("versionindex/maxSatisfying 1000 versions") {
+	VersionIndex index(history(10, 10, 10));
+	auto ranges = queries(256, 10);
+	std::size_t i = 0;
+	state.measure([&] {
+		const Version *v = index.maxSatisfying(ranges[i++ & 255]);
+		MBench::doNotOptimize(v);
+	});
+}
+
+BENCHMARK_CASE("versionindex/maxSatisfying batch of 256") {
+	VersionIndex index(history(10, 10, 10));
+	auto ranges = queries(256, 10);
+	state.measure([&] {
+		auto v = index.maxSatisfying(ranges);
+		MBench::doNotOptimize(v);
+	});
+}
@@ -40,6 +40,11 @@ Client *Client::getInstance() {
 	return &instance;
 }
 
+// [void] Set the resource loader whose finished reads the main loop delivers
+void Client::setResources(MResources::Loader *loader) {
+	this->resources = loader;
+}
+
 // [void] Main event loop
 void Client::main() {
 	SDL_Event event;
@@ -56,6 +61,10 @@ void Client::main() {
 			}
 		}
 
+		// Run resource callbacks, leaving most of a 60 Hz frame to the rest of the loop
+		if (this->resources)
+			this->resources->deliver(std::chrono::milliseconds(2));
+
 		// Update window
 		SDL_GL_SwapWindow(this->window->getWindow());
 	}
@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include "window.hpp"
+#include "../resources/loader.hpp"
 
 namespace MClient {
 
@@ -12,10 +13,12 @@ class Client {
 		static Client *getInstance();
 
 		void main();
+		void setResources(MResources::Loader *loader); // Delivered to once per frame
 	private:
 		Client();
 
 		Window *window;
+		MResources::Loader *resources = nullptr;
 };
 
 }
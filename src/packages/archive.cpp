@@ -0,0 +1,210 @@
+#include "archive.hpp"
+
+using namespace MPackages;
+
+namespace fs = std::filesystem;
+
+namespace {
+	const char magic[8] = {'E', 'D', 'N', 'P', 'A', 'C', 'K', 'G'};
+	const std::size_t headerSize = 32;
+	const std::size_t entrySize = 32;
+
+	// A file to be packed
+	class packed {
+		public:
+			fs::path source;
+			std::string path; // Relative, with / separators
+			std::uint64_t hash;
+			std::uint64_t size;
+			std::uint64_t offset = 0; // Of the contents in the archive
+	};
+
+	using MUtilities::Binary::put;
+	using MUtilities::Binary::get;
+	using MUtilities::Binary::align;
+
+	// [void] Append the contents of a file to out, which must come to exactly size bytes
+	void copy(const fs::path &source, std::uint64_t size, std::ofstream &out) {
+		std::ifstream in(source, std::ios::binary);
+		char buffer[65536];
+		std::uint64_t copied = 0;
+
+		while (in) {
+			in.read(buffer, sizeof(buffer));
+			std::streamsize n = in.gcount();
+			if (n <= 0)
+				break;
+			if (!out.write(buffer, n))
+				throw "MPackages::Archive::writeFailed";
+			copied += static_cast<std::uint64_t>(n);
+		}
+
+		// A file that changed while packing would leave the table wrong
+		if (!in.eof() || copied != size)
+			throw "MPackages::Archive::readFailed";
+	}
+}
+
+/* Package Archive Class */
+
+const std::uint32_t Archive::formatVersion = 1;
+const std::size_t Archive::alignment = 64;
+const char *Archive::extension = ".epk";
+
+// [constructor] Map an archive
+Archive::Archive(const std::string &path) {
+	try {
+		this->_file.reset(new MUtilities::MappedFile(path, false));
+	} catch (const char *) {
+		throw "MPackages::Archive::openFailed";
+	}
+
+	std::string_view bytes = this->_file->view();
+	if (bytes.size() < headerSize || std::memcmp(bytes.data(), magic, sizeof(magic)) != 0 ||
+			get<std::uint32_t>(bytes, 8) != Archive::formatVersion || get<std::uint64_t>(bytes, 16) != bytes.size())
+		throw "MPackages::Archive::invalidFile";
+
+	std::uint32_t count = get<std::uint32_t>(bytes, 12);
+	std::uint32_t alignment = get<std::uint32_t>(bytes, 24);
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0 || (bytes.size() - headerSize) / entrySize < count)
+		throw "MPackages::Archive::invalidFile";
+
+	// Every offset is checked once here, so lookups can trust the table
+	this->_entries.resize(count);
+	for (std::uint32_t i = 0; i < count; i++) {
+		std::size_t position = headerSize + i * entrySize;
+		std::uint64_t offset = get<std::uint64_t>(bytes, position + 8);
+		std::uint64_t size = get<std::uint64_t>(bytes, position + 16);
+		std::uint32_t pathOffset = get<std::uint32_t>(bytes, position + 24);
+		std::uint32_t pathLength = get<std::uint32_t>(bytes, position + 28);
+
+		if (offset > bytes.size() || bytes.size() - offset < size || offset % alignment != 0 ||
+				pathOffset > bytes.size() || bytes.size() - pathOffset < pathLength)
+			throw "MPackages::Archive::invalidFile";
+
+		entry &e = this->_entries[i];
+		e.hash = get<std::uint64_t>(bytes, position);
+		e.path = bytes.substr(pathOffset, pathLength);
+		e.data = bytes.substr(offset, size);
+
+		if (i > 0) {
+			const entry &previous = this->_entries[i - 1];
+			if (previous.hash > e.hash || (previous.hash == e.hash && previous.path >= e.path))
+				throw "MPackages::Archive::invalidFile";
+		}
+	}
+}
+
+// [vector of entries] Get the archived files, sorted by hash of their path
+const std::vector<Archive::entry> &Archive::entries() const {
+	return this->_entries;
+}
+// [size_t] Get number of archived files
+std::size_t Archive::size() const {
+	return this->_entries.size();
+}
+
+// [pointer to entry] Find an archived file by its path relative to the package directory
+const Archive::entry *Archive::find(std::string_view path) const {
+	std::uint64_t hash = MUtilities::Utility::fnv1a(path);
+	auto it = std::lower_bound(this->_entries.begin(), this->_entries.end(), hash,
+		[](const entry &e, std::uint64_t h) { return e.hash < h; });
+
+	for (; it != this->_entries.end() && it->hash == hash; ++it)
+		if (it->path == path)
+			return &*it;
+	return nullptr;
+}
+
+// [string_view] Get the contents of an archived file, valid for the lifetime of the archive
+std::string_view Archive::read(std::string_view path) const {
+	const entry *e = this->find(path);
+	if (!e)
+		throw "MPackages::Archive::missingFile";
+	return e->data;
+}
+
+// [size_t] Pack the regular files below a directory into an archive at path, replacing any existing file
+// only once it is complete. Symbolic links are not followed.
+std::size_t Archive::pack(const std::string &directory, const std::string &path) {
+	std::error_code ec;
+	if (!fs::is_directory(directory, ec))
+		throw "MPackages::Archive::invalidDirectory";
+
+	// The archive itself is skipped if it is written into the directory
+	std::vector<packed> files;
+	fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, ec), end;
+	for (; !ec && it != end; it.increment(ec)) {
+		std::error_code same;
+		if (it->is_symlink(ec) || !it->is_regular_file(ec) || fs::equivalent(it->path(), path, same))
+			continue;
+
+		packed f;
+		f.source = it->path();
+		f.path = it->path().lexically_relative(directory).generic_string();
+		f.hash = MUtilities::Utility::fnv1a(f.path);
+		f.size = it->file_size(ec);
+		if (ec)
+			throw "MPackages::Archive::readFailed";
+		files.push_back(std::move(f));
+	}
+	if (ec)
+		throw "MPackages::Archive::readFailed";
+
+	std::sort(files.begin(), files.end(), [](const packed &a, const packed &b) {
+		return (a.hash != b.hash) ? (a.hash < b.hash) : (a.path < b.path);
+	});
+
+	// Header, table and paths are built in memory; the contents are copied file by file
+	std::string paths;
+	std::size_t base = headerSize + files.size() * entrySize;
+	for (auto const &f: files)
+		paths.append(f.path);
+
+	std::uint64_t offset = base + paths.size();
+	for (auto &f: files) {
+		f.offset = align(offset, Archive::alignment);
+		offset = f.offset + f.size;
+	}
+
+	std::string head(magic, sizeof(magic));
+	put<std::uint32_t>(head, Archive::formatVersion);
+	put<std::uint32_t>(head, static_cast<std::uint32_t>(files.size()));
+	put<std::uint64_t>(head, offset); // File size
+	put<std::uint32_t>(head, static_cast<std::uint32_t>(Archive::alignment));
+	put<std::uint32_t>(head, 0);
+
+	std::size_t pathOffset = base;
+	for (auto const &f: files) {
+		put<std::uint64_t>(head, f.hash);
+		put<std::uint64_t>(head, f.offset);
+		put<std::uint64_t>(head, f.size);
+		put<std::uint32_t>(head, static_cast<std::uint32_t>(pathOffset));
+		put<std::uint32_t>(head, static_cast<std::uint32_t>(f.path.size()));
+		pathOffset += f.path.size();
+	}
+	head.append(paths);
+
+	// The temporary file is removed if copying throws
+	MUtilities::AtomicFile out(path);
+	if (!out.write(head))
+		throw "MPackages::Archive::writeFailed";
+
+	// An empty last file still ends at its aligned offset
+	std::uint64_t written = head.size();
+	for (std::size_t i = 0; i <= files.size(); i++) {
+		std::string padding(((i < files.size()) ? files[i].offset : offset) - written, '\0');
+		if (!out.write(padding))
+			throw "MPackages::Archive::writeFailed";
+
+		if (i < files.size()) {
+			copy(files[i].source, files[i].size, out.stream());
+			written = files[i].offset + files[i].size;
+		}
+	}
+
+	if (!out.commit())
+		throw "MPackages::Archive::writeFailed";
+
+	return files.size();
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+
+#include "../utilities/mappedfile.hpp"
+#include "../utilities/atomicfile.hpp"
+#include "../utilities/binary.hpp"
+#include "../utilities/utility.hpp"
+
+namespace MPackages {
+
+/* Package Archive Class */
+
+// A package directory packed into a single file, so that its files can be read from one memory mapping
+// without opening each of them. Paths are relative to the package directory, with / separators. Layout,
+// in native byte order:
+//   header   "EDNPACKG", u32 format version, u32 entry count, u64 file size, u32 payload alignment, u32 0
+//   entries  u64 FNV-1a hash of the path, u64 offset and u64 size of the contents, u32 offset and u32
+//            length of the path; sorted by hash, then path
+//   paths
+//   contents each starting at a multiple of the payload alignment
+// Lookups hash the path and search the sorted table. The archive is mapped lazily, so only the pages of
+// files that are read are loaded from disk.
+class Archive {
+	public:
+		/* Archived File Class */
+		class entry {
+			public:
+				// Views into the mapping
+				std::string_view path;
+				std::string_view data;
+				std::uint64_t hash; // Of the path
+		};
+
+		static const std::uint32_t formatVersion;
+		static const std::size_t alignment; // Of file contents, in bytes
+		static const char *extension; // File name extension of archives
+
+		Archive(const std::string &path);
+
+		Archive(Archive &&) = default;
+		Archive &operator = (Archive &&) = default;
+
+		const std::vector<entry> &entries() const; // In table order
+		std::size_t size() const;
+
+		const entry *find(std::string_view path) const; // nullptr if the file is not archived
+		std::string_view read(std::string_view path) const;
+
+		static std::size_t pack(const std::string &directory, const std::string &path); // Number of files packed
+	private:
+		std::unique_ptr<MUtilities::MappedFile> _file;
+		std::vector<entry> _entries;
+};
+
+}
@@ -0,0 +1,292 @@
+#include "cache.hpp"
+
+using namespace MPackages;
+
+namespace {
+	const char magic[8] = {'E', 'D', 'N', 'M', 'C', 'A', 'C', 'H'};
+	const std::size_t headerSize = 32;
+	const std::size_t indexEntrySize = 40;
+
+	using MUtilities::Binary::put;
+	using MUtilities::Binary::get;
+
+	// [void] Append a length-prefixed string
+	void putString(std::string &out, std::string_view str) {
+		put<std::uint32_t>(out, static_cast<std::uint32_t>(str.size()));
+		out.append(str);
+	}
+
+	/* Record Reader Class */
+
+	// Bounds-checked cursor over a package record
+	class recordReader {
+		public:
+			recordReader(std::string_view bytes) : _bytes(bytes) {}
+
+			// [T] Read an integer
+			template<typename T> T read() {
+				if (this->_bytes.size() - this->_pos < sizeof(T))
+					throw "MPackages::ManifestCache::corruptRecord";
+
+				T value = get<T>(this->_bytes, this->_pos);
+				this->_pos += sizeof(T);
+				return value;
+			}
+
+			// [string_view] Read a length-prefixed string
+			std::string_view readString() {
+				std::uint32_t length = this->read<std::uint32_t>();
+				if (this->_bytes.size() - this->_pos < length)
+					throw "MPackages::ManifestCache::corruptRecord";
+
+				std::string_view str = this->_bytes.substr(this->_pos, length);
+				this->_pos += length;
+				return str;
+			}
+
+			// [bool] Check if the whole record was read
+			bool done() const {
+				return this->_pos == this->_bytes.size();
+			}
+		private:
+			std::string_view _bytes;
+			std::size_t _pos = 0;
+	};
+
+	// [void] Append a person as its three fields
+	void putPerson(std::string &out, const MUtilities::Person &p) {
+		putString(out, p.name());
+		putString(out, p.email());
+		putString(out, p.url());
+	}
+
+	// [Person] Read a person written by putPerson
+	MUtilities::Person readPerson(recordReader &in) {
+		std::string_view name = in.readString();
+		std::string_view email = in.readString();
+		std::string_view url = in.readString();
+		return MUtilities::Person::validated(name, email, url);
+	}
+
+	// [void] Append a dependency list
+	void putDependencies(std::string &out, const DependencyList &dependencies) {
+		put<std::uint32_t>(out, static_cast<std::uint32_t>(dependencies.size()));
+		for (auto const &d: dependencies) {
+			putString(out, d.first);
+			putString(out, d.second.str());
+		}
+	}
+
+	// [void] Read a dependency list written by putDependencies
+	void readDependencies(recordReader &in, std::vector<Dependency> &out) {
+		std::uint32_t count = in.read<std::uint32_t>();
+		for (std::uint32_t i = 0; i < count; i++) {
+			std::string_view name = in.readString();
+			out.emplace_back(name, *MUtilities::Range::intern(in.readString()));
+		}
+	}
+}
+
+/* Manifest Cache Class */
+
+const std::uint32_t ManifestCache::formatVersion = 1;
+
+// [constructor] Empty cache
+ManifestCache::ManifestCache() {}
+
+// [constructor] Map the cache file at path, if there is a valid one
+ManifestCache::ManifestCache(const std::string &path) {
+	try {
+		this->_file.reset(new MUtilities::MappedFile(path));
+	} catch (const char *) {
+		return;
+	}
+
+	std::string_view bytes = this->_file->view();
+	if (bytes.size() < headerSize || std::memcmp(bytes.data(), magic, sizeof(magic)) != 0 ||
+			get<std::uint32_t>(bytes, 8) != ManifestCache::formatVersion || get<std::uint64_t>(bytes, 24) != bytes.size()) {
+		this->_file.reset();
+		return;
+	}
+
+	std::uint32_t count = get<std::uint32_t>(bytes, 12);
+	std::uint64_t index = get<std::uint64_t>(bytes, 16);
+	if (index < headerSize || index > bytes.size() || (bytes.size() - index) / indexEntrySize < count) {
+		this->_file.reset();
+		return;
+	}
+
+	this->_bytes = bytes;
+	this->_count = count;
+	this->_index = index;
+}
+
+// [optional Manifest] Find the record of a manifest, if it is cached and unchanged
+std::optional<Manifest> ManifestCache::find(std::string_view path, std::uint64_t size, std::int64_t mtime) const {
+	// [string_view] Path of the nth index entry, or nothing if it lies outside the file
+	auto pathAt = [this](std::size_t n) -> std::optional<std::string_view> {
+		std::size_t entry = this->_index + n * indexEntrySize;
+		std::uint64_t offset = get<std::uint64_t>(this->_bytes, entry);
+		std::uint32_t length = get<std::uint32_t>(this->_bytes, entry + 32);
+		if (offset > this->_bytes.size() || this->_bytes.size() - offset < length)
+			return std::nullopt;
+		return this->_bytes.substr(offset, length);
+	};
+
+	// Binary search the index, which is sorted by path
+	std::size_t low = 0, high = this->_count;
+	while (low < high) {
+		std::size_t mid = low + (high - low) / 2;
+		std::optional<std::string_view> p = pathAt(mid);
+		if (!p)
+			return std::nullopt;
+
+		int c = p->compare(path);
+		if (c < 0) {
+			low = mid + 1;
+		} else if (c > 0) {
+			high = mid;
+		} else {
+			std::size_t entry = this->_index + mid * indexEntrySize;
+			std::uint64_t offset = get<std::uint64_t>(this->_bytes, entry + 8);
+			std::uint32_t length = get<std::uint32_t>(this->_bytes, entry + 36);
+
+			if (get<std::uint64_t>(this->_bytes, entry + 16) != size || get<std::int64_t>(this->_bytes, entry + 24) != mtime)
+				return std::nullopt;
+			if (offset > this->_bytes.size() || this->_bytes.size() - offset < length)
+				return std::nullopt;
+
+			return Manifest(this->_bytes.substr(offset, length), Manifest::Format::record);
+		}
+	}
+
+	return std::nullopt;
+}
+
+// [size_t] Get number of cached manifests
+std::size_t ManifestCache::size() const {
+	return this->_count;
+}
+
+// [void] Write a cache of the entries to path, replacing any existing file only once it is complete
+void ManifestCache::write(const std::string &path, const std::vector<entry> &entries) {
+	std::vector<const entry *> sorted;
+	sorted.reserve(entries.size());
+	for (auto const &e: entries)
+		sorted.push_back(&e);
+	std::sort(sorted.begin(), sorted.end(), [](const entry *a, const entry *b) {
+		return a->path < b->path;
+	});
+
+	// Data section: each path followed by its record
+	std::string out(headerSize, '\0');
+	std::string index;
+	index.reserve(sorted.size() * indexEntrySize);
+
+	for (auto const *e: sorted) {
+		std::uint64_t pathOffset = out.size();
+		out.append(e->path);
+		std::uint64_t recordOffset = out.size();
+		out.append(ManifestCache::encode(*e->package));
+
+		put<std::uint64_t>(index, pathOffset);
+		put<std::uint64_t>(index, recordOffset);
+		put<std::uint64_t>(index, e->size);
+		put<std::int64_t>(index, e->mtime);
+		put<std::uint32_t>(index, static_cast<std::uint32_t>(e->path.size()));
+		put<std::uint32_t>(index, static_cast<std::uint32_t>(out.size() - recordOffset));
+	}
+
+	std::uint64_t indexOffset = out.size();
+	out.append(index);
+
+	std::string header(magic, sizeof(magic));
+	put<std::uint32_t>(header, ManifestCache::formatVersion);
+	put<std::uint32_t>(header, static_cast<std::uint32_t>(sorted.size()));
+	put<std::uint64_t>(header, indexOffset);
+	put<std::uint64_t>(header, out.size());
+	out.replace(0, headerSize, header);
+
+	// Readers that still map the old file keep seeing it until they close it
+	if (!MUtilities::AtomicFile::write(path, out))
+		throw "MPackages::ManifestCache::writeFailed";
+}
+
+// [string] Encode the fields of a package as a record
+std::string ManifestCache::encode(const Package &pkg) {
+	std::string out;
+
+	putString(out, pkg._name);
+	putString(out, pkg._version.str());
+	putString(out, pkg._title);
+	putString(out, pkg._description);
+
+	put<std::uint32_t>(out, static_cast<std::uint32_t>(pkg._keywords.size()));
+	for (auto const &k: pkg._keywords)
+		putString(out, k);
+
+	putString(out, pkg._homepage);
+	putString(out, pkg._bugsEmail);
+	putString(out, pkg._bugsUrl);
+	putString(out, pkg._license);
+
+	put<std::uint8_t>(out, pkg._author.has_value());
+	if (pkg._author)
+		putPerson(out, *pkg._author);
+
+	put<std::uint32_t>(out, static_cast<std::uint32_t>(pkg._contributors.size()));
+	for (auto const &c: pkg._contributors)
+		putPerson(out, c);
+
+	putString(out, pkg._repository);
+	putDependencies(out, pkg._dependencies);
+	putDependencies(out, pkg._optionalDependencies);
+	put<std::uint8_t>(out, pkg._private);
+
+	return out;
+}
+
+// [void] Fill the fields of a package from a record written by encode; fields are trusted to be valid already,
+// and view the record
+void ManifestCache::decode(std::string_view record, Package::fields &f) {
+	recordReader in(record);
+
+	try {
+		f.name = in.readString();
+		f.version = *MUtilities::Version::intern(in.readString());
+		f.title = in.readString();
+		f.description = in.readString();
+
+		std::uint32_t keywords = in.read<std::uint32_t>();
+		f.keywords.clear();
+		for (std::uint32_t i = 0; i < keywords; i++)
+			f.keywords.push_back(in.readString());
+
+		f.homepage = in.readString();
+		f.bugsEmail = in.readString();
+		f.bugsUrl = in.readString();
+		f.license = in.readString();
+
+		f.author.reset();
+		if (in.read<std::uint8_t>())
+			f.author.emplace(readPerson(in));
+
+		std::uint32_t contributors = in.read<std::uint32_t>();
+		f.contributors.clear();
+		for (std::uint32_t i = 0; i < contributors; i++)
+			f.contributors.push_back(readPerson(in));
+
+		f.repository = in.readString();
+		f.dependencies.clear();
+		readDependencies(in, f.dependencies);
+		f.optionalDependencies.clear();
+		readDependencies(in, f.optionalDependencies);
+		f.isPrivate = in.read<std::uint8_t>() != 0;
+	} catch (const char *) {
+		// Versions and ranges that no longer parse mean the record was not written by encode
+		throw "MPackages::ManifestCache::corruptRecord";
+	}
+
+	if (!in.done())
+		throw "MPackages::ManifestCache::corruptRecord";
+}
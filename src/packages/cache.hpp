@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+
+#include "package.hpp"
+#include "manifest.hpp"
+#include "../utilities/mappedfile.hpp"
+#include "../utilities/atomicfile.hpp"
+#include "../utilities/binary.hpp"
+
+namespace MPackages {
+
+/* Manifest Cache Class */
+
+// Binary file of already validated packages, keyed by manifest path, size and modification time, and
+// read in place through a memory mapping. Layout, in native byte order:
+//   header   "EDNMCACH", u32 format version, u32 entry count, u64 index offset, u64 file size
+//   data     path strings and package records
+//   index    entries sorted by path: u64 path offset, u64 record offset, u64 manifest size,
+//            i64 manifest mtime, u32 path length, u32 record length
+// A missing, truncated or foreign file is treated as an empty cache.
+class ManifestCache {
+	public:
+		/* Cache Entry Class */
+		class entry {
+			public:
+				std::string path; // Manifest file
+				std::uint64_t size; // Manifest size in bytes
+				std::int64_t mtime; // Manifest modification time, in any fixed unit
+				const Package *package;
+		};
+
+		static const std::uint32_t formatVersion;
+
+		ManifestCache(); // Empty cache
+		ManifestCache(const std::string &path);
+
+		std::optional<Manifest> find(std::string_view path, std::uint64_t size, std::int64_t mtime) const;
+		std::size_t size() const;
+
+		static void write(const std::string &path, const std::vector<entry> &entries);
+		static std::string encode(const Package &pkg);
+		static void decode(std::string_view record, Package::fields &f);
+	private:
+		std::unique_ptr<MUtilities::MappedFile> _file;
+		std::string_view _bytes;
+		std::uint32_t _count = 0;
+		std::uint64_t _index = 0; // Offset of the first index entry
+};
+
+}
@@ -0,0 +1,311 @@
+#include "loader.hpp"
+
+using namespace MPackages;
+
+namespace fs = std::filesystem;
+
+namespace {
+	typedef std::chrono::steady_clock steadyClock;
+
+	// [void] Collect manifests below dir; a directory holding a manifest is a package and is not descended into
+	void scan(const fs::path &dir, std::vector<std::string> &out) {
+		std::error_code ec;
+		fs::path manifest = dir / Loader::manifestName;
+
+		if (fs::is_regular_file(manifest, ec)) {
+			out.push_back(manifest.string());
+			return;
+		}
+
+		for (fs::directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec), end; !ec && it != end;
+				it.increment(ec)) {
+			// Symbolic links are not followed, so link cycles can not trap the scan
+			if (it->is_directory(ec) && !it->is_symlink(ec))
+				scan(it->path(), out);
+		}
+	}
+
+	// [bool] Get size and modification time (in nanoseconds) of a file with a single stat call
+	bool fileStamp(const std::string &path, std::uint64_t &size, std::int64_t &mtime) {
+		struct stat st;
+		if (::stat(path.c_str(), &st) != 0)
+			return false;
+
+		size = static_cast<std::uint64_t>(st.st_size);
+#ifdef __APPLE__
+		mtime = static_cast<std::int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+		mtime = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+		return true;
+	}
+}
+
+/* Package Loader Class */
+
+const char *Loader::manifestName = "package.json";
+
+// [bool] Read a whole manifest file
+bool Loader::readManifest(const std::string &path, std::string &out) {
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+		return false;
+
+	std::streamoff size = file.tellg();
+	if (size < 0)
+		return false;
+
+	out.resize(static_cast<std::size_t>(size));
+	file.seekg(0);
+	return static_cast<bool>(file.read(&out[0], size));
+}
+
+// [constructor] With factory for the concrete package type and number of worker threads
+Loader::Loader(Factory factory, std::size_t threads) : _factory(std::move(factory)), _threads(threads) {}
+
+// [Factory] Get the factory constructing packages
+const Loader::Factory &Loader::factory() const {
+	return this->_factory;
+}
+
+// [void] Add a directory to search for packages
+void Loader::addRoot(std::string path) {
+	this->_roots.push_back(std::move(path));
+}
+// [vector of strings] Get root directories
+const std::vector<std::string> &Loader::roots() const {
+	return this->_roots;
+}
+
+// [void] Set the manifest cache file
+void Loader::setCache(std::string path) {
+	this->_cache = std::move(path);
+}
+// [string] Get the manifest cache file
+const std::string &Loader::cache() const {
+	return this->_cache;
+}
+
+// [result] Scan the roots and load every package found
+Loader::result Loader::load() const {
+	result out;
+	steadyClock::time_point start = steadyClock::now();
+	MUtilities::ThreadPool pool(this->_threads);
+
+	// Scan: the top level of every root is listed here, the directories below it are walked in parallel
+	std::vector<fs::path> dirs;
+	std::vector<std::string> manifests;
+
+	for (auto const &root: this->_roots) {
+		std::error_code ec;
+		if (!fs::is_directory(root, ec)) {
+			out.errors.push_back({root, "MPackages::Loader::invalidRoot"});
+			continue;
+		}
+
+		if (fs::is_regular_file(fs::path(root) / Loader::manifestName, ec)) {
+			manifests.push_back((fs::path(root) / Loader::manifestName).string());
+			continue;
+		}
+
+		for (fs::directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end;
+				!ec && it != end; it.increment(ec)) {
+			if (it->is_directory(ec) && !it->is_symlink(ec))
+				dirs.push_back(it->path());
+		}
+	}
+
+	std::vector<std::vector<std::string>> found(dirs.size());
+	pool.parallelFor(dirs.size(), [&](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; i++)
+			scan(dirs[i], found[i]);
+	});
+
+	for (auto &f: found)
+		manifests.insert(manifests.end(), std::make_move_iterator(f.begin()), std::make_move_iterator(f.end()));
+	std::sort(manifests.begin(), manifests.end());
+
+	out.time.scan = steadyClock::now() - start;
+	return this->construct(pool, std::move(manifests), nullptr, std::move(out), start);
+}
+
+// [result] Load the packages of a lockfile, without scanning; a manifest that no longer matches its hash is
+// reported as an error, after which the packages should be resolved again
+Loader::result Loader::load(const Lockfile &lock) const {
+	steadyClock::time_point start = steadyClock::now();
+	MUtilities::ThreadPool pool(this->_threads);
+	std::vector<std::string> manifests;
+	std::vector<std::uint64_t> hashes;
+
+	for (auto const &e: lock.entries()) {
+		manifests.emplace_back(e.path);
+		hashes.push_back(e.hash);
+	}
+
+	return this->construct(pool, std::move(manifests), &hashes, result(), start);
+}
+
+// [result] Read, construct and validate the packages of manifests, optionally checking their hashes
+Loader::result Loader::construct(MUtilities::ThreadPool &pool, std::vector<std::string> manifests,
+		const std::vector<std::uint64_t> *hashes, result out, steadyClock::time_point start) const {
+	steadyClock::time_point scanned = steadyClock::now();
+
+	// The cache stays mapped until every package has been constructed
+	ManifestCache cache;
+	if (!this->_cache.empty())
+		cache = ManifestCache(this->_cache);
+	steadyClock::duration cacheTime = steadyClock::now() - scanned;
+
+	// Read and parse: every worker handles whole packages, so phases overlap across threads
+	std::vector<std::unique_ptr<Package>> packages(manifests.size());
+	std::vector<std::string> messages(manifests.size());
+	std::vector<ManifestCache::entry> stamps(manifests.size());
+	std::atomic<std::int64_t> readTime(0);
+	std::atomic<std::int64_t> parseTime(0);
+	std::atomic<std::size_t> hits(0);
+
+	pool.parallelFor(manifests.size(), [&](std::size_t begin, std::size_t end) {
+		std::string text;
+		steadyClock::duration read(0), parse(0);
+
+		for (std::size_t i = begin; i < end; i++) {
+			std::string path = fs::path(manifests[i]).parent_path().string();
+			ManifestCache::entry &stamp = stamps[i];
+			steadyClock::time_point t0 = steadyClock::now();
+			bool loaded = false;
+			bool stamped = false;
+
+			// A locked manifest is read first, as it must match its hash even if it is cached. It is stamped before
+			// and after being read: only if the stamp did not change is it the stamp of the bytes checked against
+			// the lock, so that a cached record of it may stand in for them.
+			if (hashes) {
+				bool before = fileStamp(manifests[i], stamp.size, stamp.mtime);
+				loaded = Loader::readManifest(manifests[i], text);
+
+				std::uint64_t size = 0;
+				std::int64_t mtime = 0;
+				stamped = before && loaded && fileStamp(manifests[i], size, mtime) && size == stamp.size &&
+					mtime == stamp.mtime;
+				read += steadyClock::now() - t0;
+
+				if (!loaded) {
+					messages[i] = "MPackages::Loader::unreadableManifest";
+					continue;
+				}
+				if (MUtilities::Utility::fnv1a(text) != (*hashes)[i]) {
+					messages[i] = "MPackages::Loader::lockMismatch";
+					continue;
+				}
+				t0 = steadyClock::now();
+			} else {
+				stamped = fileStamp(manifests[i], stamp.size, stamp.mtime);
+			}
+
+			// A cached record is used if the manifest is unchanged; a record that fails to decode is parsed again.
+			// A manifest without a stamp is neither looked up nor written back.
+			if (stamped) {
+				stamp.path = manifests[i];
+
+				if (std::optional<Manifest> record = cache.find(manifests[i], stamp.size, stamp.mtime)) {
+					try {
+						packages[i] = this->_factory(path, *record);
+						parse += steadyClock::now() - t0;
+						hits++;
+						continue;
+					} catch (...) {}
+				}
+			}
+
+			steadyClock::time_point t1 = steadyClock::now();
+			bool ok = loaded || Loader::readManifest(manifests[i], text);
+			steadyClock::time_point t2 = steadyClock::now();
+			read += t2 - t1;
+
+			if (!ok) {
+				messages[i] = "MPackages::Loader::unreadableManifest";
+				continue;
+			}
+
+			try {
+				packages[i] = this->_factory(path, Manifest(text));
+			} catch (const char *e) {
+				messages[i] = e;
+			} catch (const std::string &e) {
+				messages[i] = e;
+			} catch (const std::exception &e) {
+				messages[i] = e.what();
+			}
+			parse += steadyClock::now() - t2;
+		}
+
+		readTime += std::chrono::duration_cast<std::chrono::nanoseconds>(read).count();
+		parseTime += std::chrono::duration_cast<std::chrono::nanoseconds>(parse).count();
+	});
+
+	out.time.read = std::chrono::nanoseconds(readTime.load());
+	out.time.parse = std::chrono::nanoseconds(parseTime.load());
+	out.cached = hits.load();
+
+	// Rewrite the cache if a package was parsed, or if it holds manifests that are gone or now invalid
+	const char *cacheError = nullptr;
+	if (!this->_cache.empty()) {
+		steadyClock::time_point t0 = steadyClock::now();
+		std::vector<ManifestCache::entry> entries;
+
+		for (std::size_t i = 0; i < manifests.size(); i++) {
+			if (packages[i] && !stamps[i].path.empty()) {
+				stamps[i].package = packages[i].get();
+				entries.push_back(std::move(stamps[i]));
+			}
+		}
+
+		if (entries.size() != out.cached || cache.size() != out.cached) {
+			try {
+				ManifestCache::write(this->_cache, entries);
+			} catch (const char *e) {
+				cacheError = e;
+			}
+		}
+
+		cacheTime += steadyClock::now() - t0;
+	}
+	out.time.cache = cacheTime;
+
+	// Validate: a name and version may only be provided once; the first manifest by path wins
+	steadyClock::time_point parsed = steadyClock::now();
+	std::vector<std::size_t> order;
+	for (std::size_t i = 0; i < packages.size(); i++)
+		if (packages[i])
+			order.push_back(i);
+
+	std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+		int c = packages[a]->name().compare(packages[b]->name());
+		return (c != 0) ? (c < 0) : (packages[a]->version().compare(packages[b]->version()) < 0);
+	});
+
+	for (std::size_t k = 1; k < order.size(); k++) {
+		const Package &prev = *packages[order[k - 1]];
+		const Package &cur = *packages[order[k]];
+
+		if (prev.name() == cur.name() && prev.version() == cur.version()) {
+			messages[order[k]] = "MPackages::Loader::duplicatePackage";
+			packages[order[k]].reset();
+			order[k] = order[k - 1]; // Compare later duplicates against the kept package
+		}
+	}
+
+	for (std::size_t i = 0; i < manifests.size(); i++) {
+		if (packages[i])
+			out.packages.push_back(std::move(packages[i]));
+		else
+			out.errors.push_back({std::move(manifests[i]), std::move(messages[i])});
+	}
+	if (cacheError)
+		out.errors.push_back({this->_cache, cacheError});
+
+	steadyClock::time_point done = steadyClock::now();
+	out.time.validate = done - parsed;
+	out.time.total = done - start;
+
+	return out;
+}
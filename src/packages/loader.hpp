@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <sys/stat.h>
+
+#include "package.hpp"
+#include "manifest.hpp"
+#include "cache.hpp"
+#include "lockfile.hpp"
+#include "../utilities/threadpool.hpp"
+
+namespace MPackages {
+
+/* Package Loader Class */
+
+// Finds package manifests below one or more root directories, and reads and constructs the packages on
+// a pool of worker threads. Packages that fail to load are reported as errors instead of aborting.
+// With a cache file set, unchanged manifests are constructed from the cache instead of being parsed.
+// Given a lockfile, exactly its manifests are loaded without scanning, each checked against its hash.
+class Loader {
+	public:
+		// Constructs a package of the concrete type from its directory and manifest
+		typedef std::function<std::unique_ptr<Package>(std::string path, const Manifest &manifest)> Factory;
+
+		/* Load Error Class */
+		class error {
+			public:
+				std::string path; // Manifest file, or root directory for scan errors
+				std::string message;
+		};
+
+		/* Phase Timings Class */
+		class timings {
+			public:
+				// Wall time of the directory scan and of the catalog-wide checks
+				std::chrono::nanoseconds scan{0};
+				std::chrono::nanoseconds validate{0};
+				// Worker time summed over all threads: reading (and for a lockfile, hashing) manifest files,
+				// and constructing packages from them (including their per-field validation)
+				std::chrono::nanoseconds read{0};
+				std::chrono::nanoseconds parse{0};
+				// Wall time of opening the cache file and of writing it back
+				std::chrono::nanoseconds cache{0};
+				// Wall time of the whole load
+				std::chrono::nanoseconds total{0};
+		};
+
+		/* Load Result Class */
+		class result {
+			public:
+				std::vector<std::unique_ptr<Package>> packages; // Sorted by manifest path, or in lockfile order
+				std::vector<error> errors;
+				std::size_t cached = 0; // Packages constructed from the cache
+				timings time;
+		};
+
+		static const char *manifestName; // File name of a package manifest
+
+		static bool readManifest(const std::string &path, std::string &out); // Reuses the capacity of out
+
+		Loader(Factory factory, std::size_t threads = 0); // 0 uses one thread per hardware thread
+
+		const Factory &factory() const;
+
+		void addRoot(std::string path);
+		const std::vector<std::string> &roots() const;
+		void setCache(std::string path); // Empty disables the cache
+		const std::string &cache() const;
+
+		result load() const;
+		result load(const Lockfile &lock) const;
+	private:
+		Factory _factory;
+		std::size_t _threads;
+		std::vector<std::string> _roots;
+		std::string _cache;
+
+		result construct(MUtilities::ThreadPool &pool, std::vector<std::string> manifests,
+			const std::vector<std::uint64_t> *hashes, result out, std::chrono::steady_clock::time_point start) const;
+};
+
+}
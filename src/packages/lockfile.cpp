@@ -0,0 +1,256 @@
+#include "lockfile.hpp"
+#include "loader.hpp"
+
+using namespace MPackages;
+
+namespace fs = std::filesystem;
+
+namespace {
+	const char magic[8] = {'E', 'D', 'N', 'L', 'O', 'C', 'K', 'F'};
+	const std::size_t headerSize = 24;
+	const std::size_t entrySize = 32;
+
+	using MUtilities::Binary::put;
+	using MUtilities::Binary::get;
+
+	// [void] Append the text line of a package
+	void putLine(std::string &out, std::string_view name, std::string_view version, std::uint64_t hash,
+			std::string_view path) {
+		char digits[17];
+		std::snprintf(digits, sizeof(digits), "%016llx", static_cast<unsigned long long>(hash));
+
+		out.append(name);
+		out += '@';
+		out.append(version);
+		out += ' ';
+		out.append(digits, 16);
+		out += ' ';
+		out.append(path);
+		out += '\n';
+	}
+
+	// [bool] Parse exactly 16 hexadecimal digits
+	bool parseHash(std::string_view digits, std::uint64_t &out) {
+		if (digits.size() != 16)
+			return false;
+
+		out = 0;
+		for (char c: digits) {
+			int value = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+				(c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+			if (value < 0)
+				return false;
+			out = (out << 4) | static_cast<std::uint64_t>(value);
+		}
+		return true;
+	}
+}
+
+/* Lockfile Class */
+
+const std::uint32_t Lockfile::formatVersion = 1;
+
+// [constructor] Empty lockfile
+Lockfile::Lockfile() {}
+
+// [constructor] Lock packages of a registry, e.g. Resolver::result::packages, hashing their manifests on
+// the given number of threads (0 uses one per hardware thread)
+Lockfile::Lockfile(const Registry &registry, const std::vector<Registry::id> &packages, std::size_t threads) {
+	std::vector<const Package *> sorted;
+	for (Registry::id id: packages)
+		sorted.push_back(&registry.get(id));
+	std::sort(sorted.begin(), sorted.end(), [](const Package *a, const Package *b) {
+		int c = a->name().compare(b->name());
+		return (c != 0) ? (c < 0) : (a->version().compare(b->version()) < 0);
+	});
+
+	std::vector<std::string> paths(sorted.size());
+	std::vector<std::uint64_t> hashes(sorted.size());
+	std::vector<char> readable(sorted.size());
+	for (std::size_t i = 0; i < sorted.size(); i++)
+		paths[i] = (fs::path(sorted[i]->path()) / Loader::manifestName).string();
+
+	MUtilities::ThreadPool pool(threads);
+	pool.parallelFor(sorted.size(), [&](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; i++)
+			readable[i] = Lockfile::hash(paths[i], hashes[i]);
+	});
+
+	if (std::find(readable.begin(), readable.end(), 0) != readable.end())
+		throw "MPackages::Lockfile::unreadableManifest";
+
+	// The entries view the text form, which is kept
+	this->_text.reset(new std::string());
+	for (std::size_t i = 0; i < sorted.size(); i++)
+		putLine(*this->_text, sorted[i]->name(), sorted[i]->version().str(), hashes[i], paths[i]);
+	this->parse(*this->_text);
+}
+
+// [constructor] Map a lockfile of either form
+Lockfile::Lockfile(const std::string &path) {
+	try {
+		this->_file.reset(new MUtilities::MappedFile(path));
+	} catch (const char *) {
+		throw "MPackages::Lockfile::openFailed";
+	}
+
+	std::string_view bytes = this->_file->view();
+	if (bytes.size() >= sizeof(magic) && std::memcmp(bytes.data(), magic, sizeof(magic)) == 0)
+		this->decode(bytes);
+	else
+		this->parse(bytes);
+}
+
+// [vector of entries] Get the locked packages, sorted by name
+const std::vector<Lockfile::entry> &Lockfile::entries() const {
+	return this->_entries;
+}
+// [size_t] Get number of locked packages
+std::size_t Lockfile::size() const {
+	return this->_entries.size();
+}
+
+// [string] Get the text form
+std::string Lockfile::text() const {
+	std::string out = "# EdenGame lockfile " + std::to_string(Lockfile::formatVersion) + "\n";
+	for (auto const &e: this->_entries)
+		putLine(out, e.name, e.version, e.hash, e.path);
+	return out;
+}
+
+// [void] Write the text form to path
+void Lockfile::write(const std::string &path) const {
+	Lockfile::save(path, this->text());
+}
+
+// [void] Write the binary form to path
+void Lockfile::writeBinary(const std::string &path) const {
+	std::string out(magic, sizeof(magic));
+	put<std::uint32_t>(out, Lockfile::formatVersion);
+	put<std::uint32_t>(out, static_cast<std::uint32_t>(this->_entries.size()));
+	put<std::uint64_t>(out, 0); // File size, set below
+
+	std::string strings;
+	std::size_t base = headerSize + this->_entries.size() * entrySize;
+	for (auto const &e: this->_entries) {
+		put<std::uint64_t>(out, e.hash);
+		for (std::string_view s: {e.name, e.version, e.path}) {
+			put<std::uint32_t>(out, static_cast<std::uint32_t>(base + strings.size()));
+			put<std::uint32_t>(out, static_cast<std::uint32_t>(s.size()));
+			strings.append(s);
+		}
+	}
+
+	out.append(strings);
+	std::uint64_t size = out.size();
+	std::memcpy(&out[16], &size, sizeof(size));
+	Lockfile::save(path, out);
+}
+
+// [vector of indices] Hash every locked manifest again on the given number of threads (0 uses one per
+// hardware thread), and get the entries whose manifest changed or can not be read
+std::vector<std::size_t> Lockfile::verify(std::size_t threads) const {
+	std::vector<char> changed(this->_entries.size());
+
+	MUtilities::ThreadPool pool(threads);
+	pool.parallelFor(this->_entries.size(), [&](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; i++) {
+			std::uint64_t hash;
+			changed[i] = !Lockfile::hash(std::string(this->_entries[i].path), hash) || hash != this->_entries[i].hash;
+		}
+	});
+
+	std::vector<std::size_t> out;
+	for (std::size_t i = 0; i < changed.size(); i++)
+		if (changed[i])
+			out.push_back(i);
+	return out;
+}
+
+// [bool] Hash the contents of a file; false if it can not be read. Manifests are small, so they are read
+// in chunks, which costs less than setting up a mapping.
+bool Lockfile::hash(const std::string &path, std::uint64_t &out) {
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	char buffer[16384];
+	std::uint64_t hash = MUtilities::Utility::fnv1a("");
+	ssize_t n;
+	while ((n = ::read(fd, buffer, sizeof(buffer))) > 0)
+		hash = MUtilities::Utility::fnv1a(std::string_view(buffer, static_cast<std::size_t>(n)), hash);
+
+	::close(fd);
+	if (n < 0)
+		return false;
+
+	out = hash;
+	return true;
+}
+
+// [void] Read the entries of the text form; blank lines and lines starting with # are skipped
+void Lockfile::parse(std::string_view text) {
+	std::size_t pos = 0;
+	while (pos < text.size()) {
+		std::size_t end = std::min(text.find('\n', pos), text.size());
+		std::string_view line = text.substr(pos, end - pos);
+		pos = end + 1;
+
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		// The path is the rest of the line, and may contain spaces
+		std::size_t at = line.find('@');
+		std::size_t space = line.find(' ', at);
+		std::size_t second = (space == std::string_view::npos) ? space : line.find(' ', space + 1);
+		entry e;
+
+		if (at == 0 || at == std::string_view::npos || space == std::string_view::npos || space == at + 1 ||
+				second == std::string_view::npos || second + 1 == line.size() ||
+				!parseHash(line.substr(space + 1, second - space - 1), e.hash))
+			throw "MPackages::Lockfile::invalidFile";
+
+		e.name = line.substr(0, at);
+		e.version = line.substr(at + 1, space - at - 1);
+		e.path = line.substr(second + 1);
+		this->_entries.push_back(e);
+	}
+}
+
+// [void] Read the entries of the binary form, checking every offset against the file
+void Lockfile::decode(std::string_view bytes) {
+	if (bytes.size() < headerSize || get<std::uint32_t>(bytes, 8) != Lockfile::formatVersion ||
+			get<std::uint64_t>(bytes, 16) != bytes.size())
+		throw "MPackages::Lockfile::invalidFile";
+
+	std::uint32_t count = get<std::uint32_t>(bytes, 12);
+	if ((bytes.size() - headerSize) / entrySize < count)
+		throw "MPackages::Lockfile::invalidFile";
+
+	// [string_view] String whose offset and length are stored at position
+	auto string = [bytes](std::size_t position) {
+		std::uint32_t offset = get<std::uint32_t>(bytes, position);
+		std::uint32_t length = get<std::uint32_t>(bytes, position + 4);
+		if (offset > bytes.size() || bytes.size() - offset < length)
+			throw "MPackages::Lockfile::invalidFile";
+		return bytes.substr(offset, length);
+	};
+
+	this->_entries.resize(count);
+	for (std::uint32_t i = 0; i < count; i++) {
+		std::size_t position = headerSize + i * entrySize;
+		entry &e = this->_entries[i];
+		e.hash = get<std::uint64_t>(bytes, position);
+		e.name = string(position + 8);
+		e.version = string(position + 16);
+		e.path = string(position + 24);
+	}
+}
+
+// [void] Write bytes to path, replacing any existing file only once they are complete
+void Lockfile::save(const std::string &path, const std::string &bytes) {
+	if (!MUtilities::AtomicFile::write(path, bytes))
+		throw "MPackages::Lockfile::writeFailed";
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+
+#include "registry.hpp"
+#include "../utilities/mappedfile.hpp"
+#include "../utilities/atomicfile.hpp"
+#include "../utilities/binary.hpp"
+#include "../utilities/threadpool.hpp"
+#include "../utilities/utility.hpp"
+
+namespace MPackages {
+
+/* Lockfile Class */
+
+// A known-good resolution: the chosen version of every package and an FNV-1a hash of the manifest it was
+// read from, so that startup can check that nothing changed and skip resolution. Entries are sorted by
+// name. The text form, for diffs, has one line per package after a comment line:
+//   name@version 0123456789abcdef path/to/package.json
+// The binary form is read in place through a memory mapping. Layout, in native byte order:
+//   header   "EDNLOCKF", u32 format version, u32 entry count, u64 file size
+//   entries  u64 hash, then u32 offset and u32 length of the name, the version and the manifest path
+//   strings
+// Either form is detected when reading.
+class Lockfile {
+	public:
+		/* Locked Package Class */
+		class entry {
+			public:
+				// Views into the lockfile
+				std::string_view name;
+				std::string_view version;
+				std::uint64_t hash; // Of the manifest file
+				std::string_view path; // Manifest file
+		};
+
+		static const std::uint32_t formatVersion;
+
+		Lockfile(); // Empty lockfile
+		Lockfile(const Registry &registry, const std::vector<Registry::id> &packages, std::size_t threads = 0);
+		Lockfile(const std::string &path);
+
+		Lockfile(Lockfile &&) = default;
+		Lockfile &operator = (Lockfile &&) = default;
+
+		const std::vector<entry> &entries() const;
+		std::size_t size() const;
+
+		std::string text() const;
+		void write(const std::string &path) const; // Text form
+		void writeBinary(const std::string &path) const;
+
+		std::vector<std::size_t> verify(std::size_t threads = 0) const; // Entries whose manifest changed
+
+		static bool hash(const std::string &path, std::uint64_t &out); // Hash a file; false if unreadable
+	private:
+		std::unique_ptr<std::string> _text; // Owned text form, for lockfiles made from a registry
+		std::unique_ptr<MUtilities::MappedFile> _file;
+		std::vector<entry> _entries;
+
+		void parse(std::string_view text);
+		void decode(std::string_view bytes);
+		static void save(const std::string &path, const std::string &bytes);
+};
+
+}
@@ -0,0 +1,739 @@
+#include "manifest.hpp"
+
+using namespace MPackages;
+
+namespace {
+	// Deepest nesting accepted, matching the JSON reader's default stack limit
+	const std::size_t maxDepth = 1000;
+
+	// [int] Value of a hexadecimal digit, or -1
+	int hexValue(char c) {
+		if (c >= '0' && c <= '9')
+			return c - '0';
+		if (c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+		return -1;
+	}
+
+	// [void] Append a code point encoded as UTF-8
+	void appendUtf8(std::string &out, unsigned int cp) {
+		if (cp <= 0x7F) {
+			out.push_back(static_cast<char>(cp));
+		} else if (cp <= 0x7FF) {
+			out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+			out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+		} else if (cp <= 0xFFFF) {
+			out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+			out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+		} else {
+			out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+			out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+		}
+	}
+}
+
+/* Manifest Class */
+
+// [constructor] View of manifest bytes in the given format
+Manifest::Manifest(std::string_view bytes, Format format) : _bytes(bytes), _format(format) {}
+
+// [Format] Get format
+Manifest::Format Manifest::format() const {
+	return this->_format;
+}
+// [string_view] Get bytes
+std::string_view Manifest::bytes() const {
+	return this->_bytes;
+}
+
+/* Manifest Reader Class */
+
+// Sorted by key, looked up with a binary search
+const ManifestReader::field ManifestReader::fields[] = {
+	{"author", Field::author, &ManifestReader::readAuthor},
+	{"bugs", Field::bugs, &ManifestReader::readBugs},
+	{"contributors", Field::contributors, &ManifestReader::readContributors},
+	{"dependencies", Field::dependencies, &ManifestReader::readDependencies},
+	{"description", Field::description, &ManifestReader::readDescription},
+	{"homepage", Field::homepage, &ManifestReader::readHomepage},
+	{"keywords", Field::keywords, &ManifestReader::readKeywords},
+	{"license", Field::license, &ManifestReader::readLicense},
+	{"name", Field::name, &ManifestReader::readName},
+	{"optionalDependencies", Field::optionalDependencies, &ManifestReader::readOptionalDependencies},
+	{"private", Field::isPrivate, &ManifestReader::readPrivate},
+	{"repository", Field::repository, &ManifestReader::readRepository},
+	{"title", Field::title, &ManifestReader::readTitle},
+	{"version", Field::version, &ManifestReader::readVersion}
+};
+const std::size_t ManifestReader::fieldCount = sizeof(ManifestReader::fields) / sizeof(ManifestReader::fields[0]);
+
+// [constructor] Read from manifest text, which must outlive the reader
+ManifestReader::ManifestReader(std::string_view manifest) : _src(manifest) {}
+
+// [void] Stream the manifest into the fields of a package, throwing the first error in field order
+void ManifestReader::read(Package::fields &out) {
+	// Required fields are invalid until they are seen
+	this->_errors[static_cast<std::size_t>(Field::name)] = std::make_exception_ptr("MPackages::Package::invalidName");
+	this->_errors[static_cast<std::size_t>(Field::version)] =
+		std::make_exception_ptr("MPackages::Package::invalidVersion");
+
+	// Skip a UTF-8 byte order mark
+	if (this->_src.substr(0, 3) == "\xEF\xBB\xBF")
+		this->_pos = 3;
+
+	this->skipSpace();
+	if (this->peek() != '{')
+		this->fail();
+
+	// Fields are handled as they stream past; a repeated key replaces the earlier value, as in a DOM
+	this->readObject([&](std::string_view key) {
+		const field *end = ManifestReader::fields + ManifestReader::fieldCount;
+		const field *f = std::lower_bound(ManifestReader::fields, end, key,
+			[](const field &a, std::string_view k) { return a.key < k; });
+
+		if (f != end && f->key == key)
+			(this->*(f->read))(out);
+		else
+			this->skipValue(1);
+	});
+
+	for (auto &error: this->_errors)
+		if (error)
+			std::rethrow_exception(error);
+}
+
+// [void] Skip whitespace and comments
+void ManifestReader::skipSpace() {
+	while (this->_pos < this->_src.size()) {
+		char c = this->_src[this->_pos];
+
+		if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+			this->_pos++;
+		} else if (c == '/' && this->_src.substr(this->_pos, 2) == "//") {
+			std::size_t end = this->_src.find_first_of("\r\n", this->_pos);
+			this->_pos = (end == std::string_view::npos) ? this->_src.size() : end;
+		} else if (c == '/' && this->_src.substr(this->_pos, 2) == "/*") {
+			std::size_t end = this->_src.find("*/", this->_pos + 2);
+			if (end == std::string_view::npos)
+				this->fail();
+			this->_pos = end + 2;
+		} else {
+			break;
+		}
+	}
+}
+
+// [char] Get the next character without consuming it, or '\0' at the end
+char ManifestReader::peek() {
+	return (this->_pos < this->_src.size()) ? this->_src[this->_pos] : '\0';
+}
+
+// [void] Consume c or fail
+void ManifestReader::expect(char c) {
+	if (this->_pos >= this->_src.size() || this->_src[this->_pos] != c)
+		this->fail();
+
+	this->_pos++;
+}
+
+// [void] Report malformed JSON
+void ManifestReader::fail() const {
+	throw "MPackages::Package::invalidManifest";
+}
+
+// [unsigned int] Read four hexadecimal digits
+unsigned int ManifestReader::readHex4() {
+	if (this->_src.size() - this->_pos < 4)
+		this->fail();
+
+	unsigned int cp = 0;
+	for (int i = 0; i < 4; i++) {
+		int digit = hexValue(this->_src[this->_pos++]);
+		if (digit < 0)
+			this->fail();
+		cp = (cp << 4) | static_cast<unsigned int>(digit);
+	}
+
+	return cp;
+}
+
+// [string view] Read a string; it views the manifest unless it contained escapes
+std::string_view ManifestReader::readString() {
+	this->expect('"');
+
+	std::size_t start = this->_pos;
+	std::size_t end = this->_src.find_first_of("\"\\", start);
+	if (end == std::string_view::npos)
+		this->fail();
+
+	if (this->_src[end] == '"') {
+		this->_pos = end + 1;
+		return this->_src.substr(start, end - start);
+	}
+
+	std::string &out = this->_decoded.emplace_back(this->_src.substr(start, end - start));
+	this->_pos = end;
+
+	while (true) {
+		if (this->_pos >= this->_src.size())
+			this->fail();
+
+		char c = this->_src[this->_pos++];
+		if (c == '"')
+			return out;
+
+		if (c != '\\') {
+			out.push_back(c);
+			continue;
+		}
+
+		if (this->_pos >= this->_src.size())
+			this->fail();
+
+		switch (this->_src[this->_pos++]) {
+			case '"': out.push_back('"'); break;
+			case '\\': out.push_back('\\'); break;
+			case '/': out.push_back('/'); break;
+			case 'b': out.push_back('\b'); break;
+			case 'f': out.push_back('\f'); break;
+			case 'n': out.push_back('\n'); break;
+			case 'r': out.push_back('\r'); break;
+			case 't': out.push_back('\t'); break;
+			case 'u': {
+				unsigned int cp = this->readHex4();
+
+				// A high surrogate must be followed by a second escape
+				if (cp >= 0xD800 && cp <= 0xDBFF) {
+					if (this->_src.substr(this->_pos, 2) != "\\u")
+						this->fail();
+
+					this->_pos += 2;
+					cp = 0x10000 + ((cp & 0x3FF) << 10) + (this->readHex4() & 0x3FF);
+				}
+
+				appendUtf8(out, cp);
+				break;
+			}
+			default:
+				this->fail();
+		}
+	}
+}
+
+// [value] Read any value; strings, booleans and null are kept, objects and arrays are skipped
+ManifestReader::value ManifestReader::readValue(std::size_t depth) {
+	value v;
+
+	switch (this->peek()) {
+		case '"':
+			v.type = Type::string;
+			v.str = this->readString();
+			break;
+		case '{':
+			v.type = Type::object;
+			this->skipValue(depth);
+			break;
+		case '[':
+			v.type = Type::array;
+			this->skipValue(depth);
+			break;
+		case 't':
+			v.type = Type::boolean;
+			v.boolean = true;
+			this->readLiteral("true");
+			break;
+		case 'f':
+			v.type = Type::boolean;
+			this->readLiteral("false");
+			break;
+		case 'n':
+			this->readLiteral("null");
+			break;
+		default:
+			v.type = Type::number;
+			this->readNumber();
+	}
+
+	return v;
+}
+
+// [void] Skip any value
+void ManifestReader::skipValue(std::size_t depth) {
+	switch (this->peek()) {
+		case '{':
+			this->readObject([&](std::string_view) { this->skipValue(depth + 1); }, depth);
+			break;
+		case '[':
+			this->readArray([&]() { this->skipValue(depth + 1); }, depth);
+			break;
+		default:
+			this->readValue(depth);
+	}
+}
+
+// [void] Read a number, -?digits(.digits)?([eE][+-]?digits)?
+void ManifestReader::readNumber() {
+	auto digits = [this]() {
+		std::size_t start = this->_pos;
+		while (this->_pos < this->_src.size() && this->_src[this->_pos] >= '0' && this->_src[this->_pos] <= '9')
+			this->_pos++;
+		if (this->_pos == start)
+			this->fail();
+	};
+
+	if (this->peek() == '-')
+		this->_pos++;
+	digits();
+
+	if (this->peek() == '.') {
+		this->_pos++;
+		digits();
+	}
+
+	if (this->peek() == 'e' || this->peek() == 'E') {
+		this->_pos++;
+		if (this->peek() == '+' || this->peek() == '-')
+			this->_pos++;
+		digits();
+	}
+}
+
+// [void] Read true, false or null
+void ManifestReader::readLiteral(std::string_view literal) {
+	if (this->_src.substr(this->_pos, literal.size()) != literal)
+		this->fail();
+
+	this->_pos += literal.size();
+}
+
+// [void] Read an object, calling member(key) with the reader positioned at each member's value
+template<typename F> void ManifestReader::readObject(F member, std::size_t depth) {
+	if (depth >= maxDepth)
+		this->fail();
+
+	this->expect('{');
+	this->skipSpace();
+
+	if (this->peek() == '}') {
+		this->_pos++;
+		return;
+	}
+
+	while (true) {
+		this->skipSpace();
+		std::string_view key = this->readString();
+		this->skipSpace();
+		this->expect(':');
+		this->skipSpace();
+
+		member(key);
+
+		this->skipSpace();
+		if (this->peek() == '}') {
+			this->_pos++;
+			return;
+		}
+
+		// A trailing comma before the closing bracket is accepted, as the JSON reader does
+		this->expect(',');
+		this->skipSpace();
+		if (this->peek() == '}') {
+			this->_pos++;
+			return;
+		}
+	}
+}
+
+// [void] Read an array, calling element() with the reader positioned at each element
+template<typename F> void ManifestReader::readArray(F element, std::size_t depth) {
+	if (depth >= maxDepth)
+		this->fail();
+
+	this->expect('[');
+	this->skipSpace();
+
+	if (this->peek() == ']') {
+		this->_pos++;
+		return;
+	}
+
+	while (true) {
+		this->skipSpace();
+
+		element();
+
+		this->skipSpace();
+		if (this->peek() == ']') {
+			this->_pos++;
+			return;
+		}
+
+		// A trailing comma before the closing bracket is accepted, as the JSON reader does
+		this->expect(',');
+		this->skipSpace();
+		if (this->peek() == ']') {
+			this->_pos++;
+			return;
+		}
+	}
+}
+
+// [person] Read a person in string or object form; any other value is kept only by type
+ManifestReader::person ManifestReader::readPerson(std::size_t depth) {
+	person p;
+
+	if (this->peek() != '{') {
+		p.str = this->readValue(depth);
+		return p;
+	}
+
+	p.str.type = Type::object;
+	this->readObject([&](std::string_view key) {
+		if (key == "name")
+			p.name = this->readValue(depth + 1);
+		else if (key == "email")
+			p.email = this->readValue(depth + 1);
+		else if (key == "url")
+			p.url = this->readValue(depth + 1);
+		else
+			this->skipValue(depth + 1);
+	}, depth);
+
+	return p;
+}
+
+// [vector of members] Read every member of an object
+std::vector<std::pair<std::string_view, ManifestReader::value>> ManifestReader::readMembers(std::size_t depth) {
+	std::vector<std::pair<std::string_view, value>> members;
+
+	this->readObject([&](std::string_view key) {
+		members.emplace_back(key, this->readValue(depth + 1));
+	}, depth);
+
+	return members;
+}
+
+// [void] Run apply, recording (instead of throwing) its error as the field's error
+template<typename F> void ManifestReader::attempt(Field id, F apply) {
+	std::exception_ptr &error = this->_errors[static_cast<std::size_t>(id)];
+	error = nullptr;
+
+	try {
+		apply();
+	} catch (...) {
+		error = std::current_exception();
+	}
+}
+
+// [Person] Construct a person, checking object members in the same order as Person(const Json::Value&)
+MUtilities::Person ManifestReader::makePerson(const person &p) {
+	if (p.str.type == Type::string)
+		return MUtilities::Person(p.str.str);
+
+	if (p.name.type == Type::null)
+		throw "MUtilities::Person::nameCannotBeNull";
+	if (p.name.type != Type::string)
+		throw "MUtilities::Person::nameMustBeString";
+	if (!MUtilities::Person::validName(p.name.str))
+		throw "MUtilities::Person::invalidName";
+	if (p.email.type != Type::null && p.email.type != Type::string)
+		throw "MUtilities::Person::emailMustBeString";
+	if (p.url.type != Type::null && p.url.type != Type::string)
+		throw "MUtilities::Person::urlMustBeString";
+
+	return MUtilities::Person(p.name.str, p.email.str, p.url.str);
+}
+
+// [void] Fill a dependency map from object members, visiting them in key order like a DOM would
+void ManifestReader::collectDependencies(std::vector<std::pair<std::string_view, value>> &members,
+		std::vector<Dependency> &out, const char *invalidDependency, const char *invalidList) {
+	std::stable_sort(members.begin(), members.end(), [](const auto &a, const auto &b) {
+		return a.first < b.first;
+	});
+
+	// Of repeated keys only the last one counts
+	auto last = members.end();
+	for (auto it = members.begin(); it != members.end(); it++) {
+		if (std::next(it) != members.end() && std::next(it)->first == it->first)
+			continue;
+
+		last = it;
+		const value &depend = it->second;
+
+		if (depend.type == Type::string && MUtilities::Validate::dependName(it->first)) {
+			out.emplace_back(it->first, *MUtilities::Range::intern(depend.str));
+		} else if (depend.type != Type::null) {
+			throw invalidDependency;
+		}
+	}
+
+	if (last == members.end())
+		throw invalidList;
+}
+
+// [void] Read package name (required)
+void ManifestReader::readName(Package::fields &f) {
+	value v = this->readValue(1);
+
+	this->attempt(Field::name, [&]() {
+		if (v.type == Type::string && MUtilities::Validate::packageName(v.str)) {
+			f.name = v.str;
+		} else {
+			throw "MPackages::Package::invalidName";
+		}
+	});
+}
+
+// [void] Read version (required)
+void ManifestReader::readVersion(Package::fields &f) {
+	value v = this->readValue(1);
+
+	this->attempt(Field::version, [&]() {
+		if (v.type == Type::string) {
+			f.version = *MUtilities::Version::intern(v.str);
+		} else {
+			throw "MPackages::Package::invalidVersion";
+		}
+	});
+}
+
+// [void] Read title
+void ManifestReader::readTitle(Package::fields &f) {
+	value v = this->readValue(1);
+
+	this->attempt(Field::title, [&]() {
+		f.title = std::string_view();
+		if (v.type == Type::string) {
+			f.title = v.str;
+		} else if (v.type != Type::null) {
+			throw "MPackages::Package::invalidTitle";
+		}
+	});
+}
+
+// [void] Read description
+void ManifestReader::readDescription(Package::fields &f) {
+	value v = this->readValue(1);
+
+	this->attempt(Field::description, [&]() {
+		f.description = std::string_view();
+		if (v.type == Type::string) {
+			f.description = v.str;
+		} else if (v.type != Type::null) {
+			throw "MPackages::Package::invalidDescription";
+		}
+	});
+}
+
+// [void] Read keywords
+void ManifestReader::readKeywords(Package::fields &f) {
+	f.keywords.clear();
+
+	if (this->peek() == '[') {
+		bool valid = true;
+		this->readArray([&]() {
+			value v = this->readValue(2);
+			if (valid && v.type == Type::string)
+				f.keywords.emplace_back(v.str);
+			else
+				valid = false;
+		}, 1);
+
+		this->attempt(Field::keywords, [&]() {
+			if (!valid)
+				throw "MPackages::Package::invalidKeyword";
+		});
+	} else {
+		value v = this->readValue(1);
+
+		this->attempt(Field::keywords, [&]() {
+			if (v.type != Type::null)
+				throw "MPackages::Package::invalidKeywordList";
+		});
+	}
+}
+
+// [void] Read homepage
+void ManifestReader::readHomepage(Package::fields &f) {
+	value v = this->readValue(1);
+
+	this->attempt(Field::homepage, [&]() {
+		f.homepage = std::string_view();
+		if (v.type == Type::string && MUtilities::Validate::url(v.str)) {
+			f.homepage = v.str;
+		} else if (v.type != Type::null) {
+			throw "MPackages::Package::invalidHomepage";
+		}
+	});
+}
+
+// [void] Read bug reporting information
+void ManifestReader::readBugs(Package::fields &f) {
+	f.bugsEmail = f.bugsUrl = std::string_view();
+
+	if (this->peek() == '{') {
+		value url, email;
+		this->readObject([&](std::string_view key) {
+			value v = this->readValue(2);
+			if (key == "url")
+				url = v;
+			else if (key == "email")
+				email = v;
+		}, 1);
+
+		this->attempt(Field::bugs, [&]() {
+			if (url.type == Type::string && MUtilities::Validate::url(url.str)) {
+				f.bugsUrl = url.str;
+			} else {
+				throw "MPackages::Package::invalidBugReportUrl";
+			}
+
+			if (email.type == Type::string && MUtilities::Validate::email(email.str)) {
+				f.bugsEmail = email.str;
+			} else {
+				throw "MPackages::Package::invalidBugReportemail";
+			}
+		});
+	} else {
+		value v = this->readValue(1);
+
+		this->attempt(Field::bugs, [&]() {
+			if (v.type != Type::null)
+				throw "MPackages::Package::invalidBugsInformation";
+		});
+	}
+}
+
+// [void] Read license
+void ManifestReader::readLicense(Package::fields &f) {
+	value v = this->readValue(1);
+
+	this->attempt(Field::license, [&]() {
+		f.license = std::string_view();
+		if (v.type == Type::string) {
+			f.license = v.str;
+		} else if (v.type != Type::null) {
+			throw "MPackages::Package::invalidLicense";
+		}
+	});
+}
+
+// [void] Read author
+void ManifestReader::readAuthor(Package::fields &f) {
+	person p = this->readPerson(1);
+
+	this->attempt(Field::author, [&]() {
+		f.author.reset();
+		if (p.str.type == Type::object || p.str.type == Type::string) {
+			f.author.emplace(ManifestReader::makePerson(p));
+		} else if (p.str.type != Type::null) {
+			throw "MPackages::Package::invalidAuthor";
+		}
+	});
+}
+
+// [void] Read contributors
+void ManifestReader::readContributors(Package::fields &f) {
+	if (this->peek() == '[') {
+		std::vector<person> people;
+		this->readArray([&]() {
+			people.push_back(this->readPerson(2));
+		}, 1);
+
+		this->attempt(Field::contributors, [&]() {
+			f.contributors.clear();
+			f.contributors.reserve(people.size());
+
+			for (auto const &p: people) {
+				if (p.str.type == Type::object || p.str.type == Type::string) {
+					f.contributors.push_back(ManifestReader::makePerson(p));
+				} else {
+					throw "MPackages::Package::invalidContributor";
+				}
+			}
+		});
+	} else {
+		value v = this->readValue(1);
+
+		this->attempt(Field::contributors, [&]() {
+			f.contributors.clear();
+			if (v.type != Type::null)
+				throw "MPackages::Package::invalidContributorList";
+		});
+	}
+}
+
+// [void] Read repository
+void ManifestReader::readRepository(Package::fields &f) {
+	value v = this->readValue(1);
+
+	this->attempt(Field::repository, [&]() {
+		f.repository = std::string_view();
+		if (v.type == Type::string && MUtilities::Validate::url(v.str) && MUtilities::Utility::hasSuffix(v.str, ".git")) {
+			f.repository = v.str;
+		} else if (v.type != Type::null) {
+			throw "MPackages::Package::invalidRepository";
+		}
+	});
+}
+
+// [void] Read dependencies
+void ManifestReader::readDependencies(Package::fields &f) {
+	if (this->peek() == '{') {
+		auto members = this->readMembers(1);
+
+		this->attempt(Field::dependencies, [&]() {
+			f.dependencies.clear();
+			ManifestReader::collectDependencies(members, f.dependencies,
+				"MPackages::Package::invalidDependency", "MPackages::Package::invalidDependencyList");
+		});
+	} else {
+		value v = this->readValue(1);
+
+		this->attempt(Field::dependencies, [&]() {
+			f.dependencies.clear();
+			if (v.type != Type::null)
+				throw "MPackages::Package::invalidDependencyList";
+		});
+	}
+}
+
+// [void] Read optional dependencies
+void ManifestReader::readOptionalDependencies(Package::fields &f) {
+	if (this->peek() == '{') {
+		auto members = this->readMembers(1);
+
+		this->attempt(Field::optionalDependencies, [&]() {
+			f.optionalDependencies.clear();
+			ManifestReader::collectDependencies(members, f.optionalDependencies,
+				"MPackages::Package::invalidOptionalDependency", "MPackages::Package::invalidOptionalDependencyList");
+		});
+	} else {
+		value v = this->readValue(1);
+
+		this->attempt(Field::optionalDependencies, [&]() {
+			f.optionalDependencies.clear();
+			if (v.type != Type::null)
+				throw "MPackages::Package::invalidOptionalDependencyList";
+		});
+	}
+}
+
+// [void] Read whether package is private
+void ManifestReader::readPrivate(Package::fields &f) {
+	value v = this->readValue(1);
+
+	this->attempt(Field::isPrivate, [&]() {
+		f.isPrivate = false;
+		if (v.type == Type::boolean) {
+			f.isPrivate = v.boolean;
+		} else if (v.type != Type::null) {
+			throw "MPackages::Package::invalidPrivateStatus";
+		}
+	});
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <map>
+#include <algorithm>
+#include <iterator>
+#include <exception>
+#include <cstddef>
+
+#include "package.hpp"
+
+namespace MPackages {
+
+/* Manifest Class */
+
+// The bytes a package is constructed from, either JSON manifest text or a record of a manifest cache.
+// Does not own the bytes.
+class Manifest {
+	public:
+		enum class Format {
+			json,
+			record // Encoded by ManifestCache::encode from an already validated package
+		};
+
+		explicit Manifest(std::string_view bytes, Format format = Format::json);
+
+		Format format() const;
+		std::string_view bytes() const;
+	private:
+		std::string_view _bytes;
+		Format _format;
+};
+
+/* Manifest Reader Class */
+
+// Streams the bytes of a JSON package manifest once and fills the fields of a Package directly, without
+// building a DOM. Field values are validated exactly as Package(std::string, const Json::Value&) does, and when
+// several fields are invalid the error of the field that constructor checks first is thrown.
+class ManifestReader {
+	public:
+		ManifestReader(std::string_view manifest);
+
+		void read(Package::fields &out);
+	private:
+		// JSON value types, as far as manifest validation cares
+		enum class Type {
+			null,
+			boolean,
+			number,
+			string,
+			array,
+			object
+		};
+
+		// Manifest fields, in the order the DOM constructor validates them
+		enum class Field {
+			name,
+			version,
+			title,
+			description,
+			keywords,
+			homepage,
+			bugs,
+			license,
+			author,
+			contributors,
+			repository,
+			dependencies,
+			optionalDependencies,
+			isPrivate,
+			count
+		};
+
+		/* Scalar Value Class */
+		class value {
+			public:
+				Type type = Type::null;
+				std::string_view str; // Decoded string, if type is string
+				bool boolean = false; // If type is boolean
+		};
+
+		/* Person Value Class (string or object form) */
+		class person {
+			public:
+				value str; // The whole value; only str.str is set, and only for the string form
+				value name;
+				value email;
+				value url;
+		};
+
+		/* Field Table Entry Class */
+		class field {
+			public:
+				std::string_view key;
+				Field id;
+				void (ManifestReader::*read)(Package::fields &f);
+		};
+
+		// Known top-level keys, sorted by key
+		static const field fields[];
+		static const std::size_t fieldCount;
+
+		std::string_view _src;
+		std::size_t _pos = 0;
+		std::deque<std::string> _decoded; // Owns strings that contained escapes, so views stay valid
+		std::exception_ptr _errors[static_cast<std::size_t>(Field::count)];
+
+		// Lexing
+		void skipSpace();
+		char peek();
+		void expect(char c);
+		[[noreturn]] void fail() const;
+		unsigned int readHex4();
+		std::string_view readString();
+		value readValue(std::size_t depth = 0);
+		void skipValue(std::size_t depth);
+		void readNumber();
+		void readLiteral(std::string_view literal);
+		template<typename F> void readObject(F member, std::size_t depth = 0);
+		template<typename F> void readArray(F element, std::size_t depth = 0);
+		person readPerson(std::size_t depth);
+		std::vector<std::pair<std::string_view, value>> readMembers(std::size_t depth);
+
+		// Validation
+		template<typename F> void attempt(Field id, F apply);
+		static MUtilities::Person makePerson(const person &p);
+		static void collectDependencies(std::vector<std::pair<std::string_view, value>> &members,
+			std::vector<Dependency> &out, const char *invalidDependency, const char *invalidList);
+
+		// Field handlers
+		void readName(Package::fields &f);
+		void readVersion(Package::fields &f);
+		void readTitle(Package::fields &f);
+		void readDescription(Package::fields &f);
+		void readKeywords(Package::fields &f);
+		void readHomepage(Package::fields &f);
+		void readBugs(Package::fields &f);
+		void readLicense(Package::fields &f);
+		void readAuthor(Package::fields &f);
+		void readContributors(Package::fields &f);
+		void readRepository(Package::fields &f);
+		void readDependencies(Package::fields &f);
+		void readOptionalDependencies(Package::fields &f);
+		void readPrivate(Package::fields &f);
+};
+
+}
@@ -0,0 +1,270 @@
+#include "overlay.hpp"
+
+using namespace MPackages;
+
+namespace fs = std::filesystem;
+
+namespace {
+	// [void] Point the key of a map entry at other storage holding the same path
+	template<typename Map> void rekey(Map &map, typename Map::iterator it, std::string_view key) {
+		auto node = map.extract(it);
+		node.key() = key;
+		map.insert(std::move(node));
+	}
+}
+
+/* Package Overlay Class */
+
+const Overlay::handle Overlay::none = static_cast<Overlay::handle>(-1);
+
+// [constructor] Empty overlay
+Overlay::Overlay() {}
+
+// [handle] Mount a package on top of the others: an archive named after its directory if there is one,
+// else the directory
+Overlay::handle Overlay::mount(const Package &pkg) {
+	std::error_code ec;
+	std::string path(pkg.path());
+	std::string archive = path + Archive::extension;
+	return this->mount(std::string(pkg.name()), fs::is_regular_file(archive, ec) ? archive : path);
+}
+
+// [handle] Mount a directory or an archive on top of the others
+Overlay::handle Overlay::mount(std::string name, const std::string &path) {
+	std::unique_ptr<source> s(new source());
+	s->name = std::move(name);
+	s->path = path;
+	this->open(*s);
+
+	this->_mounts.push_back(std::move(s));
+	this->insert(static_cast<handle>(this->_mounts.size() - 1));
+	return static_cast<handle>(this->_mounts.size() - 1);
+}
+
+// [void] Remove a mount, uncovering the files it shadowed
+void Overlay::unmount(handle mount) {
+	this->get(mount);
+	this->erase(mount);
+	this->_mounts[mount].reset();
+}
+
+// [void] Scan a directory or map an archive again after it changed on disk; a mount that can no longer be
+// opened is unmounted
+void Overlay::remount(handle mount) {
+	this->get(mount);
+	this->erase(mount);
+
+	try {
+		this->open(*this->_mounts[mount]);
+	} catch (const char *) {
+		this->_mounts[mount].reset();
+		throw;
+	}
+
+	this->insert(mount);
+}
+
+// [vector of handles] Get the mounts in load order
+std::vector<Overlay::handle> Overlay::mounts() const {
+	std::vector<handle> out;
+	for (handle m = 0; m < this->_mounts.size(); m++)
+		if (this->_mounts[m])
+			out.push_back(m);
+	return out;
+}
+
+// [handle] Find the last mount of a package name
+Overlay::handle Overlay::mounted(std::string_view name) const {
+	for (handle m = static_cast<handle>(this->_mounts.size()); m-- > 0;)
+		if (this->_mounts[m] && this->_mounts[m]->name == name)
+			return m;
+	return Overlay::none;
+}
+
+// [string] Get the package name of a mount
+const std::string &Overlay::name(handle mount) const {
+	return this->get(mount).name;
+}
+// [string] Get the directory or archive of a mount
+const std::string &Overlay::path(handle mount) const {
+	return this->get(mount).path;
+}
+// [size_t] Get number of files of a mount, including shadowed ones
+std::size_t Overlay::files(handle mount) const {
+	return this->get(mount).files.size();
+}
+
+// [size_t] Get number of visible paths
+std::size_t Overlay::size() const {
+	return this->_index.size();
+}
+
+// [bool] Whether any mount has a file at path
+bool Overlay::exists(std::string_view path) const {
+	return this->_index.count(path) > 0;
+}
+
+// [handle] Get the mount a path resolves to
+Overlay::handle Overlay::owner(std::string_view path) const {
+	auto it = this->_index.find(path);
+	return (it == this->_index.end()) ? Overlay::none : it->second;
+}
+
+// [string_view] Read the file a path resolves to: a view into an archive, or the contents of a file
+// read into buffer
+std::string_view Overlay::read(std::string_view path, std::string &buffer) const {
+	handle m = this->owner(path);
+	if (m == Overlay::none)
+		throw "MPackages::Overlay::missingFile";
+	return this->load(m, path, buffer);
+}
+
+// [string_view] Read the file of a particular mount, even if a later mount shadows it
+std::string_view Overlay::read(handle mount, std::string_view path, std::string &buffer) const {
+	this->get(mount);
+	if (!this->stored(mount, path))
+		throw "MPackages::Overlay::missingFile";
+	return this->load(mount, path, buffer);
+}
+
+// [source] Get a mount, which must not have been unmounted
+const Overlay::source &Overlay::get(handle mount) const {
+	if (mount >= this->_mounts.size() || !this->_mounts[mount])
+		throw "MPackages::Overlay::invalidMount";
+	return *this->_mounts[mount];
+}
+
+// [void] Map the archive or scan the directory of a mount. Symbolic links are not followed.
+void Overlay::open(source &s) {
+	s.archive.reset();
+	s.names.clear();
+	s.files.clear();
+
+	std::error_code ec;
+	if (fs::is_regular_file(s.path, ec)) {
+		try {
+			s.archive.reset(new Archive(s.path));
+		} catch (const char *) {
+			throw "MPackages::Overlay::invalidMount";
+		}
+
+		s.files.reserve(s.archive->size());
+		for (auto const &e: s.archive->entries())
+			s.files.push_back(e.path);
+		return;
+	}
+
+	if (!fs::is_directory(s.path, ec))
+		throw "MPackages::Overlay::invalidMount";
+
+	std::vector<std::string> paths;
+	fs::recursive_directory_iterator it(s.path, fs::directory_options::skip_permission_denied, ec), end;
+	for (; !ec && it != end; it.increment(ec))
+		if (!it->is_symlink(ec) && it->is_regular_file(ec))
+			paths.push_back(it->path().lexically_relative(s.path).generic_string());
+	std::sort(paths.begin(), paths.end());
+
+	// The paths are stored in one string, which is not resized after the views into it are taken
+	std::size_t bytes = 0;
+	for (auto const &p: paths)
+		bytes += p.size();
+	s.names.reserve(bytes);
+
+	s.files.reserve(paths.size());
+	for (auto const &p: paths) {
+		s.files.emplace_back(s.names.data() + s.names.size(), p.size());
+		s.names.append(p);
+	}
+}
+
+// [void] Add the files of a mount to the index
+void Overlay::insert(handle mount) {
+	const source &s = *this->_mounts[mount];
+	this->_index.reserve(this->_index.size() + s.files.size());
+
+	for (std::string_view path: s.files) {
+		auto it = this->_index.find(path);
+		if (it == this->_index.end()) {
+			this->_index.emplace(path, mount);
+			continue;
+		}
+
+		auto shadowed = this->_shadowed.find(path);
+		if (shadowed == this->_shadowed.end())
+			shadowed = this->_shadowed.emplace(it->first, std::vector<handle>()).first;
+
+		// Shadowed mounts are kept in load order, so the last one is uncovered first. A remounted package
+		// may lie below the mount a path resolves to.
+		std::vector<handle> &below = shadowed->second;
+		handle top = std::max(mount, it->second), under = std::min(mount, it->second);
+		below.insert(std::upper_bound(below.begin(), below.end(), under), under);
+
+		if (top != it->second) {
+			it->second = top;
+			rekey(this->_index, it, path);
+			rekey(this->_shadowed, shadowed, path);
+		}
+	}
+}
+
+// [void] Remove the files of a mount from the index
+void Overlay::erase(handle mount) {
+	for (std::string_view path: this->_mounts[mount]->files) {
+		auto it = this->_index.find(path);
+		auto shadowed = this->_shadowed.find(path);
+
+		if (it->second != mount) {
+			std::vector<handle> &below = shadowed->second;
+			below.erase(std::lower_bound(below.begin(), below.end(), mount));
+			if (below.empty())
+				this->_shadowed.erase(shadowed);
+			continue;
+		}
+
+		if (shadowed == this->_shadowed.end()) {
+			this->_index.erase(it);
+			continue;
+		}
+
+		handle next = shadowed->second.back();
+		shadowed->second.pop_back();
+		std::string_view key = *this->stored(next, path);
+
+		it->second = next;
+		rekey(this->_index, it, key);
+		if (shadowed->second.empty())
+			this->_shadowed.erase(shadowed);
+		else
+			rekey(this->_shadowed, shadowed, key);
+	}
+}
+
+// [pointer to string_view] Find a path among the files of a mount, as the mount stores it
+const std::string_view *Overlay::stored(handle mount, std::string_view path) const {
+	const source &s = *this->_mounts[mount];
+	if (s.archive) {
+		const Archive::entry *e = s.archive->find(path);
+		return e ? &e->path : nullptr;
+	}
+
+	auto it = std::lower_bound(s.files.begin(), s.files.end(), path);
+	return (it != s.files.end() && *it == path) ? &*it : nullptr;
+}
+
+// [string_view] Read a file of a mount that has it
+std::string_view Overlay::load(handle mount, std::string_view path, std::string &buffer) const {
+	const source &s = *this->_mounts[mount];
+	if (s.archive)
+		return s.archive->read(path);
+
+	std::ifstream file(fs::path(s.path) / fs::path(std::string(path)), std::ios::binary | std::ios::ate);
+	std::streamoff size = file ? static_cast<std::streamoff>(file.tellg()) : -1;
+	if (size < 0)
+		throw "MPackages::Overlay::readFailed";
+
+	buffer.resize(static_cast<std::size_t>(size));
+	file.seekg(0);
+	if (!file.read(&buffer[0], size))
+		throw "MPackages::Overlay::readFailed";
+	return buffer;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#include "package.hpp"
+#include "archive.hpp"
+
+namespace MPackages {
+
+/* Package Overlay Class */
+
+// Virtual file system layering the files of packages, mounted in load order: a path resolves to the file
+// of the last mounted package that has it, so packages see the files of the packages loaded before them
+// and can override them. Packages are directories, scanned once when mounted, or archives. Every visible
+// path is kept in one hash index, which mounting, unmounting and remounting a package update for its
+// own files only. Paths are relative to the package root, with / separators.
+class Overlay {
+	public:
+		typedef std::uint32_t handle;
+		static const handle none; // Returned by lookups that find nothing
+
+		Overlay();
+
+		Overlay(const Overlay &) = delete;
+		Overlay &operator = (const Overlay &) = delete;
+
+		handle mount(const Package &pkg); // The package directory, or an archive next to it
+		handle mount(std::string name, const std::string &path); // Directory or archive
+		void unmount(handle mount);
+		void remount(handle mount); // Scan or map again, keeping the place in the load order
+
+		std::vector<handle> mounts() const; // In load order
+		handle mounted(std::string_view name) const; // Last mount of the given package name
+		const std::string &name(handle mount) const;
+		const std::string &path(handle mount) const;
+		std::size_t files(handle mount) const;
+
+		std::size_t size() const; // Number of visible paths
+		bool exists(std::string_view path) const;
+		handle owner(std::string_view path) const; // Mount the path resolves to
+		std::string_view read(std::string_view path, std::string &buffer) const;
+		std::string_view read(handle mount, std::string_view path, std::string &buffer) const;
+	private:
+		/* Mounted Package Class */
+		class source {
+			public:
+				std::string name;
+				std::string path;
+				std::unique_ptr<Archive> archive; // Unless a directory
+				std::string names; // Paths of the files of a directory, one after another
+				std::vector<std::string_view> files; // Into names or the archive
+		};
+
+		std::vector<std::unique_ptr<source>> _mounts; // By handle, which is the load order; empty once unmounted
+		// Keys view the path as stored by the mount it resolves to
+		std::unordered_map<std::string_view, handle> _index; // Path to the mount it resolves to
+		std::unordered_map<std::string_view, std::vector<handle>> _shadowed; // Path to the other mounts having it
+
+		const source &get(handle mount) const;
+		void open(source &s);
+		void insert(handle mount);
+		void erase(handle mount);
+		const std::string_view *stored(handle mount, std::string_view path) const;
+		std::string_view load(handle mount, std::string_view path, std::string &buffer) const;
+};
+
+}
@@ -1,228 +1,443 @@
 #include "package.hpp"
+#include "manifest.hpp"
+#include "cache.hpp"
 
 using namespace MPackages;
 
+namespace {
+	// [size_t] Heap bytes of a string, zero while it fits into the string object itself
+	std::size_t heapBytes(const std::string &str) {
+		static const std::size_t inlineCapacity = std::string().capacity();
+		return (str.capacity() > inlineCapacity) ? str.capacity() + 1 : 0;
+	}
+
+	// [string_view] View of a JSON string, valid as long as the value
+	std::string_view view(const Json::Value &value) {
+		const char *begin = nullptr, *end = nullptr;
+		value.getString(&begin, &end);
+		return std::string_view(begin, end - begin);
+	}
+
+	// [string] Escape a JSON Pointer reference token
+	std::string pointerToken(std::string_view token) {
+		std::string out;
+		for (char c: token) {
+			if (c == '~')
+				out += "~0";
+			else if (c == '/')
+				out += "~1";
+			else
+				out += c;
+		}
+		return out;
+	}
+
+	// [void] Report an invalid value at /field or /field/member; throws its code unless diagnostics are collected
+	void report(std::vector<MPackages::Package::diagnostic> *out, const char *code, std::string_view field,
+			std::string_view member = std::string_view()) {
+		if (!out)
+			throw code;
+
+		std::string path = field.empty() ? std::string() : "/" + pointerToken(field); // Empty for the document
+		if (!member.empty())
+			path += "/" + pointerToken(member);
+		out->push_back({std::string(field), std::move(path), code});
+	}
+
+	// [void] Collect the dependencies of a JSON object, visited in key order
+	void collectDependencies(const Json::Value &depends, std::vector<MPackages::Dependency> &out,
+			const char *invalidDependency, const char *field, std::vector<MPackages::Package::diagnostic> *diagnostics) {
+		for (auto it = depends.begin(); it != depends.end(); it++) {
+			const char *end = nullptr;
+			const char *begin = it.memberName(&end);
+			std::string_view name(begin, end - begin);
+
+			if (it->isString() && MUtilities::Validate::dependName(name)) {
+				const char *error = nullptr;
+				std::shared_ptr<const MUtilities::Range> range = MUtilities::Range::tryIntern(view(*it), error);
+				if (range) {
+					out.emplace_back(name, *range);
+				} else {
+					// Parse again to throw the detailed error, naming the malformed comparator
+					if (!diagnostics)
+						MUtilities::Range::intern(view(*it));
+					report(diagnostics, error, field, name);
+				}
+			} else {
+				if (!it->isNull()) {
+					report(diagnostics, invalidDependency, field, name);
+				}
+			}
+		}
+	}
+
+	// [void] Destroy the objects of a slice placed into an arena
+	template<typename T> void destroy(const MUtilities::Slice<T> &slice) {
+		for (const T &item: slice)
+			const_cast<T &>(item).~T();
+	}
+}
+
+/* Dependency List Class */
+
+// [pointer to Dependency] Find a dependency by name
+const Dependency *DependencyList::find(std::string_view name) const {
+	const Dependency *it = std::lower_bound(this->begin(), this->end(), name,
+		[](const Dependency &d, std::string_view n) { return d.first < n; });
+	return (it != this->end() && it->first == name) ? it : this->end();
+}
+
+// [Range] Get the range of a dependency by name
+const MUtilities::Range &DependencyList::at(std::string_view name) const {
+	const Dependency *it = this->find(name);
+	if (it == this->end())
+		throw "MPackages::DependencyList::missingDependency";
+	return it->second;
+}
+
 /* Abstract Package Class */
 
 // [constructor] Construct from path string and Json object
-Package::Package(std::string path, Json::Value pkg) {
-	this->_path = path;
+Package::Package(std::string_view path, const Json::Value &pkg) {
+	fields &f = Package::scratch();
+	Package::check(pkg, f, nullptr);
+	this->seal(path, f);
+}
+// [constructor] Construct from path string and manifest JSON text, without building a JSON document
+Package::Package(std::string_view path, std::string_view manifest) {
+	fields &f = Package::scratch();
+	ManifestReader reader(manifest); // Owns unescaped strings until they are sealed
+	reader.read(f);
+	this->seal(path, f);
+}
+// [constructor] Construct from path string and either manifest JSON text or a manifest cache record
+Package::Package(std::string_view path, const Manifest &manifest) {
+	fields &f = Package::scratch();
+	if (manifest.format() == Manifest::Format::record) {
+		ManifestCache::decode(manifest.bytes(), f);
+		this->seal(path, f);
+	} else {
+		ManifestReader reader(manifest.bytes());
+		reader.read(f);
+		this->seal(path, f);
+	}
+}
+// [constructor] Construct from path string and the fields tryParse has checked, sealing them as they are
+Package::Package(std::string_view path, checked &&f) {
+	this->seal(path, f._fields);
+}
+// [destructor] Virtual, so derived packages can be owned through a base pointer; the arena is freed at once
+Package::~Package() {
+	destroy(this->_contributors);
+	destroy(this->_dependencies);
+	destroy(this->_optionalDependencies);
+}
+
+// [string_view] Get path
+std::string_view Package::path() const {
+	return this->_path;
+}
+// [string_view] Get name
+std::string_view Package::name() const {
+	return this->_name;
+}
+// [Version] Get version
+const MUtilities::Version &Package::version() const {
+	return this->_version;
+}
+// [string_view] Get title
+std::string_view Package::title() const {
+	return this->_title;
+}
+// [string_view] Get description
+std::string_view Package::description() const {
+	return this->_description;
+}
+// [slice of string views] Get keywords
+const MUtilities::Slice<std::string_view> &Package::keywords() const {
+	return this->_keywords;
+}
+// [string_view] Get homepage
+std::string_view Package::homepage() const {
+	return this->_homepage;
+}
+// [pair of string views] Get bug reporting information (url, email)
+std::pair<std::string_view, std::string_view> Package::bugs() const {
+	return std::pair(this->_bugsUrl, this->_bugsEmail);
+}
+// [string_view] Get license
+std::string_view Package::license() const {
+	return this->_license;
+}
+// [bool] Check if package has an author
+bool Package::hasAuthor() const {
+	return this->_author.has_value();
+}
+// [Person] Get author
+const MUtilities::Person &Package::author() const {
+	if (!this->_author)
+		throw "MPackages::Package::noAuthor";
+
+	return *this->_author;
+}
+// [slice of people] Get contributors
+const MUtilities::Slice<MUtilities::Person> &Package::contributors() const {
+	return this->_contributors;
+}
+// [string_view] Get repository
+std::string_view Package::repository() const {
+	return this->_repository;
+}
+// [DependencyList] Get dependencies
+const DependencyList &Package::dependencies() const {
+	return this->_dependencies;
+}
+// [DependencyList] Get optional dependencies
+const DependencyList &Package::optionalDependencies() const {
+	return this->_optionalDependencies;
+}
+// [bool] Check if package is private
+bool Package::isPrivate() const {
+	return this->_private;
+}
+
+// [size_t] Bytes owned by this package: the base object, its arena, and the heap storage of its version.
+// Person and range data is interned and shared between packages, so only the handles to it are counted.
+std::size_t Package::memoryUsage() const {
+	return sizeof(Package) + this->_arena.capacity() + heapBytes(this->_version.meta());
+}
+
+// [fields] Get the fields of this thread, cleared for the next package
+Package::fields &Package::scratch() {
+	thread_local fields f;
+	f.clear();
+	return f;
+}
+
+// [bool] Read and validate the fields of a manifest document. Without diagnostics, the first error is thrown;
+// with them, every error is reported and the remaining fields are still checked. True if there was no error.
+bool Package::check(const Json::Value &pkg, fields &f, std::vector<diagnostic> *diagnostics) {
+	std::size_t reported = diagnostics ? diagnostics->size() : 0;
+
+	if (!pkg.isObject()) {
+		report(diagnostics, "MPackages::Package::invalidManifest", "");
+		return false;
+	}
 
 	// Extract and validate package name (required)
-	if (pkg["name"].isString() && MUtilities::Validate::packageName(pkg["name"].asString())) {
-		this->_name = pkg["name"].asString();
+	if (pkg["name"].isString() && MUtilities::Validate::packageName(view(pkg["name"]))) {
+		f.name = view(pkg["name"]);
 	} else {
-		throw "MPackages::Package::invalidName";
+		report(diagnostics, "MPackages::Package::invalidName", "name");
 	}
 
 	// Extract version (required)
 	if (pkg["version"].isString()) {
-		this->_version = MUtilities::Version(pkg["version"].asString());
+		const char *error = nullptr;
+		std::shared_ptr<const MUtilities::Version> version = MUtilities::Version::tryIntern(view(pkg["version"]), error);
+		if (version)
+			f.version = *version;
+		else
+			report(diagnostics, error, "version");
 	} else {
-		throw "MPackages::Package::invalidVersion";
+		report(diagnostics, "MPackages::Package::invalidVersion", "version");
 	}
 
 	// Extract title
 	if (pkg["title"].isString()) {
-		this->_title = pkg["title"].asString();
+		f.title = view(pkg["title"]);
 	} else if (!pkg["title"].isNull()) {
-		throw "MPackages::Package::invalidTitle";
+		report(diagnostics, "MPackages::Package::invalidTitle", "title");
 	}
 
 	// Extract description
 	if (pkg["description"].isString()) {
-		this->_description = pkg["description"].asString();
+		f.description = view(pkg["description"]);
 	} else if (!pkg["description"].isNull()) {
-		throw "MPackages::Package::invalidDescription";
+		report(diagnostics, "MPackages::Package::invalidDescription", "description");
 	}
 
 	// Extract keywords
 	if (pkg["keywords"].isArray()) {
 		for (Json::Value::ArrayIndex i = 0; i != pkg["keywords"].size(); i++) {
 			if (pkg["keywords"][i].isString()) {
-				this->_keywords.push_back(pkg["keywords"][i].asString());
+				f.keywords.push_back(view(pkg["keywords"][i]));
 			} else {
-				throw "MPackages::Package::invalidKeyword";
+				report(diagnostics, "MPackages::Package::invalidKeyword", "keywords", std::to_string(i));
 			}
 		}
 	} else if (!pkg["keywords"].isNull()) {
-		throw "MPackages::Package::invalidKeywordList";
+		report(diagnostics, "MPackages::Package::invalidKeywordList", "keywords");
 	}
 
 	// Extract homepage
-	if (pkg["homepage"].isString() && MUtilities::Validate::url(pkg["homepage"].asString())) {
-		this->_homepage = pkg["homepage"].asString();
+	if (pkg["homepage"].isString() && MUtilities::Validate::url(view(pkg["homepage"]))) {
+		f.homepage = view(pkg["homepage"]);
 	} else {
 		if (!pkg["homepage"].isNull()) {
-			throw "MPackages::Package::invalidHomepage";
+			report(diagnostics, "MPackages::Package::invalidHomepage", "homepage");
 		}
 	}
 
 	// Extract bug reporting information
 	if (pkg["bugs"].isObject()) {
 		// Extract URL
-		if (pkg["bugs"]["url"].isString() && MUtilities::Validate::url(pkg["bugs"]["url"].asString())) {
-			this->_bugs.url = pkg["bugs"]["url"].asString();
+		if (pkg["bugs"]["url"].isString() && MUtilities::Validate::url(view(pkg["bugs"]["url"]))) {
+			f.bugsUrl = view(pkg["bugs"]["url"]);
 		} else {
-			throw "MPackages::Package::invalidBugReportUrl";
+			report(diagnostics, "MPackages::Package::invalidBugReportUrl", "bugs", "url");
 		}
 
 		// Extract email
-		if (pkg["bugs"]["email"].isString() && MUtilities::Validate::email(pkg["bugs"]["email"].asString())) {
-			this->_bugs.email = pkg["bugs"]["email"].asString();
+		if (pkg["bugs"]["email"].isString() && MUtilities::Validate::email(view(pkg["bugs"]["email"]))) {
+			f.bugsEmail = view(pkg["bugs"]["email"]);
 		} else {
-			throw "MPackages::Package::invalidBugReportemail";
+			report(diagnostics, "MPackages::Package::invalidBugReportemail", "bugs", "email");
 		}
 	} else if (!pkg["bugs"].isNull()) {
-		throw "MPackages::Package::invalidBugsInformation";
+		report(diagnostics, "MPackages::Package::invalidBugsInformation", "bugs");
 	}
 
 	// Extract license (note: validation for this field is not yet complete)
 	if (pkg["license"].isString()) {
-		this->_license = pkg["license"].asString();
+		f.license = view(pkg["license"]);
 	} else if (!pkg["license"].isNull()) {
-		throw "MPackages::Package::invalidLicense";
+		report(diagnostics, "MPackages::Package::invalidLicense", "license");
 	}
 
 	// Extract author
 	if (pkg["author"].isObject()) {
-		this->_author = new MUtilities::Person(pkg["author"]);
+		if (const char *error = MUtilities::Person::parse(pkg["author"], f.author))
+			report(diagnostics, error, "author");
 	} else if (pkg["author"].isString()) {
-		this->_author = new MUtilities::Person(pkg["author"].asString());
+		if (const char *error = MUtilities::Person::parse(view(pkg["author"]), f.author))
+			report(diagnostics, error, "author");
 	} else if (!pkg["author"].isNull()) {
-		throw "MPackages::Package::invalidAuthor";
+		report(diagnostics, "MPackages::Package::invalidAuthor", "author");
 	}
 
 	// Extract contributors
 	if (pkg["contributors"].isArray()) {
+		std::optional<MUtilities::Person> contributor;
 		for (Json::Value::ArrayIndex i = 0; i != pkg["contributors"].size(); i++) {
-			if (pkg["contributors"][i].isObject()) {
-				this->_contributors.push_back(MUtilities::Person(pkg["contributors"][i]));
-			} else if (pkg["contributors"][i].isString()) {
-				this->_contributors.push_back(MUtilities::Person(pkg["contributors"][i].asString()));
-			} else {
-				throw "MPackages::Package::invalidContributor";
-			}
+			const Json::Value &c = pkg["contributors"][i];
+			const char *error = "MPackages::Package::invalidContributor";
+
+			if (c.isObject())
+				error = MUtilities::Person::parse(c, contributor);
+			else if (c.isString())
+				error = MUtilities::Person::parse(view(c), contributor);
+
+			if (error)
+				report(diagnostics, error, "contributors", std::to_string(i));
+			else
+				f.contributors.push_back(std::move(*contributor));
 		}
 	} else if (!pkg["contributors"].isNull()) {
-		throw "MPackages::Package::invalidContributorList";
+		report(diagnostics, "MPackages::Package::invalidContributorList", "contributors");
 	}
 
 	// Extract repository
-	if (pkg["repository"].isString() && MUtilities::Validate::url(pkg["repository"].asString()) &&
-			MUtilities::Utility::hasSuffix(pkg["repository"].asString(), ".git")) {
-		this->_repository = pkg["repository"].asString();
+	if (pkg["repository"].isString() && MUtilities::Validate::url(view(pkg["repository"])) &&
+			MUtilities::Utility::hasSuffix(view(pkg["repository"]), ".git")) {
+		f.repository = view(pkg["repository"]);
 	} else {
 		if (!pkg["repository"].isNull()) {
-			throw "MPackages::Package::invalidRepository";
+			report(diagnostics, "MPackages::Package::invalidRepository", "repository");
 		}
 	}
 
 	// Extract dependencies
 	if (pkg["dependencies"].isObject() && pkg["dependencies"].size() > 0) {
-		Json::Value depends = pkg["dependencies"];
-		for (auto name: depends.getMemberNames()) {
-			Json::Value depend = depends[name];
-
-			if (depend.isString() && MUtilities::Validate::dependName(name)) {
-				this->_dependencies.insert(std::pair(name, MUtilities::Range(depend.asString())));
-			} else {
-				if (!depend.isNull()) {
-					throw "MPackages::Package::invalidDependency";
-				}
-			}
-		}
+		collectDependencies(pkg["dependencies"], f.dependencies, "MPackages::Package::invalidDependency",
+			"dependencies", diagnostics);
 	} else if (!pkg["dependencies"].isNull()) {
-		throw "MPackages::Package::invalidDependencyList";
+		report(diagnostics, "MPackages::Package::invalidDependencyList", "dependencies");
 	}
 
 	// Extract optional dependencies
 	if (pkg["optionalDependencies"].isObject() && pkg["optionalDependencies"].size() > 0) {
-		Json::Value depends = pkg["optionalDependencies"];
-		for (auto name: depends.getMemberNames()) {
-			Json::Value depend = depends[name];
-
-			if (depend.isString() && MUtilities::Validate::dependName(name)) {
-				this->_optionalDependencies.insert(std::pair(name, MUtilities::Range(depend.asString())));
-			} else {
-				if (!depend.isNull()) {
-					throw "MPackages::Package::invalidOptionalDependency";
-				}
-			}
-		}
+		collectDependencies(pkg["optionalDependencies"], f.optionalDependencies,
+			"MPackages::Package::invalidOptionalDependency", "optionalDependencies", diagnostics);
 	} else if (!pkg["optionalDependencies"].isNull()) {
-		throw "MPackages::Package::invalidOptionalDependencyList";
+		report(diagnostics, "MPackages::Package::invalidOptionalDependencyList", "optionalDependencies");
 	}
 
 	// Extract whether package is private
 	if (pkg["private"].isBool()) {
-		this->_private = pkg["private"].asBool();
+		f.isPrivate = pkg["private"].asBool();
 	} else if (!pkg["private"].isNull()) {
-		throw "MPackages::Package::invalidPrivateStatus";
+		report(diagnostics, "MPackages::Package::invalidPrivateStatus", "private");
 	}
-}
-// [destructor] Delete pointers
-Package::~Package() {
-	delete this->_author;
-}
 
-// [string] Get path
-std::string Package::path() const {
-	return this->_path;
-}
-// [string] Get name
-std::string Package::name() const {
-	return this->_name;
-}
-// [Version] Get version
-MUtilities::Version Package::version() const {
-	return this->_version;
+	return !diagnostics || diagnostics->size() == reported;
 }
-// [string] Get title
-std::string Package::title() const {
-	return this->_title;
-}
-// [string] Get description
-std::string Package::description() const {
-	return this->_description;
-}
-// [vector of strings] Get keywords
-std::vector<std::string> Package::keywords() const {
-	return this->_keywords;
-}
-// [string] Get homepage
-std::string Package::homepage() const {
-	return this->_homepage;
-}
-// [pair of strings] Get bug reporting information
-std::pair<std::string, std::string> Package::bugs() const {
-	return std::pair(this->_bugs.url, this->_bugs.email);
-}
-// [string] Get license
-std::string Package::license() const {
-	return this->_license;
-}
-// [Person] Get author
-MUtilities::Person Package::author() const {
-	return *this->_author;
-}
-// [vector of people] Get contributors
-std::vector<MUtilities::Person> Package::contributors() const {
-	return this->_contributors;
-}
-// [string] Get repository
-std::string Package::repository() const {
-	return this->_repository;
-}
-// [map of strings to Ranges] Get dependencies
-std::map<std::string, MUtilities::Range> Package::dependencies() const {
-	return this->_dependencies;
-}
-// [map of strings to Ranges] Get optional dependencies
-std::map<std::string, MUtilities::Range> Package::optionalDependencies() const {
-	return this->_optionalDependencies;
+
+// [void] Copy the fields into an arena of exactly the size they need, and take it
+void Package::seal(std::string_view path, fields &f) {
+	std::size_t bytes = f.keywords.size() * sizeof(std::string_view) +
+		f.contributors.size() * sizeof(MUtilities::Person) +
+		(f.dependencies.size() + f.optionalDependencies.size()) * sizeof(Dependency);
+
+	// Lists come first, so that no padding is needed between them and the characters after them
+	for (std::string_view str: {path, f.name, f.title, f.description, f.homepage, f.bugsEmail, f.bugsUrl, f.license,
+			f.repository})
+		bytes += str.size();
+	for (std::string_view k: f.keywords)
+		bytes += k.size();
+	for (auto const *list: {&f.dependencies, &f.optionalDependencies})
+		for (auto const &d: *list)
+			bytes += d.first.size();
+
+	MUtilities::Arena arena(bytes);
+	std::string_view *keywords = arena.allocate<std::string_view>(f.keywords.size());
+	MUtilities::Person *contributors = arena.allocate<MUtilities::Person>(f.contributors.size());
+	Dependency *dependencies = arena.allocate<Dependency>(f.dependencies.size());
+	Dependency *optionalDependencies = arena.allocate<Dependency>(f.optionalDependencies.size());
+
+	for (std::size_t i = 0; i < f.keywords.size(); i++)
+		new (&keywords[i]) std::string_view(arena.copy(f.keywords[i]));
+	for (std::size_t i = 0; i < f.contributors.size(); i++)
+		new (&contributors[i]) MUtilities::Person(std::move(f.contributors[i]));
+	for (std::size_t i = 0; i < f.dependencies.size(); i++)
+		new (&dependencies[i]) Dependency(arena.copy(f.dependencies[i].first), std::move(f.dependencies[i].second));
+	for (std::size_t i = 0; i < f.optionalDependencies.size(); i++)
+		new (&optionalDependencies[i]) Dependency(arena.copy(f.optionalDependencies[i].first),
+			std::move(f.optionalDependencies[i].second));
+
+	this->_keywords = MUtilities::Slice<std::string_view>(keywords, f.keywords.size());
+	this->_contributors = MUtilities::Slice<MUtilities::Person>(contributors, f.contributors.size());
+	this->_dependencies = DependencyList(dependencies, f.dependencies.size());
+	this->_optionalDependencies = DependencyList(optionalDependencies, f.optionalDependencies.size());
+
+	this->_path = arena.copy(path);
+	this->_name = arena.copy(f.name);
+	this->_version = std::move(f.version);
+	this->_title = arena.copy(f.title);
+	this->_description = arena.copy(f.description);
+	this->_homepage = arena.copy(f.homepage);
+	this->_bugsEmail = arena.copy(f.bugsEmail);
+	this->_bugsUrl = arena.copy(f.bugsUrl);
+	this->_license = arena.copy(f.license);
+	this->_author = std::move(f.author);
+	this->_repository = arena.copy(f.repository);
+	this->_private = f.isPrivate;
+
+	this->_arena = std::move(arena);
+	f.clear();
 }
-// [bool] Check if package is private
-bool Package::isPrivate() const {
-	return this->_private;
+
+/* Manifest Fields Class */
+
+// [void] Reset every field, keeping the capacity of the lists
+void Package::fields::clear() {
+	this->name = this->title = this->description = this->homepage = std::string_view();
+	this->bugsEmail = this->bugsUrl = this->license = this->repository = std::string_view();
+	this->version = MUtilities::Version();
+	this->keywords.clear();
+	this->author.reset();
+	this->contributors.clear();
+	this->dependencies.clear();
+	this->optionalDependencies.clear();
+	this->isPrivate = false;
 }
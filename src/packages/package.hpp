@@ -4,8 +4,12 @@
 #include <vector>
 #include <utility>
 #include <map>
+#include <optional>
+#include <memory>
+#include <string_view>
 #include <json/json.h>
 
+#include "../utilities/arena.hpp"
 #include "../utilities/person.hpp"
 #include "../utilities/range.hpp"
 #include "../utilities/version.hpp"
@@ -13,54 +17,150 @@
 
 namespace MPackages {
 
+class Manifest;
+class ManifestReader;
+class ManifestCache;
+
+// Dependency name, including its type prefix, and range
+typedef std::pair<std::string_view, MUtilities::Range> Dependency;
+
+/* Dependency List Class */
+
+// Dependencies of a package, sorted by name
+class DependencyList: public MUtilities::Slice<Dependency> {
+	public:
+		using MUtilities::Slice<Dependency>::Slice;
+
+		const Dependency *find(std::string_view name) const; // end() if there is none
+		const MUtilities::Range &at(std::string_view name) const;
+};
+
+// Every string and list of a package lives in one arena, sized to fit and freed at once with the package
 class Package {
 	public:
-		Package(std::string path, Json::Value pkg);
-		~Package();
-
-		// Getters
-		std::string path() const;
-		std::string name() const;
-		MUtilities::Version version() const;
-		std::string title() const;
-		std::string description() const;
-		std::vector<std::string> keywords() const;
-		std::string homepage() const;
-		std::pair<std::string, std::string> bugs() const;
-		std::string license() const;
-		MUtilities::Person author() const;
-		std::vector<MUtilities::Person> contributors() const;
-		std::string repository() const;
-		std::map<std::string, MUtilities::Range> dependencies() const;
-		std::map<std::string, MUtilities::Range> optionalDependencies() const;
+		/* Manifest Diagnostic Class */
+		class diagnostic {
+			public:
+				std::string field; // Top-level manifest field, empty for the document itself
+				std::string path; // JSON Pointer to the invalid value, e.g. "/contributors/2"
+				const char *code; // What the constructor throws for it, e.g. "MPackages::Package::invalidContributor"
+		};
+
+		/* Parse Result Class */
+		template<typename T> class parsed {
+			public:
+				std::unique_ptr<T> package; // Null if the manifest is invalid
+				std::vector<diagnostic> diagnostics; // Every error of the manifest, in field order
+		};
+
+		Package(std::string_view path, const Json::Value &pkg); // Throws invalidManifest unless pkg is an object
+		Package(std::string_view path, std::string_view manifest); // Streamed from manifest bytes
+		Package(std::string_view path, const Manifest &manifest); // From manifest bytes or a cache record
+		virtual ~Package();
+
+		Package(const Package &) = delete;
+		Package &operator = (const Package &) = delete;
+
+		// Getters (views and references stay valid for the lifetime of the package)
+		std::string_view path() const;
+		std::string_view name() const;
+		const MUtilities::Version &version() const;
+		std::string_view title() const;
+		std::string_view description() const;
+		const MUtilities::Slice<std::string_view> &keywords() const;
+		std::string_view homepage() const;
+		std::pair<std::string_view, std::string_view> bugs() const;
+		std::string_view license() const;
+		bool hasAuthor() const;
+		const MUtilities::Person &author() const;
+		const MUtilities::Slice<MUtilities::Person> &contributors() const;
+		std::string_view repository() const;
+		const DependencyList &dependencies() const;
+		const DependencyList &optionalDependencies() const;
 		bool isPrivate() const;
 
+		std::size_t memoryUsage() const; // Bytes owned by this package, see package.cpp
+
 		virtual bool run() = 0;
+
+		/* Checked Fields Class */
+		class checked;
+
+		// [parsed] Construct a package of type T from a manifest document, or report every error in it instead of
+		// throwing. T is constructed from (std::string path, Package::checked &&fields) and passes the fields on
+		// to the protected Package constructor, which uses them as they are, without validating them again.
+		template<typename T> static parsed<T> tryParse(std::string_view path, const Json::Value &pkg) {
+			parsed<T> out;
+			fields &f = Package::scratch();
+			if (Package::check(pkg, f, &out.diagnostics))
+				out.package.reset(new T(std::string(path), checked(f)));
+			return out;
+		}
+	protected:
+		Package(std::string_view path, checked &&fields); // From the fields tryParse has checked
 	private:
-		// [nested class] Bugs
-		class Bugs {
+		friend class ManifestReader;
+		friend class ManifestCache;
+
+		/* Manifest Fields Class */
+
+		// Fields as the constructors read them, viewing the manifest, document or record until they are
+		// copied into the arena; one instance per thread is reused, so reading allocates little
+		class fields {
 			public:
-				std::string email;
-				std::string url;
+				std::string_view name;
+				MUtilities::Version version;
+				std::string_view title;
+				std::string_view description;
+				std::vector<std::string_view> keywords;
+				std::string_view homepage;
+				std::string_view bugsEmail;
+				std::string_view bugsUrl;
+				std::string_view license;
+				std::optional<MUtilities::Person> author;
+				std::vector<MUtilities::Person> contributors;
+				std::string_view repository;
+				std::vector<Dependency> dependencies; // Sorted by name
+				std::vector<Dependency> optionalDependencies; // Sorted by name
+				bool isPrivate = false;
+
+				void clear();
 		};
 
-		std::string _path;
-		std::string _name; // Package name must be validated
+		MUtilities::Arena _arena;
+		std::string_view _path;
+		std::string_view _name; // Package name must be validated
 		MUtilities::Version _version;
-		std::string _title;
-		std::string _description;
-		std::vector<std::string> _keywords;
-		std::string _homepage; // URL must be validated
-		Bugs _bugs; // Email and URL must be validated
-		std::string _license;
-		MUtilities::Person *_author = nullptr;
-		std::vector<MUtilities::Person> _contributors;
-		std::string _repository; // URL must be validated and end with .git
-		std::map<std::string, MUtilities::Range> _dependencies; // Dependency names must be validated
-		std::map<std::string, MUtilities::Range> _optionalDependencies; // Dependency names must be validated
-		bool _private;
-
-		void init(Json::Value pkg);
+		std::string_view _title;
+		std::string_view _description;
+		MUtilities::Slice<std::string_view> _keywords;
+		std::string_view _homepage; // URL must be validated
+		std::string_view _bugsEmail; // Must be validated
+		std::string_view _bugsUrl; // Must be validated
+		std::string_view _license;
+		std::optional<MUtilities::Person> _author;
+		MUtilities::Slice<MUtilities::Person> _contributors;
+		std::string_view _repository; // URL must be validated and end with .git
+		DependencyList _dependencies; // Dependency names must be validated
+		DependencyList _optionalDependencies; // Dependency names must be validated
+		bool _private = false;
+
+		static fields &scratch();
+		static bool check(const Json::Value &pkg, fields &f, std::vector<diagnostic> *diagnostics);
+		void seal(std::string_view path, fields &f);
+};
+
+// Fields of a manifest document tryParse has validated, viewing the document; only tryParse can create them
+class Package::checked {
+	public:
+		checked(const checked &) = delete;
+		checked &operator = (const checked &) = delete;
+	private:
+		friend class Package;
+
+		explicit checked(fields &f): _fields(f) {}
+
+		fields &_fields;
 };
 
 }
@@ -0,0 +1,187 @@
+#include "registry.hpp"
+
+using namespace MPackages;
+
+/* Package Registry Class */
+
+const Registry::id Registry::none = static_cast<Registry::id>(-1);
+
+// [double] Get index bytes per package
+double Registry::memory::perPackage() const {
+	return (this->count == 0) ? 0.0 : static_cast<double>(this->index) / this->count;
+}
+
+// [constructor] Empty registry
+Registry::Registry() {}
+// [constructor] From loaded packages, e.g. Loader::result::packages
+Registry::Registry(std::vector<std::unique_ptr<Package>> packages) {
+	this->_packages.reserve(packages.size());
+	for (auto &p: packages)
+		this->add(std::move(p));
+}
+
+// [id] Take ownership of a package; a package of the same name and version may only be added once
+Registry::id Registry::add(std::unique_ptr<Package> pkg) {
+	if (this->_packages.size() >= Registry::none)
+		throw "MPackages::Registry::full";
+
+	auto found = this->_names.find(pkg->name());
+	if (found == this->_names.end()) {
+		// The key views the name owned by the package, which never moves
+		found = this->_names.emplace(pkg->name(), static_cast<std::uint32_t>(this->_entries.size())).first;
+		this->_entries.emplace_back();
+	}
+
+	entry &e = this->_entries[found->second];
+	if (!e.versions.insert(pkg->version()))
+		throw "MPackages::Registry::duplicatePackage";
+
+	id i = static_cast<id>(this->_packages.size());
+	const std::vector<MUtilities::Version> &versions = e.versions.versions();
+	std::size_t at = std::lower_bound(versions.begin(), versions.end(), pkg->version()) - versions.begin();
+	e.packages.insert(e.packages.begin() + at, i);
+
+	this->_packages.push_back(std::move(pkg));
+	return i;
+}
+
+// [void] Replace a package, keeping its id; the replacement must have the same name, but may change version
+void Registry::replace(id pkg, std::unique_ptr<Package> replacement) {
+	if (pkg >= this->_packages.size())
+		throw "MPackages::Registry::invalidId";
+
+	const Package &old = *this->_packages[pkg];
+	if (replacement->name() != old.name())
+		throw "MPackages::Registry::renamedPackage";
+
+	auto found = this->_names.find(old.name());
+	entry &e = this->_entries[found->second];
+
+	if (replacement->version() != old.version()) {
+		if (!e.versions.insert(replacement->version()))
+			throw "MPackages::Registry::duplicatePackage";
+		e.versions.erase(old.version());
+		e.packages.erase(std::find(e.packages.begin(), e.packages.end(), pkg));
+
+		const std::vector<MUtilities::Version> &versions = e.versions.versions();
+		std::size_t at = std::lower_bound(versions.begin(), versions.end(), replacement->version()) - versions.begin();
+		e.packages.insert(e.packages.begin() + at, pkg);
+	}
+
+	// The key may view the name owned by the old package
+	if (found->first.data() == old.name().data()) {
+		std::uint32_t position = found->second;
+		this->_names.erase(found);
+		this->_names.emplace(replacement->name(), position);
+	}
+
+	std::atomic_store(&this->_packages[pkg], std::shared_ptr<Package>(std::move(replacement)));
+}
+
+// [size_t] Get number of packages
+std::size_t Registry::size() const {
+	return this->_packages.size();
+}
+// [size_t] Get number of distinct package names
+std::size_t Registry::nameCount() const {
+	return this->_entries.size();
+}
+
+// [Package] Get a package by id
+const Package &Registry::get(id pkg) const {
+	if (pkg >= this->_packages.size())
+		throw "MPackages::Registry::invalidId";
+	return *this->_packages[pkg];
+}
+Package &Registry::get(id pkg) {
+	if (pkg >= this->_packages.size())
+		throw "MPackages::Registry::invalidId";
+	return *this->_packages[pkg];
+}
+
+// [shared_ptr of Package] Get a package by id, safe to call while another thread replaces it
+std::shared_ptr<const Package> Registry::share(id pkg) const {
+	if (pkg >= this->_packages.size())
+		throw "MPackages::Registry::invalidId";
+	return std::atomic_load(&this->_packages[pkg]);
+}
+
+// [id] Get the package of the given name and version, or none
+Registry::id Registry::find(std::string_view name, const MUtilities::Version &version) const {
+	const entry *e = this->lookup(name);
+	if (!e)
+		return Registry::none;
+
+	const std::vector<MUtilities::Version> &versions = e->versions.versions();
+	auto it = std::lower_bound(versions.begin(), versions.end(), version);
+	if (it == versions.end() || *it != version)
+		return Registry::none;
+
+	return e->packages[it - versions.begin()];
+}
+
+// [id] Get the package of the given name with the highest version satisfying the range, or none
+Registry::id Registry::maxSatisfying(std::string_view name, const MUtilities::Range &range) const {
+	const entry *e = this->lookup(name);
+	return e ? this->position(*e, e->versions.maxSatisfying(range)) : Registry::none;
+}
+
+// [vector of ids] Get the packages of the given name satisfying the range, in ascending precedence
+std::vector<Registry::id> Registry::allSatisfying(std::string_view name, const MUtilities::Range &range) const {
+	std::vector<id> out;
+	const entry *e = this->lookup(name);
+	if (!e)
+		return out;
+
+	for (const MUtilities::Version *v: e->versions.allSatisfying(range))
+		out.push_back(this->position(*e, v));
+	return out;
+}
+
+// [vector of ids] Get every package of the given name, in ascending precedence
+const std::vector<Registry::id> &Registry::versions(std::string_view name) const {
+	static const std::vector<id> empty;
+	const entry *e = this->lookup(name);
+	return e ? e->packages : empty;
+}
+
+// [memory] Measure the bytes held by the packages and by the registry itself
+Registry::memory Registry::memoryUsage() const {
+	memory out;
+	out.count = this->_packages.size();
+
+	for (auto const &p: this->_packages)
+		out.packages += p->memoryUsage();
+
+	out.index = sizeof(Registry) + this->_packages.capacity() * sizeof(std::shared_ptr<Package>) +
+		this->_entries.capacity() * sizeof(entry);
+	for (auto const &e: this->_entries) {
+		out.index += e.versions.versions().capacity() * (sizeof(MUtilities::Version) + sizeof(std::uint64_t));
+		out.index += e.packages.capacity() * sizeof(id);
+	}
+
+	// Hash nodes hold the value, a link and the cached hash code
+	out.index += this->_names.bucket_count() * sizeof(void *) +
+		this->_names.size() * (sizeof(std::pair<const std::string_view, std::uint32_t>) + 2 * sizeof(void *));
+
+	return out;
+}
+
+// [string_view] Get the package name of a dependency key, or the name itself if it has no type prefix
+std::string_view Registry::packageName(std::string_view name) {
+	std::size_t colon = name.find(':');
+	return (colon == std::string_view::npos) ? name : name.substr(colon + 1);
+}
+
+// [entry] Find the entry of a name, or nullptr
+const Registry::entry *Registry::lookup(std::string_view name) const {
+	auto it = this->_names.find(Registry::packageName(name));
+	return (it == this->_names.end()) ? nullptr : &this->_entries[it->second];
+}
+
+// [id] Get the package of a version held by an entry, or none for nullptr
+Registry::id Registry::position(const entry &e, const MUtilities::Version *version) const {
+	if (!version)
+		return Registry::none;
+	return e.packages[version - e.versions.versions().data()];
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+#include "package.hpp"
+#include "../utilities/versionindex.hpp"
+
+namespace MPackages {
+
+/* Package Registry Class */
+
+// Owns loaded packages and indexes them by name into sorted version lists. Packages are addressed by
+// dense ids in insertion order, and stay at the same address until they are replaced.
+// Names may be given bare or as dependency keys ("collection:foo"), whose type prefix is ignored.
+// Replacing a package swaps it atomically for readers holding it through share, which may run on other
+// threads; every other call must not run concurrently with add or replace.
+class Registry {
+	public:
+		typedef std::uint32_t id;
+		static const id none; // Returned by lookups that find nothing
+
+		/* Memory Usage Class */
+		class memory {
+			public:
+				std::size_t packages = 0; // Sum of Package::memoryUsage
+				std::size_t index = 0; // Package table, name lookup and version lists
+				std::size_t count = 0; // Number of packages
+
+				double perPackage() const; // Index bytes per package
+		};
+
+		Registry();
+		Registry(std::vector<std::unique_ptr<Package>> packages);
+
+		Registry(const Registry &) = delete;
+		Registry &operator = (const Registry &) = delete;
+
+		id add(std::unique_ptr<Package> pkg);
+		void replace(id pkg, std::unique_ptr<Package> replacement); // E.g. after its manifest changed
+
+		std::size_t size() const;
+		std::size_t nameCount() const;
+		const Package &get(id pkg) const;
+		Package &get(id pkg);
+		std::shared_ptr<const Package> share(id pkg) const; // Kept alive by the caller across a replace
+
+		id find(std::string_view name, const MUtilities::Version &version) const;
+		id maxSatisfying(std::string_view name, const MUtilities::Range &range) const;
+		std::vector<id> allSatisfying(std::string_view name, const MUtilities::Range &range) const;
+		const std::vector<id> &versions(std::string_view name) const; // Ascending precedence
+
+		memory memoryUsage() const;
+
+		static std::string_view packageName(std::string_view name);
+	private:
+		/* Name Entry Class */
+		class entry {
+			public:
+				MUtilities::VersionIndex versions;
+				std::vector<id> packages; // Parallel to versions.versions()
+		};
+
+		std::vector<std::shared_ptr<Package>> _packages;
+		std::vector<entry> _entries;
+		std::unordered_map<std::string_view, std::uint32_t> _names; // Views of package names, into _entries
+
+		const entry *lookup(std::string_view name) const;
+		id position(const entry &e, const MUtilities::Version *version) const;
+};
+
+}
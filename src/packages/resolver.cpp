@@ -0,0 +1,989 @@
+#include "resolver.hpp"
+
+using namespace MPackages;
+
+namespace {
+	// [Range] Versions from lower to upper, both inclusive
+	MUtilities::Range between(const MUtilities::Version &lower, const MUtilities::Version &upper) {
+		MUtilities::Range::interval iv;
+		iv.hasLower = iv.hasUpper = true;
+		iv.lowerInclusive = iv.upperInclusive = true;
+		iv.lower = lower;
+		iv.upper = upper;
+		return MUtilities::Range(std::vector<MUtilities::Range::interval>{iv});
+	}
+}
+
+/* Dependency Resolver Class */
+
+const Resolver::index Resolver::none = static_cast<Resolver::index>(-1);
+const Resolver::index Resolver::root = 0;
+
+// [constructor] Resolve against the packages of a registry, which must outlive the resolver
+Resolver::Resolver(const Registry &registry) : _registry(registry) {}
+
+// [result] Choose packages meeting the requirements, a map of package names to ranges
+Resolver::result Resolver::resolve(const std::map<std::string, MUtilities::Range> &requirements) {
+	this->reset();
+	this->_requirements = requirements;
+	this->_resolved = true;
+	this->_incremental = false;
+	this->require(requirements);
+	return this->solve();
+}
+// [result] Choose the root package and packages meeting its dependencies
+Resolver::result Resolver::resolve(Registry::id root) {
+	const Package &pkg = this->_registry.get(root);
+	return this->resolve({{std::string(pkg.name()), between(pkg.version(), pkg.version())}});
+}
+
+// [result] Resolve the last requirements again after the given packages were replaced in or added to the
+// registry. If the last solution still holds it is kept, less what is no longer required. Otherwise the
+// packages around the broken ranges are re-solved, every other package keeping its version; only if that
+// fails is everything searched again, forgetting just what was learned from the changed packages and
+// preferring the versions chosen before.
+Resolver::result Resolver::update(const std::vector<Registry::id> &changed) {
+	if (!this->_resolved)
+		throw "MPackages::Resolver::notResolved";
+	for (Registry::id c: changed)
+		this->_registry.get(c);
+
+	this->_result = result();
+	this->_incremental = true;
+	this->_changed.insert(this->_changed.end(), changed.begin(), changed.end());
+	this->_stale.insert(this->_stale.end(), changed.begin(), changed.end());
+
+	if (!this->_order.empty()) {
+		std::vector<bool> touched(this->_registry.size(), false);
+		for (Registry::id c: this->_changed)
+			touched[c] = true;
+
+		std::vector<bool> reached;
+		std::vector<index> broken;
+		if (this->check(this->_previous, touched, reached, broken)) {
+			this->accept(this->_previous, reached);
+			return this->_result;
+		}
+		if (this->repair(broken, touched))
+			return this->_result;
+	}
+
+	this->forget();
+	return this->solve();
+}
+
+// [void] Forget the state of the last search; package names keep their index, so solutions can be compared
+void Resolver::reset() {
+	for (auto &pkg: this->_packages) {
+		pkg.incompatibilities.clear();
+		pkg.assignments.clear();
+		pkg.decision = Registry::none;
+		pkg.decided = false;
+	}
+	if (this->_packages.empty()) {
+		this->_packages.emplace_back();
+		this->_packages[Resolver::root].name = "root";
+	}
+
+	this->_incompatibilities.clear();
+	this->_solution.clear();
+	this->_expanded.assign(this->_registry.size(), false);
+	this->_queue.clear();
+	this->_level = 0;
+	this->_result = result();
+	this->_stale.clear();
+}
+
+// [void] Add the requirements as the dependencies of a root package that must be chosen
+void Resolver::require(const std::map<std::string, MUtilities::Range> &requirements) {
+	this->add({{{Resolver::root, false, MUtilities::Range::all()}}, Cause::root});
+	for (auto const &r: requirements) {
+		index dep = this->lookup(r.first);
+		this->add({{{Resolver::root, true, MUtilities::Range::all()}, {dep, false, r.second}}, Cause::dependency});
+	}
+}
+
+// [bool] Decide and propagate until every required package is chosen; false, with the result explaining
+// why, if there is no solution
+bool Resolver::search() {
+	index failure = Resolver::none;
+	for (index next = Resolver::root; next != Resolver::none; next = this->decide()) {
+		if (!this->propagate(next, failure)) {
+			this->_result.explanation = this->explain(failure);
+			return false;
+		}
+	}
+	return true;
+}
+
+// [result] Search, and take the packages decided on as the solution
+Resolver::result Resolver::solve() {
+	if (!this->search())
+		return this->_result;
+
+	std::vector<Registry::id> chosen(this->_packages.size(), Registry::none);
+	std::vector<index> order;
+	for (index p = 1; p < this->_packages.size(); p++) {
+		if (this->_packages[p].decided) {
+			chosen[p] = this->_packages[p].decision;
+			order.push_back(p);
+		}
+	}
+
+	std::sort(order.begin(), order.end(), [this](index a, index b) {
+		return this->_packages[a].name < this->_packages[b].name;
+	});
+
+	this->finish(std::move(chosen), std::move(order));
+	return this->_result;
+}
+
+// [void] Take a solution (chosen packages by package, and those packages sorted by name) as the result,
+// compare it to the last one, and keep it and its dependency edges for the next update
+void Resolver::finish(std::vector<Registry::id> chosen, std::vector<index> order) {
+	std::vector<bool> touched(this->_registry.size(), false);
+	for (Registry::id c: this->_changed)
+		touched[c] = true;
+
+	std::vector<std::pair<index, swap>> delta;
+	for (index p = 1; p < std::max(chosen.size(), this->_previous.size()); p++) {
+		Registry::id from = (p < this->_previous.size()) ? this->_previous[p] : Registry::none;
+		Registry::id to = (p < chosen.size()) ? chosen[p] : Registry::none;
+		if (from != to)
+			delta.push_back({p, {from, to}});
+	}
+
+	std::sort(delta.begin(), delta.end(), [this](const std::pair<index, swap> &a, const std::pair<index, swap> &b) {
+		return this->_packages[a.first].name < this->_packages[b.first].name;
+	});
+	for (auto const &d: delta)
+		this->_result.delta.push_back(d.second);
+
+	this->_result.packages.clear();
+	for (index p: order)
+		this->_result.packages.push_back(chosen[p]);
+	this->_result.solved = true;
+
+	// Unless resolving from scratch, only packages that are newly chosen or have changed need their edges read
+	for (index p: order) {
+		if (this->_incremental && p < this->_previous.size() && this->_previous[p] == chosen[p] && !touched[chosen[p]])
+			continue;
+
+		std::vector<index> edges[2];
+		const Package &pkg = this->_registry.get(chosen[p]);
+		for (bool optional: {false, true})
+			for (auto const &d: optional ? pkg.optionalDependencies() : pkg.dependencies())
+				edges[optional].push_back(this->lookup(d.first));
+
+		this->_edges.resize(this->_packages.size());
+		this->_edges[p] = std::move(edges[0]);
+		this->_optional.resize(this->_packages.size());
+		this->_optional[p] = std::move(edges[1]);
+	}
+
+	chosen.resize(this->_packages.size(), Registry::none);
+	this->_edges.resize(this->_packages.size());
+	this->_optional.resize(this->_packages.size());
+	this->_previous = std::move(chosen);
+	this->_order = std::move(order);
+	this->_changed.clear();
+}
+
+// [void] Take the packages of a checked solution that are still required as the result
+void Resolver::accept(const std::vector<Registry::id> &chosen, const std::vector<bool> &reached) {
+	std::vector<Registry::id> kept(chosen.size(), Registry::none);
+	std::vector<index> order, added;
+
+	for (index p: this->_order) {
+		if (p < reached.size() && reached[p] && chosen[p] != Registry::none) {
+			kept[p] = chosen[p];
+			order.push_back(p);
+		}
+	}
+
+	// Packages not chosen before are merged in by name
+	for (index p = 1; p < chosen.size(); p++) {
+		if (chosen[p] != Registry::none && p < reached.size() && reached[p] &&
+				(p >= this->_previous.size() || this->_previous[p] == Registry::none)) {
+			kept[p] = chosen[p];
+			added.push_back(p);
+		}
+	}
+
+	auto byName = [this](index a, index b) {
+		return this->_packages[a].name < this->_packages[b].name;
+	};
+	std::sort(added.begin(), added.end(), byName);
+
+	std::vector<index> merged;
+	std::merge(order.begin(), order.end(), added.begin(), added.end(), std::back_inserter(merged), byName);
+	this->finish(std::move(kept), std::move(merged));
+}
+
+// [bool] Walk a solution (chosen packages by package) from the requirements, checking the ranges from and
+// to touched packages; the edges of the last solution are trusted for every other package. Packages
+// reached are marked, and packages whose range is broken, or that are required but not chosen, collected.
+bool Resolver::check(const std::vector<Registry::id> &chosen, const std::vector<bool> &touched, std::vector<bool> &reached,
+		std::vector<index> &broken) {
+	reached.assign(chosen.size(), false);
+	broken.clear();
+
+	auto selected = [&chosen](index q) {
+		return (q < chosen.size()) ? chosen[q] : Registry::none;
+	};
+	auto satisfied = [&](index q, const MUtilities::Range &range) {
+		Registry::id id = selected(q);
+		return id != Registry::none && range.satisfiedBy(this->_registry.get(id).version());
+	};
+
+	// The dependencies of a package, read again if it or one of them changed; broken ones are collected
+	auto dependencies = [&](index p, bool optional, std::vector<index> &out) {
+		Registry::id id = chosen[p];
+		if (!touched[id] && p < this->_edges.size()) {
+			const std::vector<index> &edges = optional ? this->_optional[p] : this->_edges[p];
+			if (std::none_of(edges.begin(), edges.end(), [&](index q) {
+				return selected(q) != Registry::none && touched[selected(q)];
+			})) {
+				out = edges;
+				return;
+			}
+		}
+
+		out.clear();
+		const Package &pkg = this->_registry.get(id);
+		for (auto const &d: optional ? pkg.optionalDependencies() : pkg.dependencies()) {
+			index q = this->lookup(d.first);
+			out.push_back(q);
+
+			// An optional dependency only needs to hold if its package is chosen anyway
+			bool needed = !optional || (selected(q) != Registry::none && q < reached.size() && reached[q]);
+			if (needed && !satisfied(q, d.second))
+				broken.push_back(q);
+		}
+	};
+
+	std::vector<index> stack, edges;
+	auto reach = [&](index q) {
+		if (selected(q) != Registry::none && !reached[q]) {
+			reached[q] = true;
+			stack.push_back(q);
+		}
+	};
+
+	for (auto const &r: this->_requirements) {
+		index q = this->lookup(r.first);
+		if (!satisfied(q, r.second))
+			broken.push_back(q);
+		reach(q);
+	}
+
+	while (!stack.empty()) {
+		index p = stack.back();
+		stack.pop_back();
+
+		dependencies(p, false, edges);
+		for (index q: edges)
+			reach(q);
+	}
+
+	// Optional dependencies only need to hold for packages that are still chosen
+	for (index p = 1; p < reached.size(); p++)
+		if (reached[p])
+			dependencies(p, true, edges);
+
+	return broken.empty();
+}
+
+// [bool] Re-solve only a region of packages around broken ones, the packages of the last solution outside
+// of it keeping their version, and take the result if it holds; the region grows by its neighbours a few
+// times before giving up
+bool Resolver::repair(const std::vector<index> &broken, const std::vector<bool> &touched) {
+	this->_region.assign(this->_packages.size(), false);
+	for (index q: broken)
+		this->_region[q] = true;
+
+	auto inRegion = [this](index q) {
+		return q < this->_region.size() && this->_region[q];
+	};
+
+	// The dependencies of a package of the last solution
+	std::vector<index> read;
+	auto dependencies = [&](index p) -> const std::vector<index> & {
+		if (!touched[this->_previous[p]])
+			return this->_edges[p];
+
+		read.clear();
+		for (auto const &d: this->_registry.get(this->_previous[p]).dependencies())
+			read.push_back(this->lookup(d.first));
+		return read;
+	};
+
+	for (int round = 0; round < 3; round++) {
+		// Requirements on the region, from the root and from the packages keeping their version
+		std::map<std::string, MUtilities::Range> requirements;
+		auto require = [&requirements](std::string_view name, const MUtilities::Range &range) {
+			std::string key(Registry::packageName(name));
+			auto it = requirements.find(key);
+			if (it == requirements.end())
+				requirements.emplace(std::move(key), range);
+			else
+				it->second = it->second.intersect(range);
+		};
+
+		for (auto const &r: this->_requirements)
+			if (inRegion(this->lookup(r.first)))
+				require(r.first, r.second);
+
+		for (index p: this->_order) {
+			const std::vector<index> &edges = dependencies(p);
+			if (inRegion(p) || std::none_of(edges.begin(), edges.end(), inRegion))
+				continue;
+
+			for (auto const &d: this->_registry.get(this->_previous[p]).dependencies())
+				if (inRegion(this->lookup(d.first)))
+					require(d.first, d.second);
+		}
+
+		Resolver local(this->_registry);
+		local._parent = this;
+		local.reset();
+		local.require(requirements);
+		bool solved = local.search();
+
+		this->_result.decisions += local._result.decisions;
+		this->_result.conflicts += local._result.conflicts;
+		this->_result.incompatibilities += local._result.incompatibilities;
+
+		if (solved) {
+			std::vector<Registry::id> candidate = this->_previous;
+			for (index p = 0; p < candidate.size(); p++)
+				if (inRegion(p))
+					candidate[p] = Registry::none;
+
+			for (index lp = 1; lp < local._packages.size(); lp++) {
+				if (!local._packages[lp].decided)
+					continue;
+				index p = this->lookup(local._packages[lp].name);
+				candidate.resize(std::max(candidate.size(), static_cast<std::size_t>(p) + 1), Registry::none);
+				candidate[p] = local._packages[lp].decision;
+			}
+
+			// Packages chosen anew have no edges yet
+			std::vector<bool> changed = touched;
+			for (index p = 0; p < candidate.size(); p++)
+				if (candidate[p] != Registry::none && (p >= this->_previous.size() || candidate[p] != this->_previous[p]))
+					changed[candidate[p]] = true;
+
+			std::vector<bool> reached;
+			std::vector<index> still;
+			if (!this->check(candidate, changed, reached, still))
+				return false;
+
+			this->accept(candidate, reached);
+			return true;
+		}
+
+		// Let the neighbours of the region change too, unless it would cover most of the solution
+		std::vector<bool> grown = this->_region;
+		for (index p: this->_order) {
+			const std::vector<index> &edges = dependencies(p);
+			grown.resize(this->_packages.size(), false);
+
+			if (inRegion(p)) {
+				for (index q: edges)
+					grown[q] = true;
+			} else if (std::any_of(edges.begin(), edges.end(), inRegion)) {
+				grown[p] = true;
+			}
+		}
+
+		std::size_t before = std::count(this->_region.begin(), this->_region.end(), true);
+		std::size_t after = std::count(grown.begin(), grown.end(), true);
+		if (after == before || after > this->_order.size() / 2)
+			return false;
+		this->_region = std::move(grown);
+	}
+
+	return false;
+}
+
+// [id] Get the package chosen by the last solution for a package, or none; pinned if a local search may
+// not change it
+Registry::id Resolver::previous(index p, bool &pinned) const {
+	pinned = false;
+	if (!this->_parent)
+		return (this->_incremental && p < this->_previous.size()) ? this->_previous[p] : Registry::none;
+
+	const Resolver &parent = *this->_parent;
+	auto it = parent._ids.find(this->_packages[p].name);
+	if (it == parent._ids.end() || it->second >= parent._previous.size())
+		return Registry::none;
+
+	pinned = parent._previous[it->second] != Registry::none && !(it->second < parent._region.size() &&
+		parent._region[it->second]);
+	return parent._previous[it->second];
+}
+
+// [void] Forget the dependencies read from packages changed since the last search, and what was learned
+// from them, keeping every other incompatibility; the partial solution is cleared
+void Resolver::forget() {
+	std::vector<Registry::id> changed = std::move(this->_stale);
+	this->_stale.clear();
+	this->_expanded.resize(this->_registry.size(), false);
+
+	// Packages whose dependencies are read again: the changed ones, and those whose incompatibilities were
+	// widened over a version that changed
+	std::vector<bool> expand(this->_registry.size(), false);
+	std::vector<std::pair<index, const MUtilities::Version *>> versions;
+	for (Registry::id c: changed) {
+		expand[c] = true;
+		versions.push_back({this->lookup(this->_registry.get(c).name()), &this->_registry.get(c).version()});
+	}
+
+	std::vector<bool> names(this->_packages.size(), false);
+	for (auto const &v: versions)
+		names[v.first] = true;
+
+	for (auto const &inc: this->_incompatibilities) {
+		if ((inc.cause != Cause::dependency && inc.cause != Cause::optional) || inc.source == Registry::none ||
+				!names[inc.terms[0].package])
+			continue;
+
+		for (auto const &v: versions)
+			if (inc.terms[0].package == v.first && inc.terms[0].range.satisfiedBy(*v.second))
+				expand[inc.source] = true;
+	}
+
+	// Incompatibilities are stored after their causes, so one pass finds everything derived from a dropped one
+	std::vector<index> remap(this->_incompatibilities.size(), Resolver::none);
+	std::vector<incompatibility> kept;
+
+	for (index i = 0; i < this->_incompatibilities.size(); i++) {
+		incompatibility &inc = this->_incompatibilities[i];
+		bool drop = false;
+
+		switch (inc.cause) {
+			case Cause::root:
+				break;
+			case Cause::dependency:
+			case Cause::optional:
+				drop = inc.source != Registry::none && expand[inc.source];
+				break;
+			case Cause::noVersions:
+				drop = names[inc.terms[0].package];
+				break;
+			case Cause::derived:
+				drop = remap[inc.causes[0]] == Resolver::none || remap[inc.causes[1]] == Resolver::none;
+				inc.causes[0] = remap[inc.causes[0]];
+				inc.causes[1] = remap[inc.causes[1]];
+				break;
+		}
+
+		if (!drop) {
+			remap[i] = static_cast<index>(kept.size());
+			kept.push_back(std::move(inc));
+		}
+	}
+
+	this->_incompatibilities = std::move(kept);
+	for (Registry::id id = 0; id < expand.size(); id++)
+		if (expand[id])
+			this->_expanded[id] = false;
+
+	for (auto &pkg: this->_packages) {
+		std::vector<index> incompatibilities;
+		for (index i: pkg.incompatibilities)
+			if (remap[i] != Resolver::none)
+				incompatibilities.push_back(remap[i]);
+
+		pkg.incompatibilities = std::move(incompatibilities);
+		pkg.assignments.clear();
+		pkg.decision = Registry::none;
+		pkg.decided = false;
+	}
+
+	this->_solution.clear();
+	this->_queue.clear();
+	this->_level = 0;
+}
+
+// [index] Get the package of a name or dependency key, adding it on first use
+Resolver::index Resolver::lookup(std::string_view name) {
+	name = Registry::packageName(name);
+
+	auto it = this->_ids.find(name);
+	if (it != this->_ids.end())
+		return it->second;
+
+	index p = static_cast<index>(this->_packages.size());
+	this->_names.emplace_back(name);
+	this->_packages.emplace_back();
+	this->_packages[p].name = this->_names.back();
+	this->_ids.emplace(this->_names.back(), p);
+	return p;
+}
+
+// [index] Store an incompatibility; unless it is only an intermediate step of conflict resolution, the
+// packages it mentions are told about it
+Resolver::index Resolver::add(incompatibility inc, bool attach) {
+	index i = static_cast<index>(this->_incompatibilities.size());
+	this->_incompatibilities.push_back(std::move(inc));
+	this->_result.incompatibilities++;
+
+	if (attach)
+		this->attach(i);
+	return i;
+}
+// [void] Add an incompatibility to the lists of the packages it mentions
+void Resolver::attach(index inc) {
+	for (auto const &t: this->_incompatibilities[inc].terms)
+		this->_packages[t.package].incompatibilities.push_back(inc);
+}
+
+// [void] Add an assignment to the partial solution; a decision (without cause) opens a new decision level
+void Resolver::assign(term value, index cause) {
+	index p = value.package;
+	package &pkg = this->_packages[p];
+	term accumulated = pkg.assignments.empty() ? value :
+		this->_solution[pkg.assignments.back()].accumulated.intersect(value);
+
+	if (cause == Resolver::none) {
+		this->_level++;
+		pkg.decided = true;
+	} else if (accumulated.positive && !pkg.decided) {
+		this->_queue.push_back(p);
+	}
+
+	pkg.assignments.push_back(static_cast<index>(this->_solution.size()));
+	this->_solution.push_back({std::move(value), std::move(accumulated), this->_level, cause});
+}
+
+// [Relation] Get the relation of a term to the partial solution
+Resolver::Relation Resolver::relation(const term &t) const {
+	const package &pkg = this->_packages[t.package];
+	if (pkg.assignments.empty())
+		return Relation::inconclusive;
+
+	const term &accumulated = this->_solution[pkg.assignments.back()].accumulated;
+	if (accumulated.subsetOf(t))
+		return Relation::satisfied;
+	if (accumulated.disjoint(t))
+		return Relation::contradicted;
+	return Relation::inconclusive;
+}
+
+// [index] Get the earliest assignment after which the partial solution satisfies the term, or none
+Resolver::index Resolver::satisfier(const term &t) const {
+	for (index a: this->_packages[t.package].assignments)
+		if (this->_solution[a].accumulated.subsetOf(t))
+			return a;
+	return Resolver::none;
+}
+
+// [void] Remove the assignments above a decision level
+void Resolver::backtrack(index level) {
+	while (!this->_solution.empty() && this->_solution.back().level > level) {
+		index p = this->_solution.back().value.package;
+		package &pkg = this->_packages[p];
+
+		pkg.assignments.pop_back();
+		if (this->_solution.back().cause == Resolver::none) {
+			pkg.decided = false;
+			pkg.decision = Registry::none;
+		}
+
+		// It may still be required, by what is left of the solution
+		this->_queue.push_back(p);
+		this->_solution.pop_back();
+	}
+
+	this->_level = level;
+}
+
+// [bool] Derive the assignments that incompatibilities force after a package changed; false on failure
+bool Resolver::propagate(index start, index &failure) {
+	std::vector<index> changed{start};
+
+	while (!changed.empty()) {
+		index p = changed.back();
+		changed.pop_back();
+
+		// Newest incompatibilities first, as learned ones are the most likely to apply
+		for (std::size_t k = this->_packages[p].incompatibilities.size(); k-- > 0;) {
+			index i = this->_packages[p].incompatibilities[k];
+			const std::vector<term> &terms = this->_incompatibilities[i].terms;
+			index unsatisfied = Resolver::none;
+			bool skip = false;
+
+			for (index j = 0; j < terms.size() && !skip; j++) {
+				Relation r = this->relation(terms[j]);
+				if (r == Relation::contradicted || (r == Relation::inconclusive && unsatisfied != Resolver::none))
+					skip = true;
+				else if (r == Relation::inconclusive)
+					unsatisfied = j;
+			}
+
+			if (skip)
+				continue;
+
+			// Every term holds: analyse the conflict, after which the learned incompatibility forces an assignment
+			if (unsatisfied == Resolver::none) {
+				index cause = this->resolveConflict(i, failure);
+				if (cause == Resolver::none)
+					return false;
+
+				for (auto const &t: this->_incompatibilities[cause].terms) {
+					if (this->relation(t) != Relation::satisfied) {
+						this->assign(t.inverse(), cause);
+						changed.assign(1, t.package);
+						break;
+					}
+				}
+				break;
+			}
+
+			// All terms but one hold, so that one must not
+			term t = terms[unsatisfied];
+			this->assign(t.inverse(), i);
+			if (std::find(changed.begin(), changed.end(), t.package) == changed.end())
+				changed.push_back(t.package);
+		}
+	}
+
+	return true;
+}
+
+// [index] Learn from an incompatibility that the partial solution satisfies, and backtrack until the
+// learned incompatibility forces an assignment; none (with failure set) if no solution exists
+Resolver::index Resolver::resolveConflict(index inc, index &failure) {
+	this->_result.conflicts++;
+	index original = inc;
+
+	while (true) {
+		std::vector<term> terms = this->_incompatibilities[inc].terms;
+		if (this->failed(this->_incompatibilities[inc])) {
+			failure = inc;
+			return Resolver::none;
+		}
+
+		// The assignment that made the incompatibility satisfied, and the level it was satisfied at before it
+		std::vector<index> satisfiers(terms.size());
+		index recent = 0;
+		for (index j = 0; j < terms.size(); j++) {
+			satisfiers[j] = this->satisfier(terms[j]);
+			if (satisfiers[j] > satisfiers[recent])
+				recent = j;
+		}
+
+		const assignment &satisfier = this->_solution[satisfiers[recent]];
+		index previousLevel = 0;
+		for (index j = 0; j < terms.size(); j++)
+			if (j != recent)
+				previousLevel = std::max(previousLevel, this->_solution[satisfiers[j]].level);
+
+		// The part of the satisfier not covered by the term was already decided on by earlier assignments
+		term difference = satisfier.value.intersect(terms[recent].inverse());
+		bool hasDifference = !difference.positive || !difference.range.empty();
+		if (hasDifference) {
+			index a = this->satisfier(difference.inverse());
+			if (a != Resolver::none)
+				previousLevel = std::max(previousLevel, this->_solution[a].level);
+		}
+
+		if (satisfier.cause == Resolver::none || previousLevel != satisfier.level) {
+			if (inc != original)
+				this->attach(inc);
+			this->backtrack(previousLevel);
+			return inc;
+		}
+
+		// Combine with the incompatibility that caused the satisfier, resolving away its package
+		incompatibility prior;
+		prior.cause = Cause::derived;
+		prior.causes[0] = inc;
+		prior.causes[1] = satisfier.cause;
+
+		auto merge = [&prior](const term &t) {
+			for (auto &existing: prior.terms) {
+				if (existing.package == t.package) {
+					existing = existing.intersect(t);
+					return;
+				}
+			}
+			prior.terms.push_back(t);
+		};
+
+		for (index j = 0; j < terms.size(); j++)
+			if (j != recent)
+				merge(terms[j]);
+		for (auto const &t: this->_incompatibilities[satisfier.cause].terms)
+			if (t.package != satisfier.value.package)
+				merge(t);
+		if (hasDifference)
+			merge(difference.inverse());
+
+		inc = this->add(std::move(prior), false);
+	}
+}
+
+// [index] Decide on a version of a package that is required but not chosen yet; none once all are chosen
+Resolver::index Resolver::decide() {
+	while (!this->_queue.empty()) {
+		index p = this->_queue.back();
+		this->_queue.pop_back();
+
+		const package &pkg = this->_packages[p];
+		if (pkg.decided || pkg.assignments.empty())
+			continue;
+
+		term accumulated = this->_solution[pkg.assignments.back()].accumulated;
+		if (!accumulated.positive)
+			continue;
+
+		// The root is derived before any decision, so it is never undone and needs no version
+		if (p == Resolver::root)
+			continue;
+
+		// Prefer the version chosen by the last solution, then the newest version allowed; a pinned package
+		// has no other version, and its dependencies are known to hold
+		bool pinned = false;
+		Registry::id id = this->previous(p, pinned);
+		if (id != Registry::none && !accumulated.range.satisfiedBy(this->_registry.get(id).version()))
+			id = pinned ? Registry::none : this->_registry.maxSatisfying(pkg.name, accumulated.range);
+		else if (id == Registry::none)
+			id = this->_registry.maxSatisfying(pkg.name, accumulated.range);
+
+		// Without a decision the package stays queued, as backtracking to or above its last assignment would
+		// not queue it again
+		if (id == Registry::none) {
+			this->add({{accumulated}, Cause::noVersions});
+			this->_queue.push_back(p);
+			return p;
+		}
+
+		// A version whose dependencies already conflict is not decided on; propagation will rule it out
+		if (!pinned && !this->expand(p, id)) {
+			this->_queue.push_back(p);
+			return p;
+		}
+
+		const MUtilities::Version &version = this->_registry.get(id).version();
+		this->assign({p, true, between(version, version)}, Resolver::none);
+		this->_packages[p].decision = id;
+		this->_result.decisions += !pinned;
+		return p;
+	}
+
+	return Resolver::none;
+}
+
+// [bool] Add the dependencies of a package as incompatibilities, once; false if one conflicts with the
+// partial solution
+bool Resolver::expand(index p, Registry::id id) {
+	if (this->_expanded[id])
+		return true;
+	this->_expanded[id] = true;
+
+	const Package &pkg = this->_registry.get(id);
+	const std::vector<Registry::id> &versions = this->_registry.versions(pkg.name());
+	std::size_t position = std::find(versions.begin(), versions.end(), id) - versions.begin();
+	bool conflict = false;
+
+	for (bool optional: {false, true}) {
+		auto const &dependencies = optional ? pkg.optionalDependencies() : pkg.dependencies();
+
+		for (auto const &d: dependencies) {
+			// Widen to the neighbouring versions with the same dependency, so one conflict rules them all out
+			auto same = [&](Registry::id other) {
+				const Package &o = this->_registry.get(other);
+				auto const &od = optional ? o.optionalDependencies() : o.dependencies();
+				auto it = od.find(d.first);
+				return it != od.end() && it->second == d.second;
+			};
+
+			std::size_t lower = position, upper = position;
+			while (lower > 0 && same(versions[lower - 1]))
+				lower--;
+			while (upper + 1 < versions.size() && same(versions[upper + 1]))
+				upper++;
+
+			index dep = this->lookup(d.first);
+			term depender{p, true, between(this->_registry.get(versions[lower]).version(),
+				this->_registry.get(versions[upper]).version())};
+			term dependency = optional ? term{dep, true, d.second.complement()} : term{dep, false, d.second};
+
+			incompatibility inc;
+			inc.cause = optional ? Cause::optional : Cause::dependency;
+			inc.source = id;
+			if (dep == p) {
+				// A package depending on itself only rules out its versions outside of the range
+				term merged = depender.intersect(dependency);
+				if (merged.positive && merged.range.empty())
+					continue;
+				inc.terms.push_back(merged);
+				conflict = conflict || merged.range.satisfiedBy(pkg.version());
+			} else {
+				inc.terms.push_back(std::move(depender));
+				inc.terms.push_back(std::move(dependency));
+			}
+
+			index i = this->add(std::move(inc));
+			if (dep != p && this->relation(this->_incompatibilities[i].terms[1]) == Relation::satisfied)
+				conflict = true;
+		}
+	}
+
+	return !conflict;
+}
+
+// [bool] Check if an incompatibility proves that there is no solution
+bool Resolver::failed(const incompatibility &inc) const {
+	return inc.terms.empty() ||
+		(inc.terms.size() == 1 && inc.terms[0].positive && inc.terms[0].package == Resolver::root);
+}
+
+// [string] Describe a term, e.g. "foo >=1.0.0 <2.0.0" or "not foo 1.0.0"
+std::string Resolver::describe(const term &t) const {
+	std::string out = t.positive ? "" : "not ";
+	out += this->_packages[t.package].name;
+
+	if (t.package != Resolver::root && !MUtilities::Range::all().subsetOf(t.range))
+		out += " " + t.range.str();
+	return out;
+}
+
+// [string] Describe an incompatibility as a statement
+std::string Resolver::describe(const incompatibility &inc) const {
+	std::vector<term> terms = inc.terms;
+
+	switch (inc.cause) {
+		case Cause::root:
+			return "root is required";
+		case Cause::dependency:
+			if (terms.size() == 2)
+				return this->describe(terms[0]) + " depends on " + this->describe(terms[1].inverse());
+			break;
+		case Cause::optional:
+			if (terms.size() == 2)
+				return this->describe(terms[0]) + " requires " +
+					this->describe(term{terms[1].package, true, terms[1].range.complement()}) + " if it is used";
+			break;
+		case Cause::noVersions:
+			if (this->_registry.versions(this->_packages[terms[0].package].name).empty())
+				return "no package named " + std::string(this->_packages[terms[0].package].name) + " is available";
+			return "no versions of " + this->describe(terms[0]) + " are available";
+		case Cause::derived:
+			break;
+	}
+
+	if (this->failed(inc))
+		return "version solving failed";
+
+	// The root is always chosen, so saying so adds nothing
+	terms.erase(std::remove_if(terms.begin(), terms.end(), [](const term &t) {
+		return t.package == Resolver::root && t.positive;
+	}), terms.end());
+
+	if (terms.size() == 1)
+		return terms[0].positive ? this->describe(terms[0]) + " is forbidden" :
+			this->describe(terms[0].inverse()) + " is required";
+
+	if (terms.size() == 2 && terms[0].positive != terms[1].positive) {
+		const term &pos = terms[0].positive ? terms[0] : terms[1];
+		const term &neg = terms[0].positive ? terms[1] : terms[0];
+		return this->describe(pos) + " requires " + this->describe(neg.inverse());
+	}
+
+	if (terms.size() == 2)
+		return this->describe(terms[0]) + (terms[0].positive ? " is incompatible with " : " and ") +
+			this->describe(terms[1]) + (terms[0].positive ? "" : " are incompatible");
+
+	std::string out;
+	for (std::size_t j = 0; j < terms.size(); j++)
+		out += (j == 0 ? "" : (j + 1 == terms.size() ? " and " : ", ")) + this->describe(terms[j]);
+	return out + " are incompatible";
+}
+
+// [string] Explain a failure by the derivation of its incompatibility, one numbered step per line
+std::string Resolver::explain(index failure) const {
+	if (this->_incompatibilities[failure].cause != Cause::derived)
+		return this->describe(this->_incompatibilities[failure]);
+
+	std::vector<std::string> lines;
+	std::unordered_map<index, std::size_t> numbers;
+	std::vector<std::pair<index, bool>> stack{{failure, false}};
+
+	// Post-order walk, so every derived cause is explained before the step using it
+	while (!stack.empty()) {
+		std::pair<index, bool> top = stack.back();
+		stack.pop_back();
+
+		const incompatibility &inc = this->_incompatibilities[top.first];
+		if (numbers.count(top.first))
+			continue;
+
+		if (!top.second) {
+			stack.push_back({top.first, true});
+			for (index c: inc.causes)
+				if (this->_incompatibilities[c].cause == Cause::derived && !numbers.count(c))
+					stack.push_back({c, false});
+			continue;
+		}
+
+		auto reference = [&](index c) {
+			std::string text = this->describe(this->_incompatibilities[c]);
+			if (this->_incompatibilities[c].cause == Cause::derived)
+				text += " (" + std::to_string(numbers.at(c)) + ")";
+			return text;
+		};
+
+		lines.push_back("(" + std::to_string(lines.size() + 1) + ") Because " + reference(inc.causes[0]) + " and " +
+			reference(inc.causes[1]) + ", " + this->describe(inc) + ".");
+		numbers[top.first] = lines.size();
+	}
+
+	std::string out;
+	for (auto const &l: lines)
+		out += (out.empty() ? "" : "\n") + l;
+	return out;
+}
+
+/* Term Class */
+
+// [term] Get the term holding exactly where this one does not
+Resolver::term Resolver::term::inverse() const {
+	return {this->package, !this->positive, this->range};
+}
+
+// [term] Get the term holding where both terms hold
+Resolver::term Resolver::term::intersect(const term &b) const {
+	if (this->positive && b.positive)
+		return {this->package, true, this->range.intersect(b.range)};
+	if (this->positive)
+		return {this->package, true, this->range.intersect(b.range.complement())};
+	if (b.positive)
+		return {this->package, true, b.range.intersect(this->range.complement())};
+	return {this->package, false, this->range.unite(b.range)};
+}
+
+// [bool] Check if every selection allowed by this term is allowed by b
+bool Resolver::term::subsetOf(const term &b) const {
+	if (this->positive && b.positive)
+		return this->range.subsetOf(b.range);
+	if (this->positive)
+		return !this->range.intersects(b.range);
+	if (b.positive)
+		return false; // Not choosing the package is allowed by this term but not by b
+	return b.range.subsetOf(this->range);
+}
+
+// [bool] Check if no selection is allowed by both terms
+bool Resolver::term::disjoint(const term &b) const {
+	if (this->positive && b.positive)
+		return !this->range.intersects(b.range);
+	if (this->positive)
+		return this->range.subsetOf(b.range);
+	if (b.positive)
+		return b.range.subsetOf(this->range);
+	return false; // Both allow not choosing the package
+}
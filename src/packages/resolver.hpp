@@ -0,0 +1,174 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+#include "registry.hpp"
+#include "../utilities/range.hpp"
+
+namespace MPackages {
+
+/* Dependency Resolver Class */
+
+// Chooses one version per package name so that the ranges of every dependency of every chosen package
+// are met, by conflict-driven search as in PubGrub: each conflict is analysed into a new incompatibility
+// (a set of package terms that may not all hold) that prunes every other branch running into it. An
+// optional dependency only constrains its package if something else requires it.
+//
+// The last solution and everything learned on the way are kept, so that after some manifests change an
+// update only re-solves what they affect, preferring the versions chosen before.
+class Resolver {
+	public:
+		/* Version Swap Class */
+		class swap {
+			public:
+				Registry::id from; // none if the package was not chosen before
+				Registry::id to; // none if the package is not chosen any more
+		};
+
+		/* Resolution Result Class */
+		class result {
+			public:
+				bool solved = false;
+				std::vector<Registry::id> packages; // Chosen packages, sorted by name
+				std::string explanation; // Why no solution exists, one derivation step per line
+				std::size_t decisions = 0; // Not counting packages a local search keeps
+				std::size_t conflicts = 0;
+				std::size_t incompatibilities = 0; // Including learned ones
+				std::vector<swap> delta; // Changes to the previous solution, sorted by name
+		};
+
+		Resolver(const Registry &registry);
+
+		result resolve(const std::map<std::string, MUtilities::Range> &requirements);
+		result resolve(Registry::id root); // The root package and everything it depends on
+		result update(const std::vector<Registry::id> &changed); // After packages were replaced or added
+	private:
+		typedef std::uint32_t index;
+		static const index none;
+		static const index root; // Package of the requirements
+
+		/* Term Class */
+
+		// A positive term requires the package to be chosen with a version in range. A negative term
+		// holds if the package is not chosen, or chosen with a version outside of range.
+		class term {
+			public:
+				index package;
+				bool positive;
+				MUtilities::Range range;
+
+				term inverse() const;
+				term intersect(const term &b) const; // Both terms must refer to the same package
+				bool subsetOf(const term &b) const;
+				bool disjoint(const term &b) const;
+		};
+
+		// Why an incompatibility holds
+		enum class Cause {
+			root, // The requirements must be chosen
+			dependency, // A range of versions of a package depends on a range of another
+			optional, // As dependency, but only if the other package is chosen at all
+			noVersions, // No version of a package lies in a range
+			derived // Learned from two other incompatibilities
+		};
+
+		/* Incompatibility Class */
+		class incompatibility {
+			public:
+				std::vector<term> terms; // At most one per package
+				Cause cause;
+				index causes[2] = {0, 0}; // For derived incompatibilities
+				Registry::id source = Registry::none; // Package a dependency or optional one was read from
+		};
+
+		/* Assignment Class */
+		class assignment {
+			public:
+				term value;
+				term accumulated; // Intersection of every assignment to the package so far
+				index level; // Decision level
+				index cause; // Incompatibility it was derived from, or none for a decision
+		};
+
+		/* Package State Class */
+		class package {
+			public:
+				std::string_view name;
+				std::vector<index> incompatibilities; // Mentioning the package
+				std::vector<index> assignments; // Into _solution, in order
+				Registry::id decision = Registry::none;
+				bool decided = false;
+		};
+
+		// Relation of a term to the partial solution
+		enum class Relation {
+			satisfied,
+			contradicted,
+			inconclusive
+		};
+
+		const Registry &_registry;
+		std::deque<std::string> _names; // Owns the names of packages
+		std::unordered_map<std::string_view, index> _ids;
+		std::vector<package> _packages;
+		std::vector<incompatibility> _incompatibilities;
+		std::vector<assignment> _solution;
+		std::vector<bool> _expanded; // By registry id, whether its dependencies were added
+		std::vector<index> _queue; // Packages that may be ready for a decision
+		index _level = 0;
+		result _result;
+
+		std::map<std::string, MUtilities::Range> _requirements; // Of the last resolution
+		bool _resolved = false;
+		bool _incremental = false; // Whether to prefer the last solution
+		std::vector<Registry::id> _previous; // Chosen by the last solution, by package
+		std::vector<index> _order; // Packages of the last solution, sorted by name
+		std::vector<std::vector<index>> _edges; // Dependencies of the packages of the last solution
+		std::vector<std::vector<index>> _optional; // Optional dependencies of the packages of the last solution
+		std::vector<Registry::id> _changed; // Since the last solution
+		std::vector<Registry::id> _stale; // Changed since the last search
+
+		const Resolver *_parent = nullptr; // Of a local search, whose solution it keeps outside of _region
+		std::vector<bool> _region; // Packages a local search may change, by package
+
+		void reset();
+		void require(const std::map<std::string, MUtilities::Range> &requirements);
+		bool search();
+		result solve();
+		void finish(std::vector<Registry::id> chosen, std::vector<index> order);
+		void accept(const std::vector<Registry::id> &chosen, const std::vector<bool> &reached);
+		bool check(const std::vector<Registry::id> &chosen, const std::vector<bool> &touched, std::vector<bool> &reached,
+			std::vector<index> &broken);
+		bool repair(const std::vector<index> &broken, const std::vector<bool> &touched);
+		Registry::id previous(index p, bool &pinned) const;
+		void forget();
+		index lookup(std::string_view name);
+		index add(incompatibility inc, bool attach = true);
+		void attach(index inc);
+		void assign(term value, index cause);
+		Relation relation(const term &t) const;
+		index satisfier(const term &t) const;
+		void backtrack(index level);
+
+		bool propagate(index start, index &failure);
+		index resolveConflict(index inc, index &failure);
+		index decide();
+		bool expand(index pkg, Registry::id id);
+		bool failed(const incompatibility &inc) const;
+
+		std::string describe(const term &t) const;
+		std::string describe(const incompatibility &inc) const;
+		std::string explain(index failure) const;
+};
+
+}
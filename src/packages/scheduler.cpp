@@ -0,0 +1,249 @@
+#include "scheduler.hpp"
+
+using namespace MPackages;
+
+/* Package Scheduler Class */
+
+// [constructor] Scheduler running packages of a registry on at most threads workers
+Scheduler::Scheduler(Registry &registry, std::size_t threads): _registry(registry), _threads(threads) {
+	if (this->_threads == 0)
+		this->_threads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+// [result] Run every package once its dependencies in the set have finished, and wait for all of them
+Scheduler::result Scheduler::run(const std::vector<Registry::id> &packages) {
+	result out;
+	this->build(packages);
+
+	out.timings.resize(packages.size());
+	for (std::size_t i = 0; i < packages.size(); i++)
+		out.timings[i].package = packages[i];
+
+	std::vector<index> sorted;
+	if (!this->order(sorted)) {
+		for (index i: this->cycle(sorted))
+			out.cycle.push_back(packages[i]);
+		return out;
+	}
+
+	if (packages.empty()) {
+		out.completed = true;
+		return out;
+	}
+
+	out.workers = std::min(this->_threads, packages.size());
+	this->_workers.reset(new worker[out.workers]);
+	this->_queued = 0;
+	this->_finished = 0;
+	this->_steals = 0;
+
+	// Packages without dependencies are dealt out before any worker starts
+	std::size_t next = 0;
+	for (index i = 0; i < this->_count; i++) {
+		if (this->_nodes[i].waiting == 0) {
+			this->_workers[next].ready.push_back(i);
+			this->_queued++;
+			next = (next + 1) % out.workers;
+		}
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	{
+		MUtilities::ThreadPool pool(out.workers);
+		for (std::size_t w = 0; w < out.workers; w++)
+			pool.submit([this, w, &packages, &out, start]() { this->work(w, packages, out.timings, start); });
+		pool.wait();
+	}
+	out.wall = std::chrono::steady_clock::now() - start;
+	out.steals = this->_steals;
+
+	// Longest chain by run time, following the topological order
+	std::vector<std::chrono::nanoseconds> finish(this->_count);
+	std::vector<index> via(this->_count, static_cast<index>(-1));
+	index last = sorted[0];
+	for (index i: sorted) {
+		for (index d: this->_nodes[i].dependencies)
+			if (via[i] == static_cast<index>(-1) || finish[d] > finish[via[i]])
+				via[i] = d;
+
+		finish[i] = out.timings[i].duration;
+		if (via[i] != static_cast<index>(-1))
+			finish[i] += finish[via[i]];
+		if (finish[i] > finish[last])
+			last = i;
+	}
+
+	for (index i = last; i != static_cast<index>(-1); i = via[i])
+		out.criticalPath.push_back(packages[i]);
+	std::reverse(out.criticalPath.begin(), out.criticalPath.end());
+	out.criticalLength = finish[last];
+
+	out.completed = true;
+	for (auto const &t: out.timings) {
+		out.work += t.duration;
+		out.completed = out.completed && t.status == Status::succeeded;
+	}
+
+	return out;
+}
+
+// [size_t] Get the most workers a run uses
+std::size_t Scheduler::threads() const {
+	return this->_threads;
+}
+
+// [void] Build the dependency graph of a set of packages
+void Scheduler::build(const std::vector<Registry::id> &packages) {
+	std::unordered_map<std::string_view, index> names;
+	names.reserve(packages.size());
+	for (index i = 0; i < packages.size(); i++)
+		if (!names.emplace(this->_registry.get(packages[i]).name(), i).second)
+			throw "MPackages::Scheduler::duplicatePackage";
+
+	this->_count = packages.size();
+	this->_nodes.reset(new node[this->_count]);
+
+	for (index i = 0; i < this->_count; i++) {
+		const Package &pkg = this->_registry.get(packages[i]);
+		node &n = this->_nodes[i];
+
+		for (auto const *dependencies: {&pkg.dependencies(), &pkg.optionalDependencies()}) {
+			for (auto const &d: *dependencies) {
+				auto it = names.find(Registry::packageName(d.first));
+				if (it == names.end() || std::find(n.dependencies.begin(), n.dependencies.end(), it->second) !=
+						n.dependencies.end())
+					continue;
+
+				n.dependencies.push_back(it->second);
+				this->_nodes[it->second].dependents.push_back(i);
+			}
+		}
+
+		n.waiting = static_cast<std::uint32_t>(n.dependencies.size());
+	}
+}
+
+// [bool] Sort the packages so that dependencies come first; false if some are left over on a cycle
+bool Scheduler::order(std::vector<index> &out) const {
+	std::vector<std::uint32_t> waiting(this->_count);
+	for (index i = 0; i < this->_count; i++) {
+		waiting[i] = static_cast<std::uint32_t>(this->_nodes[i].dependencies.size());
+		if (waiting[i] == 0)
+			out.push_back(i);
+	}
+
+	for (std::size_t k = 0; k < out.size(); k++)
+		for (index d: this->_nodes[out[k]].dependents)
+			if (--waiting[d] == 0)
+				out.push_back(d);
+
+	return out.size() == this->_count;
+}
+
+// [vector of indices] Find a cycle among the packages order left over, each depending on the next
+std::vector<Scheduler::index> Scheduler::cycle(const std::vector<index> &sorted) const {
+	std::vector<bool> done(this->_count, false);
+	for (index i: sorted)
+		done[i] = true;
+
+	// Every package left over has a dependency left over, so following them must come back around
+	std::vector<std::size_t> position(this->_count, static_cast<std::size_t>(-1));
+	std::vector<index> path;
+	index i = static_cast<index>(std::find(done.begin(), done.end(), false) - done.begin());
+	while (position[i] == static_cast<std::size_t>(-1)) {
+		position[i] = path.size();
+		path.push_back(i);
+		i = *std::find_if(this->_nodes[i].dependencies.begin(), this->_nodes[i].dependencies.end(),
+			[&done](index d) { return !done[d]; });
+	}
+
+	return std::vector<index>(path.begin() + position[i], path.end());
+}
+
+// [void] Worker loop, running ready packages until every package has finished
+void Scheduler::work(std::size_t self, const std::vector<Registry::id> &packages, std::vector<timing> &timings,
+		std::chrono::steady_clock::time_point start) {
+	while (true) {
+		index pkg;
+		if (!this->take(self, pkg)) {
+			std::unique_lock<std::mutex> lock(this->_sleep);
+			this->_wake.wait(lock, [this]() { return this->_queued > 0 || this->_finished == this->_count; });
+			if (this->_finished == this->_count)
+				return;
+			continue;
+		}
+
+		node &n = this->_nodes[pkg];
+		timing &t = timings[pkg];
+		auto begin = std::chrono::steady_clock::now();
+		t.worker = self;
+		t.start = begin - start;
+
+		if (!n.blocked) {
+			bool succeeded;
+			try {
+				succeeded = this->_registry.get(packages[pkg]).run();
+			} catch (...) {
+				succeeded = false;
+			}
+
+			t.duration = std::chrono::steady_clock::now() - begin;
+			t.status = succeeded ? Status::succeeded : Status::failed;
+		}
+
+		for (index d: n.dependents) {
+			if (t.status != Status::succeeded)
+				this->_nodes[d].blocked = true;
+			if (this->_nodes[d].waiting.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				this->push(self, d);
+		}
+
+		if (++this->_finished == this->_count) {
+			std::lock_guard<std::mutex> lock(this->_sleep);
+			this->_wake.notify_all();
+		}
+	}
+}
+
+// [bool] Take the newest package of the own deque, or else steal the oldest of another
+bool Scheduler::take(std::size_t self, index &out) {
+	std::size_t count = std::min(this->_threads, this->_count);
+	for (std::size_t k = 0; k < count; k++) {
+		worker &w = this->_workers[(self + k) % count];
+		std::lock_guard<std::mutex> lock(w.mutex);
+		if (w.ready.empty())
+			continue;
+
+		if (k == 0) {
+			out = w.ready.back();
+			w.ready.pop_back();
+		} else {
+			out = w.ready.front();
+			w.ready.pop_front();
+			this->_steals++;
+		}
+
+		this->_queued--;
+		return true;
+	}
+
+	return false;
+}
+
+// [void] Queue a ready package on the deque of a worker, waking an idle one if the worker has more than it
+// takes next
+void Scheduler::push(std::size_t self, index pkg) {
+	std::size_t size;
+	{
+		std::lock_guard<std::mutex> lock(this->_workers[self].mutex);
+		this->_workers[self].ready.push_back(pkg);
+		this->_queued++; // Before any worker can take it
+		size = this->_workers[self].ready.size();
+	}
+
+	if (size < 2)
+		return;
+
+	std::lock_guard<std::mutex> lock(this->_sleep);
+	this->_wake.notify_one();
+}
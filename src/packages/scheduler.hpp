@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#include "registry.hpp"
+#include "../utilities/threadpool.hpp"
+
+namespace MPackages {
+
+/* Package Scheduler Class */
+
+// Calls Package::run on a set of packages, such as Resolver::result::packages, starting each package only
+// after every package of the set that it depends on has finished. This includes optional dependencies.
+// Dependencies outside of the set are assumed to be met.
+//
+// Each worker has its own deque. Packages that a finished package makes ready go onto its worker's deque,
+// and each worker takes the newest entry from its own deque first, so chains of dependencies tend to stay
+// on one thread. Idle workers steal the oldest entries of other deques. A package whose run returns false
+// or throws has failed, and every package that depends on it is skipped.
+class Scheduler {
+	public:
+		enum class Status {
+			succeeded,
+			failed, // run returned false or threw
+			skipped // A dependency failed or was skipped
+		};
+
+		/* Package Timing Class */
+		class timing {
+			public:
+				Registry::id package = Registry::none;
+				Status status = Status::skipped;
+				std::size_t worker = 0;
+				std::chrono::nanoseconds start{0}; // Since the run started
+				std::chrono::nanoseconds duration{0}; // Of run, 0 if skipped
+		};
+
+		/* Run Result Class */
+		class result {
+			public:
+				bool completed = false; // Whether every package succeeded
+				std::vector<Registry::id> cycle; // Each depending on the next and the last on the first; if any, nothing ran
+				std::vector<timing> timings; // Parallel to the packages given
+				std::vector<Registry::id> criticalPath; // Chain of dependencies taking longest to run, dependencies first
+				std::chrono::nanoseconds criticalLength{0}; // Run time of the critical path, the least possible wall time
+				std::chrono::nanoseconds work{0}; // Sum of every run time
+				std::chrono::nanoseconds wall{0};
+				std::size_t workers = 0;
+				std::size_t steals = 0; // Packages taken from the deque of another worker
+		};
+
+		Scheduler(Registry &registry, std::size_t threads = 0); // At most threads workers, 0 uses one per hardware thread
+
+		result run(const std::vector<Registry::id> &packages);
+
+		std::size_t threads() const;
+	private:
+		typedef std::uint32_t index;
+
+		/* Graph Node Class */
+		class node {
+			public:
+				std::vector<index> dependencies; // In the set
+				std::vector<index> dependents;
+				std::atomic<std::uint32_t> waiting{0}; // Dependencies that have not finished
+				std::atomic<bool> blocked{false}; // A dependency failed or was skipped
+		};
+
+		/* Worker Deque Class */
+		class worker {
+			public:
+				std::mutex mutex;
+				std::deque<index> ready;
+		};
+
+		Registry &_registry;
+		std::size_t _threads;
+
+		std::unique_ptr<node[]> _nodes;
+		std::unique_ptr<worker[]> _workers;
+		std::size_t _count = 0;
+		std::atomic<std::size_t> _queued{0}; // On any deque
+		std::atomic<std::size_t> _finished{0};
+		std::atomic<std::size_t> _steals{0};
+		std::mutex _sleep;
+		std::condition_variable _wake; // Signalled when a package is queued or the last one finishes
+
+		void build(const std::vector<Registry::id> &packages);
+		bool order(std::vector<index> &out) const;
+		std::vector<index> cycle(const std::vector<index> &sorted) const;
+		void work(std::size_t self, const std::vector<Registry::id> &packages, std::vector<timing> &timings,
+			std::chrono::steady_clock::time_point start);
+		bool take(std::size_t self, index &out);
+		void push(std::size_t self, index pkg);
+};
+
+}
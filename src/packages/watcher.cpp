@@ -0,0 +1,256 @@
+#include "watcher.hpp"
+
+using namespace MPackages;
+
+namespace fs = std::filesystem;
+
+namespace {
+	// Changes to files and directories; IN_MODIFY only delays the debounce while a file is being written
+	const std::uint32_t events = IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE |
+		IN_ONLYDIR;
+
+	// [bool] Whether a path is dir or lies below it
+	bool below(std::string_view path, std::string_view dir) {
+		return path.size() >= dir.size() && path.compare(0, dir.size(), dir) == 0 &&
+			(path.size() == dir.size() || path[dir.size()] == '/');
+	}
+}
+
+/* Manifest Watcher Class */
+
+// [constructor] Watcher of the roots of a loader, reconstructing packages with its factory
+Watcher::Watcher(Registry &registry, const Loader &loader, std::chrono::milliseconds debounce, std::size_t threads):
+		_registry(registry), _factory(loader.factory()), _debounce(debounce), _scheduler(registry, threads),
+		_roots(loader.roots()) {
+	this->_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (this->_fd < 0)
+		throw "MPackages::Watcher::watchFailed";
+
+	for (Registry::id id = 0; id < registry.size(); id++)
+		this->_manifests.emplace((fs::path(registry.get(id).path()) / Loader::manifestName).string(), id);
+
+	// Roots that do not exist are skipped, as by the loader
+	for (auto const &root: this->_roots) {
+		std::error_code ec;
+		if (fs::is_directory(root, ec) && !this->watch(root, false)) {
+			::close(this->_fd);
+			throw "MPackages::Watcher::watchFailed";
+		}
+	}
+}
+
+// [destructor] Stop watching
+Watcher::~Watcher() {
+	::close(this->_fd);
+}
+
+// [void] Set the packages to run again when they or their dependencies change
+void Watcher::setRunning(std::vector<Registry::id> packages) {
+	this->_running = std::move(packages);
+}
+
+// [vector of strings] Drain the pending events; changed manifest paths are returned, sorted, once no event arrived
+// for the debounce interval, and empty otherwise
+std::vector<std::string> Watcher::poll() {
+	alignas(inotify_event) char buffer[16384];
+	bool overflow = false;
+	ssize_t length;
+
+	while ((length = ::read(this->_fd, buffer, sizeof(buffer))) > 0) {
+		this->_last = std::chrono::steady_clock::now();
+
+		for (char *p = buffer; p < buffer + length;) {
+			const inotify_event *e = reinterpret_cast<const inotify_event *>(p);
+			p += sizeof(inotify_event) + e->len;
+
+			if (e->mask & IN_Q_OVERFLOW) {
+				overflow = true;
+				continue;
+			}
+
+			auto w = this->_watches.find(e->wd);
+			if (w == this->_watches.end())
+				continue;
+			if (e->mask & IN_IGNORED) {
+				this->_watches.erase(w);
+				continue;
+			}
+			if (e->len == 0)
+				continue;
+
+			fs::path path = fs::path(w->second) / e->name;
+			if (!(e->mask & IN_ISDIR)) {
+				if (path.filename() == Loader::manifestName)
+					this->_pending.insert(path.string());
+				continue;
+			}
+
+			// A directory moved away keeps its watches, under a path that is no longer right
+			if (e->mask & IN_MOVED_FROM) {
+				std::string dir = path.string();
+				for (auto it = this->_watches.begin(); it != this->_watches.end();) {
+					if (below(it->second, dir)) {
+						::inotify_rm_watch(this->_fd, it->first);
+						it = this->_watches.erase(it);
+					} else {
+						it++;
+					}
+				}
+				for (auto const &m: this->_manifests)
+					if (below(m.first, dir))
+						this->_pending.insert(m.first);
+			}
+
+			// Manifests of a new directory may have been written before its watch was added
+			if (e->mask & (IN_CREATE | IN_MOVED_TO))
+				this->watch(path, true);
+		}
+	}
+
+	if (overflow)
+		this->rescan();
+
+	if (this->_pending.empty() || std::chrono::steady_clock::now() - this->_last < this->_debounce)
+		return std::vector<std::string>();
+
+	std::vector<std::string> out(this->_pending.begin(), this->_pending.end());
+	this->_pending.clear();
+	return out;
+}
+
+// [result] Parse, validate and swap in the packages of changed manifests, and run the affected packages again
+Watcher::result Watcher::reload(const std::vector<std::string> &manifests) {
+	result out;
+	std::string text;
+
+	for (auto const &m: manifests) {
+		auto known = this->_manifests.find(m);
+		std::error_code ec;
+
+		// A manifest that is gone keeps its package, as packages can not be removed from the registry
+		if (!fs::exists(m, ec)) {
+			if (known != this->_manifests.end())
+				out.errors.push_back({m, "MPackages::Watcher::removedManifest"});
+			continue;
+		}
+		if (!Loader::readManifest(m, text)) {
+			out.errors.push_back({m, "MPackages::Loader::unreadableManifest"});
+			continue;
+		}
+
+		try {
+			std::unique_ptr<Package> pkg = this->_factory(fs::path(m).parent_path().string(), Manifest(text));
+			if (known != this->_manifests.end()) {
+				this->_registry.replace(known->second, std::move(pkg));
+				out.changed.push_back(known->second);
+			} else {
+				Registry::id id = this->_registry.add(std::move(pkg));
+				this->_manifests.emplace(m, id);
+				out.changed.push_back(id);
+			}
+		} catch (const char *e) {
+			out.errors.push_back({m, e});
+		} catch (const std::string &e) {
+			out.errors.push_back({m, e});
+		} catch (const std::exception &e) {
+			out.errors.push_back({m, e.what()});
+		}
+	}
+
+	out.affected = this->dependents(out.changed);
+	if (!out.affected.empty())
+		out.run = this->_scheduler.run(out.affected);
+
+	return out;
+}
+
+// [int] Get the inotify file descriptor, readable when events are pending
+int Watcher::descriptor() const {
+	return this->_fd;
+}
+
+// [size_t] Get number of watched directories
+std::size_t Watcher::watches() const {
+	return this->_watches.size();
+}
+
+// [bool] Watch a directory and the directories below it, up to those holding a manifest, like the loader's scan;
+// with scan set, the manifests found are pending
+bool Watcher::watch(const fs::path &dir, bool scan) {
+	int wd = ::inotify_add_watch(this->_fd, dir.c_str(), events);
+	if (wd < 0)
+		return false;
+	this->_watches[wd] = dir.string();
+
+	std::error_code ec;
+	fs::path manifest = dir / Loader::manifestName;
+	if (fs::is_regular_file(manifest, ec)) {
+		if (scan)
+			this->_pending.insert(manifest.string());
+		return true;
+	}
+
+	for (fs::directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec), end; !ec && it != end;
+			it.increment(ec)) {
+		if (it->is_directory(ec) && !it->is_symlink(ec))
+			this->watch(it->path(), scan);
+	}
+	return true;
+}
+
+// [void] Watch every root again after events were lost, and treat every manifest as changed
+void Watcher::rescan() {
+	for (auto const &w: this->_watches)
+		::inotify_rm_watch(this->_fd, w.first);
+	this->_watches.clear();
+
+	for (auto const &m: this->_manifests)
+		this->_pending.insert(m.first);
+	for (auto const &root: this->_roots) {
+		std::error_code ec;
+		if (fs::is_directory(root, ec))
+			this->watch(root, true);
+	}
+}
+
+// [vector of ids] Get the running packages that changed, and those depending on them directly or indirectly, in
+// running order
+std::vector<Registry::id> Watcher::dependents(const std::vector<Registry::id> &changed) const {
+	std::unordered_set<Registry::id> seeds(changed.begin(), changed.end());
+	std::unordered_map<std::string_view, std::vector<std::size_t>> users; // Package name to running dependents
+	std::vector<bool> affected(this->_running.size(), false);
+	std::vector<std::size_t> queue;
+
+	for (std::size_t i = 0; i < this->_running.size(); i++) {
+		const Package &pkg = this->_registry.get(this->_running[i]);
+		for (auto const *deps: {&pkg.dependencies(), &pkg.optionalDependencies()})
+			for (auto const &d: *deps)
+				users[Registry::packageName(d.first)].push_back(i);
+
+		if (seeds.count(this->_running[i])) {
+			affected[i] = true;
+			queue.push_back(i);
+		}
+	}
+
+	while (!queue.empty()) {
+		std::size_t i = queue.back();
+		queue.pop_back();
+
+		auto it = users.find(this->_registry.get(this->_running[i]).name());
+		if (it == users.end())
+			continue;
+		for (std::size_t user: it->second) {
+			if (!affected[user]) {
+				affected[user] = true;
+				queue.push_back(user);
+			}
+		}
+	}
+
+	std::vector<Registry::id> out;
+	for (std::size_t i = 0; i < this->_running.size(); i++)
+		if (affected[i])
+			out.push_back(this->_running[i]);
+	return out;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <set>
+#include <fstream>
+#include <chrono>
+#include <filesystem>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "registry.hpp"
+#include "loader.hpp"
+#include "scheduler.hpp"
+
+namespace MPackages {
+
+/* Manifest Watcher Class */
+
+// Watches the package roots with Linux inotify and reloads manifests that change on disk, e.g. while a mod
+// is being worked on. Edits are collected until none arrived for the debounce interval, and then only the
+// changed manifests are parsed and validated again. A changed package replaces the registry's one in place,
+// keeping its id, and a new manifest adds a package. Of the running packages, only those that changed and
+// those depending on them are run again. Pass result::changed to Resolver::update to check the solution.
+class Watcher {
+	public:
+		/* Reload Result Class */
+		class result {
+			public:
+				std::vector<Registry::id> changed; // Replaced or added packages
+				std::vector<Registry::id> affected; // Running packages that changed or depend on one that did
+				std::vector<Loader::error> errors; // The package of a manifest that fails to reload is kept
+				Scheduler::result run; // Of the affected packages
+		};
+
+		// Watches the roots of the loader, and maps their manifests to the registry's packages by path
+		Watcher(Registry &registry, const Loader &loader,
+			std::chrono::milliseconds debounce = std::chrono::milliseconds(200), std::size_t threads = 0);
+		~Watcher();
+
+		Watcher(const Watcher &) = delete;
+		Watcher &operator = (const Watcher &) = delete;
+
+		void setRunning(std::vector<Registry::id> packages); // E.g. Resolver::result::packages
+
+		std::vector<std::string> poll(); // Changed manifests, once the edits have settled; never blocks
+		result reload(const std::vector<std::string> &manifests);
+
+		int descriptor() const; // To wait for events with poll or select
+		std::size_t watches() const; // Watched directories
+	private:
+		Registry &_registry;
+		Loader::Factory _factory;
+		std::chrono::milliseconds _debounce;
+		Scheduler _scheduler;
+		int _fd = -1;
+
+		std::vector<std::string> _roots;
+		std::unordered_map<int, std::string> _watches; // Watch descriptor to directory
+		std::unordered_map<std::string, Registry::id> _manifests; // Manifest path to package
+		std::vector<Registry::id> _running;
+
+		std::set<std::string> _pending; // Manifests changed since the last poll returned them
+		std::chrono::steady_clock::time_point _last; // Of the last event
+
+		bool watch(const std::filesystem::path &dir, bool scan);
+		void rescan();
+		std::vector<Registry::id> dependents(const std::vector<Registry::id> &changed) const;
+};
+
+}
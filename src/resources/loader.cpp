@@ -0,0 +1,198 @@
+#include "loader.hpp"
+
+using namespace MResources;
+
+namespace {
+	// [size_t] Queue of a priority class
+	std::size_t queue(Loader::Priority priority) {
+		return static_cast<std::size_t>(priority);
+	}
+}
+
+/* Resource Loader Class */
+
+const Loader::ticket Loader::none = 0;
+
+// [constructor] Loader reading files of an overlay on the given number of I/O threads (0 uses one per
+// hardware thread)
+Loader::Loader(const MPackages::Overlay &overlay, std::size_t threads): _overlay(overlay), _pool(threads) {}
+
+// [destructor] Wait for the reads in progress; queued reads and undelivered callbacks are dropped
+Loader::~Loader() {
+	std::lock_guard<std::mutex> lock(this->_mutex);
+	for (auto &q: this->_queued)
+		q.clear();
+}
+
+// [ticket] Request the contents of a file; the callback runs from deliver once it has been read, with the
+// error set if it could not be
+Loader::ticket Loader::request(std::string path, Priority priority, Callback callback) {
+	std::unique_lock<std::mutex> lock(this->_mutex);
+	ticket t = this->_next++;
+	this->_stats.requests++;
+
+	auto it = this->_reads.find(path);
+	if (it != this->_reads.end()) {
+		std::shared_ptr<read> r = it->second;
+		r->callbacks.emplace_back(t, std::move(callback));
+		this->_tickets.emplace(t, r);
+		this->_stats.coalesced++;
+
+		// A more urgent request moves the read forward; its old queue entry goes stale
+		if (priority < r->priority && (r->state == State::queued || r->state == State::done)) {
+			r->priority = priority;
+			(r->state == State::queued ? this->_queued : this->_done)[queue(priority)].push_back(r);
+		}
+		return t;
+	}
+
+	std::shared_ptr<read> r(new read());
+	r->path = std::move(path);
+	r->priority = priority;
+	r->callbacks.emplace_back(t, std::move(callback));
+	this->_reads.emplace(r->path, r);
+	this->_tickets.emplace(t, r);
+	this->_queued[queue(priority)].push_back(r);
+	this->_outstanding++;
+	lock.unlock();
+
+	// Every task reads whichever queued file is most urgent when it starts
+	this->_pool.submit([this]() { this->work(); });
+	return t;
+}
+
+// [bool] Cancel a request; a read nobody waits for any more is skipped, or its result discarded
+bool Loader::cancel(ticket t) {
+	std::lock_guard<std::mutex> lock(this->_mutex);
+	auto it = this->_tickets.find(t);
+	if (it == this->_tickets.end())
+		return false;
+
+	std::shared_ptr<read> r = it->second;
+	this->_tickets.erase(it);
+	r->callbacks.erase(std::find_if(r->callbacks.begin(), r->callbacks.end(),
+		[t](const std::pair<ticket, Callback> &c) { return c.first == t; }));
+	this->_stats.cancelled++;
+
+	if (r->callbacks.empty()) {
+		if (r->state == State::queued && --this->_outstanding == 0)
+			this->_idle.notify_all();
+		this->drop(r);
+	}
+	return true;
+}
+
+// [size_t] Run the callbacks of finished reads, most urgent first, until the budget is used up; at least
+// one read is delivered if any has finished
+std::size_t Loader::deliver(std::chrono::nanoseconds budget) {
+	auto start = std::chrono::steady_clock::now();
+	std::size_t delivered = 0;
+
+	while (true) {
+		std::shared_ptr<read> r;
+		std::vector<std::pair<ticket, Callback>> callbacks;
+		{
+			std::lock_guard<std::mutex> lock(this->_mutex);
+			for (std::size_t p = 0; p < 3 && !r; p++) {
+				while (!this->_done[p].empty() && !r) {
+					std::shared_ptr<read> next = std::move(this->_done[p].front());
+					this->_done[p].pop_front();
+					if (next->state == State::done && queue(next->priority) == p)
+						r = std::move(next);
+				}
+			}
+			if (!r)
+				break;
+
+			// Callbacks may request or cancel, so they run without the lock
+			callbacks = std::move(r->callbacks);
+			r->callbacks.clear();
+			for (auto const &c: callbacks)
+				this->_tickets.erase(c.first);
+			this->drop(r);
+			this->_stats.delivered += callbacks.size();
+		}
+
+		resource res;
+		res.path = r->path;
+		res.data = r->data;
+		res.error = r->error;
+		for (auto const &c: callbacks)
+			c.second(res);
+
+		delivered += callbacks.size();
+		if (std::chrono::steady_clock::now() - start >= budget)
+			break;
+	}
+
+	return delivered;
+}
+
+// [void] Block until every queued read has finished, e.g. behind a loading screen
+void Loader::wait() {
+	std::unique_lock<std::mutex> lock(this->_mutex);
+	this->_idle.wait(lock, [this]() { return this->_outstanding == 0; });
+}
+
+// [size_t] Get number of requests whose callback has not run yet
+std::size_t Loader::pending() const {
+	std::lock_guard<std::mutex> lock(this->_mutex);
+	return this->_tickets.size();
+}
+
+// [statistics] Get counters since construction
+Loader::statistics Loader::stats() const {
+	std::lock_guard<std::mutex> lock(this->_mutex);
+	return this->_stats;
+}
+
+// [void] I/O task: read the most urgent queued file
+void Loader::work() {
+	std::shared_ptr<read> r;
+	{
+		std::lock_guard<std::mutex> lock(this->_mutex);
+		for (std::size_t p = 0; p < 3 && !r; p++) {
+			while (!this->_queued[p].empty() && !r) {
+				std::shared_ptr<read> next = std::move(this->_queued[p].front());
+				this->_queued[p].pop_front();
+				if (next->state == State::queued && queue(next->priority) == p)
+					r = std::move(next);
+			}
+		}
+		if (!r)
+			return;
+		r->state = State::reading;
+	}
+
+	// Only this task touches the buffer while reading
+	std::string_view data;
+	std::string error;
+	try {
+		data = this->_overlay.read(r->path, r->buffer);
+	} catch (const char *e) {
+		error = e;
+	} catch (const std::exception &e) {
+		error = e.what();
+	}
+
+	std::lock_guard<std::mutex> lock(this->_mutex);
+	r->data = data;
+	r->error = std::move(error);
+	this->_stats.reads++;
+	this->_stats.bytes += data.size();
+	if (--this->_outstanding == 0)
+		this->_idle.notify_all();
+
+	if (r->state == State::dropped)
+		return;
+	r->state = State::done;
+	this->_done[queue(r->priority)].push_back(r);
+}
+
+// [void] Forget a read, so that a later request for its file reads it again
+void Loader::drop(const std::shared_ptr<read> &r) {
+	r->state = State::dropped;
+	auto it = this->_reads.find(r->path);
+	if (it != this->_reads.end() && it->second == r)
+		this->_reads.erase(it);
+}
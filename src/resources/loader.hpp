@@ -0,0 +1,112 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <exception>
+
+#include "../packages/overlay.hpp"
+#include "../utilities/threadpool.hpp"
+
+namespace MResources {
+
+/* Resource Loader Class */
+
+// Reads files of mounted packages on its own I/O threads, so that the main thread never blocks on disk.
+// Requests are served by priority class and then in order. Requests for a file that is already pending
+// share one read. Completion callbacks run on the thread calling deliver, normally once per frame from
+// the main loop, until a time budget is used up. The overlay must not change while reads are pending.
+class Loader {
+	public:
+		typedef std::uint64_t ticket;
+		static const ticket none;
+
+		enum class Priority {
+			now, // Needed for the current frame
+			soon, // Needed within a few frames
+			background // Prefetch
+		};
+
+		/* Loaded Resource Class */
+		class resource {
+			public:
+				std::string_view path;
+				std::string_view data; // Valid during the callback only
+				std::string error; // Empty on success
+		};
+
+		typedef std::function<void(const resource &res)> Callback;
+
+		/* Loader Statistics Class */
+		class statistics {
+			public:
+				std::size_t requests = 0;
+				std::size_t coalesced = 0; // Requests that joined a pending read of the same file
+				std::size_t reads = 0;
+				std::size_t bytes = 0; // Read
+				std::size_t cancelled = 0; // Requests cancelled before their callback ran
+				std::size_t delivered = 0; // Callbacks run
+		};
+
+		Loader(const MPackages::Overlay &overlay, std::size_t threads = 2);
+		~Loader();
+
+		Loader(const Loader &) = delete;
+		Loader &operator = (const Loader &) = delete;
+
+		ticket request(std::string path, Priority priority, Callback callback);
+		bool cancel(ticket t); // false if its callback already ran or is running
+
+		std::size_t deliver(std::chrono::nanoseconds budget); // Callbacks run
+		void wait(); // Until every pending read has finished
+
+		std::size_t pending() const; // Requests whose callback has not run yet
+		statistics stats() const;
+	private:
+		enum class State {
+			queued,
+			reading,
+			done,
+			dropped // Cancelled by every requester, or delivered
+		};
+
+		/* Pending Read Class */
+		class read {
+			public:
+				std::string path;
+				Priority priority;
+				State state = State::queued;
+				std::vector<std::pair<ticket, Callback>> callbacks;
+				std::string buffer; // Contents of a file of a directory
+				std::string_view data;
+				std::string error;
+		};
+
+		const MPackages::Overlay &_overlay;
+		mutable std::mutex _mutex;
+		std::condition_variable _idle; // Signalled when the last outstanding read finishes
+		std::unordered_map<std::string_view, std::shared_ptr<read>> _reads; // By path, until delivered
+		std::unordered_map<ticket, std::shared_ptr<read>> _tickets;
+		std::deque<std::shared_ptr<read>> _queued[3]; // By priority; may hold stale entries, which are skipped
+		std::deque<std::shared_ptr<read>> _done[3]; // By priority
+		std::size_t _outstanding = 0; // Reads queued or reading
+		ticket _next = 1;
+		statistics _stats;
+		MUtilities::ThreadPool _pool; // Last, so that its tasks finish before the rest is destroyed
+
+		void work();
+		void drop(const std::shared_ptr<read> &r);
+};
+
+}
@@ -0,0 +1,68 @@
+#include "arena.hpp"
+
+using namespace MUtilities;
+
+/* Arena Class */
+
+// [constructor] Empty arena, holding no block
+Arena::Arena() {}
+// [constructor] Arena of capacity bytes, allocated at once
+Arena::Arena(std::size_t capacity) : _capacity(capacity) {
+	if (capacity > 0)
+		this->_block = static_cast<char *>(::operator new(capacity));
+}
+
+// [constructor] Take the block of another arena, leaving it empty
+Arena::Arena(Arena &&other) noexcept : _block(other._block), _capacity(other._capacity), _used(other._used) {
+	other._block = nullptr;
+	other._capacity = other._used = 0;
+}
+
+// [Arena] Free the block and take the block of another arena, leaving it empty
+Arena &Arena::operator = (Arena &&other) noexcept {
+	if (this != &other) {
+		::operator delete(this->_block);
+		this->_block = other._block;
+		this->_capacity = other._capacity;
+		this->_used = other._used;
+		other._block = nullptr;
+		other._capacity = other._used = 0;
+	}
+	return *this;
+}
+
+// [destructor] Free the block
+Arena::~Arena() {
+	::operator delete(this->_block);
+}
+
+// [pointer] Allocate bytes at the given alignment, a power of two; throws if the block is too small
+void *Arena::allocate(std::size_t bytes, std::size_t alignment) {
+	std::uintptr_t base = reinterpret_cast<std::uintptr_t>(this->_block);
+	std::size_t start = ((base + this->_used + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1)) - base;
+
+	if (start > this->_capacity || this->_capacity - start < bytes)
+		throw "MUtilities::Arena::full";
+
+	this->_used = start + bytes;
+	return this->_block + start;
+}
+
+// [string_view] Copy a string into the arena; empty strings take no space
+std::string_view Arena::copy(std::string_view str) {
+	if (str.empty())
+		return std::string_view();
+
+	char *out = static_cast<char *>(this->allocate(str.size(), 1));
+	std::memcpy(out, str.data(), str.size());
+	return std::string_view(out, str.size());
+}
+
+// [size_t] Get size of the block
+std::size_t Arena::capacity() const {
+	return this->_capacity;
+}
+// [size_t] Get bytes allocated so far, including alignment padding
+std::size_t Arena::used() const {
+	return this->_used;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <string_view>
+#include <algorithm>
+#include <new>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace MUtilities {
+
+/* Arena Class */
+
+// One block of memory, sized up front, that objects and strings are bump-allocated from and that is freed
+// with a single deallocation. The arena does not destroy the objects placed into it.
+class Arena {
+	public:
+		Arena();
+		Arena(std::size_t capacity);
+		~Arena();
+
+		Arena(const Arena &) = delete;
+		Arena &operator = (const Arena &) = delete;
+		Arena(Arena &&other) noexcept; // Objects placed into the block stay where they are
+		Arena &operator = (Arena &&other) noexcept;
+
+		void *allocate(std::size_t bytes, std::size_t alignment);
+		std::string_view copy(std::string_view str);
+
+		// [pointer] Allocate uninitialized storage for count objects of type T
+		template<typename T> T *allocate(std::size_t count) {
+			return static_cast<T *>(this->allocate(count * sizeof(T), alignof(T)));
+		}
+
+		std::size_t capacity() const;
+		std::size_t used() const;
+	private:
+		char *_block = nullptr;
+		std::size_t _capacity = 0;
+		std::size_t _used = 0;
+};
+
+/* Slice Class */
+
+// Read-only view of consecutive objects, such as an array placed into an arena
+template<typename T> class Slice {
+	public:
+		Slice() {}
+		Slice(const T *data, std::size_t size): _data(data), _size(size) {}
+
+		const T *begin() const {
+			return this->_data;
+		}
+		const T *end() const {
+			return this->_data + this->_size;
+		}
+		const T &operator [] (std::size_t i) const {
+			return this->_data[i];
+		}
+		std::size_t size() const {
+			return this->_size;
+		}
+		bool empty() const {
+			return this->_size == 0;
+		}
+
+		bool operator == (const Slice &b) const {
+			return std::equal(this->begin(), this->end(), b.begin(), b.end());
+		}
+		bool operator != (const Slice &b) const {
+			return !(*this == b);
+		}
+	private:
+		const T *_data = nullptr;
+		std::size_t _size = 0;
+};
+
+}
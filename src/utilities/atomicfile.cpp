@@ -0,0 +1,46 @@
+#include "atomicfile.hpp"
+
+using namespace MUtilities;
+
+/* Atomic File Class */
+
+// [constructor] Open the temporary file of path, truncating it
+AtomicFile::AtomicFile(std::string path): _path(std::move(path)), _temp(this->_path + ".tmp") {
+	this->_stream.open(this->_temp, std::ios::binary | std::ios::trunc);
+}
+
+// [destructor] Remove the temporary file unless it was committed
+AtomicFile::~AtomicFile() {
+	if (!this->_committed) {
+		this->_stream.close();
+		std::remove(this->_temp.c_str());
+	}
+}
+
+// [bool] Write the whole contents of path, replacing any existing file only once they are complete
+bool AtomicFile::write(const std::string &path, std::string_view bytes) {
+	AtomicFile file(path);
+	return file.write(bytes) && file.commit();
+}
+
+// [ofstream] Get the stream of the temporary file, for writing in parts
+std::ofstream &AtomicFile::stream() {
+	return this->_stream;
+}
+
+// [bool] Append bytes to the temporary file
+bool AtomicFile::write(std::string_view bytes) {
+	return static_cast<bool>(this->_stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size())));
+}
+
+// [bool] Flush the temporary file and rename it over the destination
+bool AtomicFile::commit() {
+	if (!this->_stream.flush())
+		return false;
+	this->_stream.close();
+	if (this->_stream.fail() || std::rename(this->_temp.c_str(), this->_path.c_str()) != 0)
+		return false;
+
+	this->_committed = true;
+	return true;
+}
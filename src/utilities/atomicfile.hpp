@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <cstdio>
+#include <utility>
+
+namespace MUtilities {
+
+/* Atomic File Class */
+
+// A file written next to its destination, at path.tmp, that replaces the destination only once it is complete.
+// Readers, including those still mapping the old file, never see a partial file. Unless committed, the
+// temporary file is removed on destruction.
+class AtomicFile {
+	public:
+		AtomicFile(std::string path);
+		~AtomicFile();
+
+		AtomicFile(const AtomicFile &) = delete;
+		AtomicFile &operator = (const AtomicFile &) = delete;
+
+		static bool write(const std::string &path, std::string_view bytes); // Whole contents at once
+
+		std::ofstream &stream();
+		bool write(std::string_view bytes);
+		bool commit(); // Flush and rename over the destination; false if either failed
+	private:
+		std::string _path;
+		std::string _temp;
+		std::ofstream _stream;
+		bool _committed = false;
+};
+
+}
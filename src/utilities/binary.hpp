@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+
+namespace MUtilities::Binary {
+	// Fixed-size integers of the binary file formats, in host byte order
+
+	// [void] Append the bytes of an integer
+	template<typename T> void put(std::string &out, T value) {
+		char bytes[sizeof(T)];
+		std::memcpy(bytes, &value, sizeof(T));
+		out.append(bytes, sizeof(T));
+	}
+
+	// [T] Read an integer at offset; the caller checks bounds
+	template<typename T> T get(std::string_view bytes, std::size_t offset) {
+		T value;
+		std::memcpy(&value, bytes.data() + offset, sizeof(T));
+		return value;
+	}
+
+	// [uint64] Round offset up to a multiple of a power of two
+	inline std::uint64_t align(std::uint64_t offset, std::uint64_t alignment) {
+		return (offset + alignment - 1) & ~(alignment - 1);
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace MUtilities {
+
+/* Intern Table Class */
+
+// Thread-safe flyweight table mapping source strings to shared immutable objects parsed from them.
+// T must be constructible from std::string_view; parse errors propagate and are not cached.
+// tryGet additionally requires T to be default constructible.
+template<typename T> class InternTable {
+	public:
+		// [shared_ptr] Get the object parsed from str, parsing and storing it on first use
+		std::shared_ptr<const T> get(std::string_view str) {
+			{
+				std::shared_lock<std::shared_mutex> lock(this->mutex);
+				auto it = this->table.find(str);
+				if (it != this->table.end())
+					return it->second->value;
+			}
+
+			// Parse outside of the lock so that concurrent misses do not serialize
+			return this->insert(str, std::make_shared<const T>(str));
+		}
+
+		// [shared_ptr] Get the object parsed from str like get, parsing it with parse(str, T &out), which returns an
+		// error instead of throwing; on failure the error is set and null is returned
+		template<typename Parse> std::shared_ptr<const T> tryGet(std::string_view str, Parse parse,
+				const char *&error) {
+			{
+				std::shared_lock<std::shared_mutex> lock(this->mutex);
+				auto it = this->table.find(str);
+				if (it != this->table.end())
+					return it->second->value;
+			}
+
+			std::shared_ptr<T> value = std::make_shared<T>();
+			error = parse(str, *value);
+			if (error)
+				return nullptr;
+			return this->insert(str, std::move(value));
+		}
+
+		// [size_t] Get number of interned objects
+		std::size_t size() const {
+			std::shared_lock<std::shared_mutex> lock(this->mutex);
+			return this->table.size();
+		}
+
+		// [void] Drop all entries (objects still referenced elsewhere stay alive)
+		void clear() {
+			std::unique_lock<std::shared_mutex> lock(this->mutex);
+			this->table.clear();
+		}
+	private:
+		struct Entry {
+			std::string key;
+			std::shared_ptr<const T> value;
+		};
+
+		mutable std::shared_mutex mutex;
+		std::unordered_map<std::string_view, std::unique_ptr<Entry>> table;
+
+		// [shared_ptr] Store a parsed object, unless another thread stored one for str first
+		std::shared_ptr<const T> insert(std::string_view str, std::shared_ptr<const T> parsed) {
+			std::unique_ptr<Entry> entry(new Entry{std::string(str), std::move(parsed)});
+
+			std::unique_lock<std::shared_mutex> lock(this->mutex);
+			auto it = this->table.find(str);
+			if (it != this->table.end())
+				return it->second->value;
+
+			std::shared_ptr<const T> value = entry->value;
+			std::string_view key = entry->key; // Key views the string owned by the entry
+			this->table.emplace(key, std::move(entry));
+			return value;
+		}
+};
+
+}
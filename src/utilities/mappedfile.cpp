@@ -0,0 +1,57 @@
+#include "mappedfile.hpp"
+
+using namespace MUtilities;
+
+/* Mapped File Class */
+
+// [constructor] Map the file at path, faulting in every page if populate is set
+MappedFile::MappedFile(const std::string &path, bool populate) {
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		throw "MUtilities::MappedFile::openFailed";
+
+	struct stat st;
+	if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		::close(fd);
+		throw "MUtilities::MappedFile::openFailed";
+	}
+
+	// Zero-length mappings are invalid, so an empty file is left unmapped
+	if (st.st_size > 0) {
+		int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+		if (populate)
+			flags |= MAP_POPULATE; // Fault every page in with one call, as the whole file is usually read
+#endif
+		void *mapped = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, flags, fd, 0);
+		if (mapped == MAP_FAILED) {
+			::close(fd);
+			throw "MUtilities::MappedFile::openFailed";
+		}
+
+		this->_data = static_cast<const char *>(mapped);
+		this->_size = static_cast<std::size_t>(st.st_size);
+	}
+
+	// The mapping stays valid after the descriptor is closed
+	::close(fd);
+}
+
+// [destructor] Unmap the file
+MappedFile::~MappedFile() {
+	if (this->_data)
+		::munmap(const_cast<char *>(this->_data), this->_size);
+}
+
+// [pointer] Get the first byte of the file
+const char *MappedFile::data() const {
+	return this->_data;
+}
+// [size_t] Get the size of the file in bytes
+std::size_t MappedFile::size() const {
+	return this->_size;
+}
+// [string_view] Get the contents of the file
+std::string_view MappedFile::view() const {
+	return std::string_view(this->_data, this->_size);
+}
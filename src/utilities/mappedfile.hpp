@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace MUtilities {
+
+/* Mapped File Class */
+
+// Read-only memory mapping of a whole file, unmapped on destruction. The contents are not copied, so
+// they must not be changed on disk while the mapping is in use. By default every page is faulted in up
+// front; large files of which only parts are read should be mapped lazily instead.
+class MappedFile {
+	public:
+		MappedFile(const std::string &path, bool populate = true);
+		~MappedFile();
+
+		MappedFile(const MappedFile &) = delete;
+		MappedFile &operator = (const MappedFile &) = delete;
+
+		const char *data() const; // nullptr for an empty file
+		std::size_t size() const;
+		std::string_view view() const;
+	private:
+		const char *_data = nullptr;
+		std::size_t _size = 0;
+};
+
+}
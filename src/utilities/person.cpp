@@ -9,89 +9,254 @@ namespace MUtilities {
 		std::string email = "";
 		std::string url = "";
 
-		if (!a._email.empty())
-			email = " <" + a._email + ">";
+		if (!a._data->email.empty())
+			email = " <" + a._data->email + ">";
 
-		if (!a._url.empty())
-			url = " (" + a._url + ")";
+		if (!a._data->url.empty())
+			url = " (" + a._data->url + ")";
 
-		return strm << a._name << email << url;
+		return strm << a._data->name << email << url;
+	}
+}
+
+namespace {
+	// [bool] True if c is whitespace (\s)
+	bool isSpace(char c) {
+		return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+	}
+
+	// [bool] True if c is in the name character class [a-zA-Z\.\s]
+	bool isNameChar(char c) {
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '.' || isSpace(c);
+	}
+
+	// [bool] Match \s+\((.*?)\)$ against s, storing the url
+	bool matchUrl(std::string_view s, std::string_view &url) {
+		std::size_t i = 0;
+		while (i < s.size() && isSpace(s[i]))
+			i++;
+
+		if (i == 0 || s.size() < i + 2 || s[i] != '(' || s.back() != ')')
+			return false;
+
+		std::string_view u = s.substr(i + 1, s.size() - i - 2);
+		if (u.find_first_of("\n\r") != std::string_view::npos)
+			return false;
+
+		url = u;
+		return true;
+	}
+
+	// [bool] Match (?:\s+<(.*?)>)?(?:\s+\((.*?)\))?$ against s, storing email and url
+	bool matchContact(std::string_view s, std::string_view &email, std::string_view &url) {
+		email = url = std::string_view();
+
+		if (s.empty())
+			return true;
+
+		std::size_t i = 0;
+		while (i < s.size() && isSpace(s[i]))
+			i++;
+
+		// Email group, the shortest email for which the remainder matches wins
+		if (i > 0 && i < s.size() && s[i] == '<') {
+			for (std::size_t j = i + 1; j < s.size() && s[j] != '\n' && s[j] != '\r'; j++) {
+				if (s[j] != '>')
+					continue;
+
+				std::string_view rest = s.substr(j + 1);
+				if (rest.empty() || matchUrl(rest, url)) {
+					email = s.substr(i + 1, j - i - 1);
+					return true;
+				}
+			}
+		}
+
+		return matchUrl(s, url);
 	}
 }
 
 /* Person Class */
 
 // [constructor] JSON-based
-Person::Person(Json::Value obj) {
+Person::Person(const Json::Value &obj) {
+	if (const char *error = this->read(obj))
+		throw error;
+}
+
+// [constructor] String-based, "name <email> (url)" with email and url optional
+Person::Person(std::string_view str) {
+	if (const char *error = this->read(str))
+		throw error;
+}
+
+// [constructor] String-based
+Person::Person(const std::string &str) : Person(std::string_view(str)) {}
+
+// [constructor] Field-based, empty email or url means none
+Person::Person(std::string_view name, std::string_view email, std::string_view url) {
+	if (!Person::validName(name))
+		throw "MUtilities::Person::invalidName";
+
+	if (const char *error = this->assign(name, email, url))
+		throw error;
+}
+
+// [const char*] Parse a JSON person object without throwing; returns the error the constructor throws, or null
+// with out set
+const char *Person::parse(const Json::Value &obj, std::optional<Person> &out) {
+	Person p;
+	const char *error = p.read(obj);
+	if (!error)
+		out = std::move(p);
+	return error;
+}
+// [const char*] Parse "name <email> (url)" without throwing; returns the error the constructor throws, or null
+// with out set
+const char *Person::parse(std::string_view str, std::optional<Person> &out) {
+	Person p;
+	const char *error = p.read(str);
+	if (!error)
+		out = std::move(p);
+	return error;
+}
+
+// [const char*] Read a JSON person object; returns the error, if any
+const char *Person::read(const Json::Value &obj) {
+	const Json::Value &name = obj["name"];
+	const Json::Value &email = obj["email"];
+	const Json::Value &url = obj["url"];
+	std::string_view nameStr, emailStr, urlStr;
+	const char *begin, *end;
+
 	// if name is not null, ensure it is a string and use
-	if (!obj["name"].isNull()) {
-		if (!obj["name"].isString())
-			throw "MUtilities::Person::nameMustBeString";
+	if (!name.isNull()) {
+		if (!name.isString())
+			return "MUtilities::Person::nameMustBeString";
 
-		if (!std::regex_match(obj["name"].asString(), std::regex(R"(^([a-zA-Z\.\s]+?)$)")))
-			throw "MUtilities::Person::invalidName";
+		name.getString(&begin, &end);
+		nameStr = std::string_view(begin, end - begin);
 
-		this->_name = obj["name"].asString();
+		if (!Person::validName(nameStr))
+			return "MUtilities::Person::invalidName";
 	} else {
-		throw "MUtilities::Person::nameCannotBeNull";
+		return "MUtilities::Person::nameCannotBeNull";
 	}
 	// if email is not null, ensure it is a string and use
-	if (!obj["email"].isNull()) {
-		if (!obj["email"].isString())
-			throw "MUtilities::Person::emailMustBeString";
+	if (!email.isNull()) {
+		if (!email.isString())
+			return "MUtilities::Person::emailMustBeString";
 
-		this->_email = obj["email"].asString();
+		email.getString(&begin, &end);
+		emailStr = std::string_view(begin, end - begin);
 	}
 	// if url is not null, ensure it is a string and use
-	if (!obj["url"].isNull()) {
-		if (!obj["url"].isString())
-			throw "MUtilities::Person::urlMustBeString";
+	if (!url.isNull()) {
+		if (!url.isString())
+			return "MUtilities::Person::urlMustBeString";
 
-		this->_url = obj["url"].asString();
+		url.getString(&begin, &end);
+		urlStr = std::string_view(begin, end - begin);
 	}
 
-	// Validate all
-	this->validate();
+	return this->assign(nameStr, emailStr, urlStr);
 }
+// [const char*] Read "name <email> (url)"; returns the error, if any
+const char *Person::read(std::string_view str) {
+	std::string_view email, url;
 
-// [constructor] String-based
-Person::Person(std::string str) {
-	std::regex rgx(R"(^([a-zA-Z\.\s]+?)(?:\s+<(.*?)>)?(?:\s+\((.*?)\))?$)");
-	std::smatch match;
-
-	if (!str.empty() && std::regex_search(str, match, rgx)) {
-		this->_name = match[1];
-		this->_email = match[2];
-		this->_url = match[3];
-	} else {
-		throw "MUtilities::Person::invalidPersonString";
+	// The name is the shortest prefix of name characters for which the rest is a valid contact suffix
+	for (std::size_t n = 1; n <= str.size() && isNameChar(str[n - 1]); n++) {
+		if (matchContact(str.substr(n), email, url))
+			return this->assign(str.substr(0, n), email, url);
+	}
+
+	return "MUtilities::Person::invalidPersonString";
+}
+
+// [bool] Check that a name is non-empty and only uses letters, dots and whitespace
+bool Person::validName(std::string_view name) {
+	return !name.empty() && std::all_of(name.begin(), name.end(), isNameChar);
+}
+
+// [shared_ptr] Get the shared person parsed from the string, parsing it only on first use
+std::shared_ptr<const Person> Person::intern(std::string_view str) {
+	static InternTable<Person> table;
+	return table.get(str);
+}
+
+// [constructor] Person data from an interning key, "name\0email\0url"
+Person::data::data(std::string_view key) {
+	// Names can not contain '\0' and neither can valid urls, so the split is unambiguous
+	std::size_t first = key.find('\0');
+	std::size_t last = key.rfind('\0');
+
+	this->name = std::string(key.substr(0, first));
+	this->email = std::string(key.substr(first + 1, last - first - 1));
+	this->url = std::string(key.substr(last + 1));
+}
+
+// [Person] From fields that were validated before (e.g. read back from a cache), without checking them again
+Person Person::validated(std::string_view name, std::string_view email, std::string_view url) {
+	Person p;
+	p.share(name, email, url);
+	return p;
+}
+
+// [const char*] Validate email and url (name is already validated by the parser) and share interned data; returns
+// the error, if any, leaving the person unchanged
+const char *Person::assign(std::string_view name, std::string_view email, std::string_view url) {
+	// Ensure that email is valid if not empty
+	if (!email.empty()) {
+		if (!Validate::email(email))
+			return "MUtilities::Person::invalidEmail";
 	}
 
-	// Validate all
-	this->validate();
+	// Ensure that url is valid if not empty
+	if (!url.empty()) {
+		if (!Validate::url(url))
+			return "MUtilities::Person::invalidUrl";
+	}
+
+	this->share(name, email, url);
+	return nullptr;
+}
+
+// [void] Point at the interned data for these fields
+void Person::share(std::string_view name, std::string_view email, std::string_view url) {
+	static InternTable<data> table;
+	thread_local std::string key;
+
+	key.assign(name);
+	key.push_back('\0');
+	key.append(email);
+	key.push_back('\0');
+	key.append(url);
+
+	this->_data = table.get(key);
 }
 
 // [string] Get name
-std::string Person::name() const {
-	return this->_name;
+const std::string &Person::name() const {
+	return this->_data->name;
 }
 // [string] Get email
-std::string Person::email() const {
-	return this->_email;
+const std::string &Person::email() const {
+	return this->_data->email;
 }
 // [string] Get URL
-std::string Person::url() const {
-	return this->_url;
+const std::string &Person::url() const {
+	return this->_data->url;
 }
 
 // [bool] Equality operator overload using object
 bool Person::operator == (const Person &b) const {
-	return (this->_name == b._name) && (this->_email == b._email) && (this->_url == b._url);
+	// Person data is interned and never evicted, so equal people share the same instance
+	return this->_data == b._data;
 }
 // [bool] Equality operator overload using string
 bool Person::operator == (const std::string &b) const {
-	Person obj = Person(b);
-	return *this == obj;
+	return *this == *Person::intern(b);
 }
 // [bool] Equality operator overload using JSON object
 bool Person::operator == (const Json::Value &b) const {
@@ -104,26 +269,9 @@ bool Person::operator != (const Person &b) const {
 }
 // [bool] Inequality operator overload using string
 bool Person::operator != (const std::string &b) const {
-	Person obj = Person(b);
-	return *this != obj;
+	return !(*this == b);
 }
 // [bool] Inequality operator overload using JSON object
 bool Person::operator != (const Json::Value &b) const {
-	Person obj = Person(b);
-	return *this != obj;
-}
-
-// [void] Validate email and url (name is already validated by main regex)
-void Person::validate() {
-	// Ensure that email is valid if not empty
-	if (!this->_email.empty()) {
-		if (!Validate::email(this->_email))
-			throw "MUtilities::Person::invalidEmail";
-	}
-
-	// Ensure that url is valid if not empty
-	if (!this->_url.empty()) {
-		if (!Validate::url(this->_url))
-			throw "MUtilities::Person::invalidUrl";
-	}
+	return !(*this == b);
 }
@@ -2,23 +2,35 @@
 
 #include <json/json.h>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <algorithm>
 #include <cstddef>
-#include <regex>
+#include <memory>
+#include <optional>
 
 #include "validate.hpp"
+#include "intern.hpp"
 
 namespace MUtilities {
 
 class Person {
 	public:
-		Person(Json::Value obj);
-		Person(std::string str);
+		Person(const Json::Value &obj);
+		Person(std::string_view str);
+		Person(const std::string &str);
+		Person(std::string_view name, std::string_view email, std::string_view url);
 
-		std::string name() const;
-		std::string email() const;
-		std::string url() const;
+		// Parse without throwing, returning the error the constructor throws, or null with out set
+		static const char *parse(const Json::Value &obj, std::optional<Person> &out);
+		static const char *parse(std::string_view str, std::optional<Person> &out);
+		static std::shared_ptr<const Person> intern(std::string_view str);
+		static bool validName(std::string_view name);
+		static Person validated(std::string_view name, std::string_view email, std::string_view url);
+
+		const std::string &name() const;
+		const std::string &email() const;
+		const std::string &url() const;
 
 		// Operator overlodas
 		friend std::ostream& operator << (std::ostream &strm, Person &a); // Ostream
@@ -29,11 +41,25 @@ class Person {
 		bool operator != (const std::string &b) const; // Inequality with string
 		bool operator != (const Json::Value &b) const; // Inequality with JSON object
 	private:
-		std::string _name = "";
-		std::string _email = "";
-		std::string _url = "";
+		/* Person Data Class */
+		class data {
+			public:
+				data(std::string_view key);
+
+				std::string name;
+				std::string email;
+				std::string url;
+		};
+
+		// Interned, so people with the same name, email and url share one instance
+		std::shared_ptr<const data> _data;
+
+		Person() = default;
 
-		void validate();
+		const char *read(const Json::Value &obj);
+		const char *read(std::string_view str);
+		const char *assign(std::string_view name, std::string_view email, std::string_view url);
+		void share(std::string_view name, std::string_view email, std::string_view url);
 };
 
 }
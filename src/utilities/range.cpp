@@ -2,90 +2,514 @@
 
 using namespace MUtilities;
 
+namespace {
+	typedef MUtilities::Range::interval interval;
+
+	// [InternTable] Get the table shared by Range::intern and Range::tryIntern
+	MUtilities::InternTable<MUtilities::Range> &ranges() {
+		static MUtilities::InternTable<MUtilities::Range> table;
+		return table;
+	}
+
+	// [int] Order lower bounds: unbounded first, then by version, inclusive before exclusive
+	int compareLower(const interval &a, const interval &b) {
+		if (!a.hasLower || !b.hasLower)
+			return (a.hasLower ? 1 : 0) - (b.hasLower ? 1 : 0);
+
+		int c = a.lower.compare(b.lower);
+		if (c != 0)
+			return c;
+
+		return (a.lowerInclusive ? 0 : 1) - (b.lowerInclusive ? 0 : 1);
+	}
+
+	// [int] Order upper bounds: by version, exclusive before inclusive, then unbounded last
+	int compareUpper(const interval &a, const interval &b) {
+		if (!a.hasUpper || !b.hasUpper)
+			return (a.hasUpper ? 0 : 1) - (b.hasUpper ? 0 : 1);
+
+		int c = a.upper.compare(b.upper);
+		if (c != 0)
+			return c;
+
+		return (a.upperInclusive ? 1 : 0) - (b.upperInclusive ? 1 : 0);
+	}
+
+	// [bool] Check if b (which does not start before a) overlaps or directly follows a
+	bool touches(const interval &a, const interval &b) {
+		if (!a.hasUpper || !b.hasLower)
+			return true;
+
+		int c = b.lower.compare(a.upper);
+		return c < 0 || (c == 0 && (b.lowerInclusive || a.upperInclusive));
+	}
+
+	// [void] Raise the lower bound of an interval if the new bound is tighter
+	void tightenLower(interval &iv, const Version &v, bool inclusive) {
+		interval bound;
+		bound.hasLower = true;
+		bound.lower = v;
+		bound.lowerInclusive = inclusive;
+
+		if (compareLower(bound, iv) > 0) {
+			iv.hasLower = true;
+			iv.lower = v;
+			iv.lowerInclusive = inclusive;
+		}
+	}
+
+	// [void] Lower the upper bound of an interval if the new bound is tighter
+	void tightenUpper(interval &iv, const Version &v, bool inclusive) {
+		interval bound;
+		bound.hasUpper = true;
+		bound.upper = v;
+		bound.upperInclusive = inclusive;
+
+		if (compareUpper(bound, iv) < 0) {
+			iv.hasUpper = true;
+			iv.upper = v;
+			iv.upperInclusive = inclusive;
+		}
+	}
+}
+
+// Define within MUtilities namespace.
+namespace MUtilities {
+	// [std::ostream&] Ostream operator overload using object
+	std::ostream& operator << (std::ostream &strm, Range &a) {
+		return strm << a.str();
+	}
+}
+
 /* Version Range Class */
 
-// [constructor] Parse range into comparator sets
-Range::Range(std::string range) {
-	std::string last = "";
-	// Loop through characters of range string
-	for (std::string::size_type i = 0; i < range.size(); ++i) {
+// [constructor] Empty range
+Range::Range() {
+	// All empty ranges share one immutable instance
+	static const std::shared_ptr<const data> empty = std::make_shared<const data>();
+	this->_data = empty;
+}
+// [constructor] Union of intervals in any order
+Range::Range(std::vector<interval> intervals) {
+	std::shared_ptr<data> d = std::make_shared<data>();
+	d->intervals = normalize(std::move(intervals));
+	decompile(*d);
+	this->_data = d;
+}
+// [Range] Range satisfied by every version
+Range Range::all() {
+	// Shared like the empty range
+	static const std::shared_ptr<const data> any = []() {
+		std::shared_ptr<data> d = std::make_shared<data>();
+		d->intervals.push_back(interval());
+		decompile(*d);
+		return d;
+	}();
+	return Range(any);
+}
+// [constructor] From already compiled data
+Range::Range(std::shared_ptr<const data> d): _data(std::move(d)) {}
+
+// [constructor] From a range string, throwing on malformed input
+Range::Range(std::string_view range) {
+	std::shared_ptr<data> d = std::make_shared<data>();
+	std::string_view malformed; // Comparator named by the exception
+	const char *error = Range::lex(range, *d, malformed);
+
+	if (error && !malformed.empty())
+		throw std::string(error) + "\n\t\"" + std::string(malformed) + "\"";
+	if (error)
+		throw error;
+
+	compile(*d);
+	this->_data = d;
+}
+
+// [const char*] Parse a range string without throwing; returns the error Range(range) throws, or null with out set
+const char *Range::parse(std::string_view range, Range &out) {
+	std::shared_ptr<data> d = std::make_shared<data>();
+	std::string_view malformed;
+	const char *error = Range::lex(range, *d, malformed);
+	if (error)
+		return error;
+
+	compile(*d);
+	out._data = d;
+	return nullptr;
+}
+
+// [const char*] Lex range into comparator sets separated by logical ORs (||); on error, returns it, along with the
+// malformed comparator if there is one
+const char *Range::lex(std::string_view range, data &d, std::string_view &malformed) {
+	std::string_view::size_type start = std::string_view::npos; // Start of the current set, if any
+	bool half = false; // Whether the last character was the first half of a logical or operator
+
+	for (std::string_view::size_type i = 0; i < range.size(); ++i) {
 		char c = range[i];
+		bool end = (i == range.size() - 1);
 
-		// if the last character is the beginning of a logical or operator, require next character to finish
-		if (last == "|" && c == '|') {
-			last = "";
-		} else if (last == "|" && c != '|') { // else if | and char is not |, error
-			throw "MUtilities::Range::invalidRange";
-		} else { // else, treat character normally
-			// Ensure that if last is empty the character is not whitespace
-			if (!last.empty() || !std::isspace(c)) {
-				// Check if character is the beginning of a logical or operator
-				if (c == '|' || (i == (range.size() - 1))) {
-					if (i == (range.size() - 1)) last += c;
-					// if last is not empty, create a comparator set and add to list
-					if (!last.empty()) {
-						this->sets.push_back(Range::set(last));
-					}
-					last = "|"; // Reset last to a half logical or operator
-				} else { // else, append character to last
-					last += c;
-				}
+		// if the last character began a logical or operator, require this one to finish it
+		if (half) {
+			if (c != '|')
+				return "MUtilities::Range::invalidRange";
+			half = false;
+		// else if no set has begun, skip leading whitespace
+		} else if (start == std::string_view::npos && std::isspace(static_cast<unsigned char>(c))) {
+			continue;
+		// else if this ends a set, lex it (the final character of the range belongs to the set)
+		} else if (c == '|' || end) {
+			if (end && start == std::string_view::npos)
+				start = i;
+			if (start != std::string_view::npos) {
+				d.sets.emplace_back();
+				const char *error = set::lex(range.substr(start, (end ? range.size() : i) - start), d.sets.back(),
+					malformed);
+				if (error)
+					return error;
 			}
+
+			start = std::string_view::npos;
+			half = true;
+		} else if (start == std::string_view::npos) {
+			start = i;
 		}
 	}
+
+	return nullptr;
 }
 
-// [bool] Loop through comparator sets in attempt to find one that is satisfied by the version
-bool Range::satisfiedBy(Version version) {
-	for (auto const &cs: this->sets) {
-		if (cs.satisfiedBy(version))
+// [bool] Binary search the compiled intervals for the one that could contain the version
+bool Range::satisfiedBy(const Version &version) const {
+	// Find the first interval starting above the version; only its predecessor can contain it
+	auto it = std::upper_bound(this->_data->intervals.begin(), this->_data->intervals.end(), version,
+		[](const Version &v, const interval &iv) {
+			if (!iv.hasLower)
+				return false;
+			int c = v.compare(iv.lower);
+			return c < 0 || (c == 0 && !iv.lowerInclusive);
+		});
+
+	if (it == this->_data->intervals.begin())
+		return false;
+
+	return (it - 1)->contains(version);
+}
+// [bool] Convert version string to a version object and check if it satisfies
+bool Range::satisfiedBy(const std::string &version) const {
+	return this->satisfiedBy(Version(version));
+}
+
+// [Range] Get the range satisfied by versions that satisfy both ranges
+Range Range::intersect(const Range &b) const {
+	std::shared_ptr<data> d = std::make_shared<data>();
+	std::vector<interval>::size_type i = 0;
+	std::vector<interval>::size_type j = 0;
+
+	// Sweep both sorted interval lists, advancing whichever interval ends first
+	while (i < this->_data->intervals.size() && j < b._data->intervals.size()) {
+		const interval &x = this->_data->intervals[i];
+		const interval &y = b._data->intervals[j];
+		const interval &lower = (compareLower(x, y) >= 0) ? x : y;
+		const interval &upper = (compareUpper(x, y) <= 0) ? x : y;
+
+		interval iv;
+		iv.hasLower = lower.hasLower;
+		iv.lower = lower.lower;
+		iv.lowerInclusive = lower.lowerInclusive;
+		iv.hasUpper = upper.hasUpper;
+		iv.upper = upper.upper;
+		iv.upperInclusive = upper.upperInclusive;
+
+		if (!iv.empty())
+			d->intervals.push_back(iv);
+
+		if (&upper == &x)
+			i++;
+		else
+			j++;
+	}
+
+	decompile(*d);
+	return Range(d);
+}
+
+// [Range] Get the range satisfied by versions that satisfy either range
+Range Range::unite(const Range &b) const {
+	std::shared_ptr<data> d = std::make_shared<data>();
+	std::vector<interval> list = this->_data->intervals;
+	list.insert(list.end(), b._data->intervals.begin(), b._data->intervals.end());
+
+	d->intervals = normalize(list);
+	decompile(*d);
+	return Range(d);
+}
+
+// [Range] Get the range of versions not satisfying this range
+Range Range::complement() const {
+	std::shared_ptr<data> d = std::make_shared<data>();
+	const interval *prev = nullptr;
+
+	// Collect the gap before each interval, then the one after the last
+	for (auto const &iv: this->_data->intervals) {
+		if (iv.hasLower) {
+			interval gap;
+			if (prev) {
+				gap.hasLower = true;
+				gap.lower = prev->upper;
+				gap.lowerInclusive = !prev->upperInclusive;
+			}
+			gap.hasUpper = true;
+			gap.upper = iv.lower;
+			gap.upperInclusive = !iv.lowerInclusive;
+
+			if (!gap.empty())
+				d->intervals.push_back(gap);
+		}
+
+		if (!iv.hasUpper)
+			break;
+		prev = &iv;
+	}
+
+	if (this->_data->intervals.empty() || this->_data->intervals.back().hasUpper) {
+		interval gap;
+		if (prev) {
+			gap.hasLower = true;
+			gap.lower = prev->upper;
+			gap.lowerInclusive = !prev->upperInclusive;
+		}
+		d->intervals.push_back(gap);
+	}
+
+	decompile(*d);
+	return Range(d);
+}
+
+// [bool] Check if no version satisfies the range
+bool Range::empty() const {
+	return this->_data->intervals.empty();
+}
+
+// [bool] Check if every version satisfying this range satisfies b
+bool Range::subsetOf(const Range &b) const {
+	const std::vector<interval> &bIntervals = b._data->intervals;
+
+	// Intervals of b are disjoint and never adjacent, so each interval must lie within a single one of them
+	for (auto const &x: this->_data->intervals) {
+		auto it = std::upper_bound(bIntervals.begin(), bIntervals.end(), x, [](const interval &v, const interval &iv) {
+			return compareLower(v, iv) < 0;
+		});
+
+		if (it == bIntervals.begin() || compareUpper(x, *(it - 1)) > 0)
+			return false;
+	}
+
+	return true;
+}
+
+// [bool] Check if some version satisfies both ranges
+bool Range::intersects(const Range &b) const {
+	std::vector<interval>::size_type i = 0;
+	std::vector<interval>::size_type j = 0;
+
+	// The same sweep as intersect, stopping at the first overlap
+	while (i < this->_data->intervals.size() && j < b._data->intervals.size()) {
+		const interval &x = this->_data->intervals[i];
+		const interval &y = b._data->intervals[j];
+		const interval &lower = (compareLower(x, y) >= 0) ? x : y;
+		const interval &upper = (compareUpper(x, y) <= 0) ? x : y;
+
+		interval iv;
+		iv.hasLower = lower.hasLower;
+		iv.lower = lower.lower;
+		iv.lowerInclusive = lower.lowerInclusive;
+		iv.hasUpper = upper.hasUpper;
+		iv.upper = upper.upper;
+		iv.upperInclusive = upper.upperInclusive;
+
+		if (!iv.empty())
 			return true;
+
+		if (&upper == &x)
+			i++;
+		else
+			j++;
 	}
 
 	return false;
 }
-// [bool] Convert version string to a version object and check if it satisfies
-bool Range::satisfiedBy(std::string version) {
-	return this->satisfiedBy(Version(version));
+
+// [shared_ptr] Get the shared immutable range parsed from the string, parsing it only on first use
+std::shared_ptr<const Range> Range::intern(std::string_view range) {
+	return ranges().get(range);
+}
+// [shared_ptr] Get the shared range like intern, without throwing; on malformed input, sets the error and returns
+// null (without naming the malformed comparator, as intern's exception does)
+std::shared_ptr<const Range> Range::tryIntern(std::string_view range, const char *&error) {
+	return ranges().tryGet(range, Range::parse, error);
+}
+
+// [vector of intervals] Get sorted, disjoint intervals satisfying the range
+const std::vector<Range::interval> &Range::intervals() const {
+	return this->_data->intervals;
+}
+
+// [string] Format comparator sets as "op version op version || ..."
+std::string Range::str() const {
+	std::string out;
+
+	for (auto const &s: this->_data->sets) {
+		if (&s != &this->_data->sets.front())
+			out += " || ";
+
+		// A set without comparators is satisfied by every version
+		if (s.comparators.empty())
+			out += "*";
+
+		for (auto const &c: s.comparators) {
+			if (&c != &s.comparators.front())
+				out += " ";
+
+			switch (c.oper) {
+				case Operator::lessThan: out += "<"; break;
+				case Operator::lessThanOrEqual: out += "<="; break;
+				case Operator::greaterThan: out += ">"; break;
+				case Operator::greaterThanOrEqual: out += ">="; break;
+				case Operator::equal: break;
+			}
+
+			out += c.version.str();
+		}
+	}
+
+	return out;
 }
 
-// [Version] Find the highest version in the vector of objects that satisfies the range
-Version Range::maxSatisfiedBy(std::vector<Version> versions) {
-	int highest = -1;
-	for (int i = 0; i != versions.size(); i++) {
-		if ((highest == -1 || versions[i] > versions[highest]) && this->satisfiedBy(versions[i]))
-			highest = i;
+// [Version] Find the highest version in the vector of objects that satisfies the range (0.0.0 if none does)
+Version Range::maxSatisfiedBy(const std::vector<Version> &versions) const {
+	const Version *highest = nullptr;
+	for (auto const &v: versions) {
+		if ((highest == nullptr || v > *highest) && this->satisfiedBy(v))
+			highest = &v;
 	}
 
-	return versions[highest];
+	if (highest == nullptr)
+		return Version("0.0.0");
+
+	return *highest;
 }
-// [Version] Convert version strings to version objects and find the highest that satisfies the range
-Version Range::maxSatisfiedBy(std::vector<std::string> versions) {
-	std::vector<Version> passVec;
-	// Convert strings to version objects
+// [Version] Find the highest version string that satisfies the range, parsing each distinct string once
+Version Range::maxSatisfiedBy(const std::vector<std::string> &versions) const {
+	std::shared_ptr<const Version> highest;
 	for (auto const &s: versions) {
-		passVec.push_back(Version(s));
+		std::shared_ptr<const Version> v = Version::intern(s);
+		if ((!highest || *v > *highest) && this->satisfiedBy(*v))
+			highest = v;
+	}
+
+	if (!highest)
+		return Version("0.0.0");
+
+	return *highest;
+}
+
+// [void] Compile comparator sets into sorted, disjoint intervals
+void Range::compile(data &d) {
+	std::vector<interval> list;
+
+	for (auto const &s: d.sets) {
+		interval iv;
+		for (auto const &c: s.comparators) {
+			switch (c.oper) {
+				case Operator::lessThan:
+				case Operator::lessThanOrEqual:
+					tightenUpper(iv, c.version, c.oper == Operator::lessThanOrEqual);
+					break;
+				case Operator::greaterThan:
+				case Operator::greaterThanOrEqual:
+					tightenLower(iv, c.version, c.oper == Operator::greaterThanOrEqual);
+					break;
+				case Operator::equal:
+					tightenLower(iv, c.version, true);
+					tightenUpper(iv, c.version, true);
+					break;
+			}
+		}
+		list.push_back(iv);
+	}
+
+	d.intervals = normalize(list);
+}
+
+// [void] Rebuild comparator sets from the intervals (one set per interval)
+void Range::decompile(data &d) {
+	d.sets.clear();
+
+	for (auto const &iv: d.intervals) {
+		set s;
+		if (iv.hasLower && iv.hasUpper && iv.lowerInclusive && iv.upperInclusive && iv.lower == iv.upper) {
+			s.comparators.push_back(comparator(Operator::equal, iv.lower));
+		} else {
+			if (iv.hasLower)
+				s.comparators.push_back(comparator(iv.lowerInclusive ? Operator::greaterThanOrEqual : Operator::greaterThan,
+					iv.lower));
+			if (iv.hasUpper)
+				s.comparators.push_back(comparator(iv.upperInclusive ? Operator::lessThanOrEqual : Operator::lessThan,
+					iv.upper));
+		}
+		d.sets.push_back(s);
+	}
+}
+
+// [vector of intervals] Drop empty intervals, sort by lower bound, and merge overlapping or adjacent ones
+std::vector<Range::interval> Range::normalize(std::vector<interval> list) {
+	list.erase(std::remove_if(list.begin(), list.end(), [](const interval &iv) { return iv.empty(); }), list.end());
+	std::sort(list.begin(), list.end(), [](const interval &a, const interval &b) {
+		return compareLower(a, b) < 0;
+	});
+
+	std::vector<interval> out;
+	for (auto const &iv: list) {
+		if (!out.empty() && touches(out.back(), iv)) {
+			if (compareUpper(iv, out.back()) > 0) {
+				out.back().hasUpper = iv.hasUpper;
+				out.back().upper = iv.upper;
+				out.back().upperInclusive = iv.upperInclusive;
+			}
+		} else {
+			out.push_back(iv);
+		}
 	}
-	return this->maxSatisfiedBy(passVec);
+
+	return out;
 }
 
 // [bool] Equality operator overload using object
 bool Range::operator == (const Range &b) const {
-	for (std::vector<set>::size_type i = 0; i != this->sets.size(); i++) {
-		// Ensure b has the same number of sets as this
-		if (this->sets.size() != b.sets.size()) {
+	// Ranges sharing compiled data (e.g. interned) are trivially equal
+	if (this->_data == b._data) {
+		return true;
+	}
+
+	const std::vector<set> &sets = this->_data->sets;
+	const std::vector<set> &bSets = b._data->sets;
+
+	// Ensure b has the same number of sets as this
+	if (sets.size() != bSets.size()) {
+		return false;
+	}
+
+	for (std::vector<set>::size_type i = 0; i != sets.size(); i++) {
+		const set &s = sets[i];
+
+		// Ensure b has the same number of comparators as this
+		if (s.comparators.size() != bSets[i].comparators.size()) {
 			return false;
 		}
 
-		set s = this->sets[i];
 		for (std::vector<comparator>::size_type j = 0; j != s.comparators.size(); j++) {
-			// Ensure b has the same number of comparators as this
-			if (s.comparators.size() != b.sets[i].comparators.size()) {
-				return false;
-			}
-
-			comparator c = s.comparators[j];
-			comparator bc = b.sets[i].comparators[j];
+			const comparator &c = s.comparators[j];
+			const comparator &bc = bSets[i].comparators[j];
 
 			if (c.oper != bc.oper || c.version != bc.version) {
 				return false;
@@ -112,68 +536,125 @@ bool Range::operator != (const std::string &b) const {
 
 /* Version Comparator Set Class */
 
-// [constructor] Parse comparator set into individual comparators
-Range::set::set(std::string s) {
-	std::string last = "";
-	// Loop through characters of comparator set string
-	for (std::string::size_type i = 0; i < s.size(); ++i) {
+// [constructor] Empty set
+Range::set::set() {}
+// [const char*] Lex comparator set into individual comparators separated by single spaces; on error, returns it,
+// along with the malformed comparator if there is one
+const char *Range::set::lex(std::string_view s, set &out, std::string_view &malformed) {
+	std::string_view::size_type start = std::string_view::npos; // Start of the current comparator, if any
+
+	// A lone asterisk matches every version, which a set without comparators does
+	std::string_view::size_type first = s.find_first_not_of(" \t\n\r\f\v");
+	if (first != std::string_view::npos && s[first] == '*' &&
+			s.find_first_not_of(" \t\n\r\f\v", first + 1) == std::string_view::npos)
+		return nullptr;
+
+	for (std::string_view::size_type i = 0; i < s.size(); ++i) {
 		char c = s[i];
+		bool end = (i == s.size() - 1);
+
+		// if c is a space ending a comparator or the last character (which belongs to it), lex the comparator
+		if ((c == ' ' && start != std::string_view::npos) || end) {
+			if (start == std::string_view::npos)
+				start = i;
 
-		// if c is a space and last is not empty or last index, create comparator object and add to list
-		if ((c == ' ' && !last.empty()) || (i == (s.size() - 1))) {
-			if (i == (s.size() - 1)) last += c;
-			this->comparators.push_back(Range::comparator(last));
-			last = "";
-		// else if last is not empty or character is not whitespace, add to last
-		} else if ((!last.empty() || !std::isspace(c))) {
-			last += c;
+			std::string_view comp = s.substr(start, (end ? s.size() : i) - start);
+			out.comparators.emplace_back();
+			const char *error = Range::comparator::lex(comp, out.comparators.back());
+			if (error) {
+				if (error == Range::comparator::invalidComparatorString)
+					malformed = comp;
+				return error;
+			}
+			start = std::string_view::npos;
+		// else if a comparator has begun or character is not whitespace, extend the comparator
+		} else if (start != std::string_view::npos || !std::isspace(static_cast<unsigned char>(c))) {
+			if (start == std::string_view::npos)
+				start = i;
 		} else {
-			throw "MUtilities::Range::set::invalidComparatorSet";
+			return "MUtilities::Range::set::invalidComparatorSet";
 		}
 	}
+
+	return nullptr;
 }
 
-// [bool] Loop through comparators and ensure that all are satisfied by the version
-bool Range::set::satisfiedBy(const Version version) const {
-	for (auto const &c: this->comparators) {
-		if (!c.satisfiedBy(version))
-			return false;
+/* Version Comparator Class */
+
+const char *const Range::comparator::invalidComparatorString = "MUtilities::Range::comparator::invalidComparatorString";
+
+// [constructor] Equal to the default version, to be lexed into
+Range::comparator::comparator(): oper(Operator::equal) {}
+// [const char*] Lex comparator into an operator (>, <, <=, >=, =, or none for =) and a version; returns the error,
+// if any
+const char *Range::comparator::lex(std::string_view comp, comparator &out) {
+	std::string_view::size_type i = 0;
+	auto isSpace = [&comp](std::string_view::size_type j) {
+		return std::isspace(static_cast<unsigned char>(comp[j]));
+	};
+
+	// Skip leading whitespace
+	while (i < comp.size() && isSpace(i))
+		i++;
+
+	// Read operator
+	out.oper = Operator::equal;
+	if (i < comp.size() && (comp[i] == '<' || comp[i] == '>')) {
+		bool orEqual = (i + 1 < comp.size() && comp[i + 1] == '=');
+		if (comp[i] == '<')
+			out.oper = orEqual ? Operator::lessThanOrEqual : Operator::lessThan;
+		else
+			out.oper = orEqual ? Operator::greaterThanOrEqual : Operator::greaterThan;
+		i += orEqual ? 2 : 1;
+	} else if (i < comp.size() && comp[i] == '=') {
+		i++;
 	}
 
-	return true;
+	// Read version, comprising word characters, dots, hyphens, and plus signs
+	std::string_view::size_type begin = i;
+	while (i < comp.size() && (std::isalnum(static_cast<unsigned char>(comp[i])) || comp[i] == '_' ||
+			comp[i] == '.' || comp[i] == '-' || comp[i] == '+'))
+		i++;
+	std::string_view::size_type length = i - begin;
+
+	// Skip trailing whitespace, after which nothing may remain
+	while (i < comp.size() && isSpace(i))
+		i++;
+
+	if (length == 0 || i != comp.size())
+		return comparator::invalidComparatorString;
+
+	Version::ParseError error = Version::parse(comp.substr(begin, length), out.version);
+	return (error == Version::ParseError::none) ? nullptr : Version::errorString(error);
 }
 
-/* Version Comparator Class */
+// [constructor] From an operator and a version
+Range::comparator::comparator(Operator o, const Version &v): oper(o), version(v) {}
 
-// [constructor] Parse comparator into an operator and a version
-Range::comparator::comparator(std::string comp) {
-	std::regex rgx(R"(^\s*(>|<|<=|>=|=|)([\w\.\-\+]+)\s*$)");
-	std::smatch match;
+/* Version Interval Class */
 
-	if (std::regex_search(comp, match, rgx)) {
-		if (match[1] == "") {
-			this->oper = "=";
-		} else {
-			this->oper = match[1];
-		}
-		this->version = Version(match[2]);
-	} else {
-		throw "MUtilities::Range::comparator::invalidComparatorString\n\t\"" + comp + "\"";
+// [bool] Check if the version lies within the interval bounds
+bool Range::interval::contains(const Version &v) const {
+	if (this->hasLower) {
+		int c = v.compare(this->lower);
+		if (c < 0 || (c == 0 && !this->lowerInclusive))
+			return false;
+	}
+
+	if (this->hasUpper) {
+		int c = v.compare(this->upper);
+		if (c > 0 || (c == 0 && !this->upperInclusive))
+			return false;
 	}
+
+	return true;
 }
 
-// [bool] Check if comparator is satisfied by the version
-bool Range::comparator::satisfiedBy(Version v) const {
-	if (this->oper == "<")
-		return v < this->version;
-	else if (this->oper == "<=")
-		return v <= this->version;
-	else if (this->oper == ">")
-		return v > this->version;
-	else if (this->oper == ">=")
-		return v >= this->version;
-	else if (this->oper == "=")
-		return v == this->version;
+// [bool] Check if no version can lie within the interval bounds
+bool Range::interval::empty() const {
+	if (!this->hasLower || !this->hasUpper)
+		return false;
 
-	return false;
+	int c = this->lower.compare(this->upper);
+	return c > 0 || (c == 0 && !(this->lowerInclusive && this->upperInclusive));
 }
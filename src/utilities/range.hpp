@@ -1,24 +1,59 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <iostream>
-#include <regex>
+#include <algorithm>
+#include <cctype>
+#include <memory>
 
 #include "version.hpp"
+#include "intern.hpp"
 
 namespace MUtilities {
 	/* Version Range Class */
 	class Range {
 		public:
-			//Range();
-			Range(std::string range);
+			Range(); // Empty range, satisfied by no version
+			Range(std::string_view range);
 
-			bool satisfiedBy(Version version);
-			bool satisfiedBy(std::string version);
+			static Range all(); // Satisfied by every version, as parsed from "*"
 
-			Version maxSatisfiedBy(std::vector<Version> versions);
-			Version maxSatisfiedBy(std::vector<std::string> versions);
+			/* Version Interval Class */
+			class interval {
+				public:
+					Version lower;
+					Version upper;
+					bool hasLower = false; // false if unbounded below
+					bool hasUpper = false; // false if unbounded above
+					bool lowerInclusive = false;
+					bool upperInclusive = false;
+
+					bool contains(const Version &v) const;
+					bool empty() const;
+			};
+
+			Range(std::vector<interval> intervals); // Union of the intervals
+
+			bool satisfiedBy(const Version &version) const;
+			bool satisfiedBy(const std::string &version) const;
+
+			static const char *parse(std::string_view range, Range &out); // Null, or the error the constructor throws
+			static std::shared_ptr<const Range> intern(std::string_view range);
+			static std::shared_ptr<const Range> tryIntern(std::string_view range, const char *&error); // Null on error
+
+			Range intersect(const Range &b) const;
+			Range unite(const Range &b) const;
+			Range complement() const;
+			bool empty() const;
+			bool subsetOf(const Range &b) const;
+			bool intersects(const Range &b) const;
+			const std::vector<interval> &intervals() const;
+			std::string str() const; // Range string, parses back to an equal range
+
+			Version maxSatisfiedBy(const std::vector<Version> &versions) const;
+			Version maxSatisfiedBy(const std::vector<std::string> &versions) const;
 
 			// Operator overloads
 			friend std::ostream& operator << (std::ostream &strm, Range &a); // Ostream
@@ -27,25 +62,55 @@ namespace MUtilities {
 			bool operator != (const Range &b) const; // Inequality using object
 			bool operator != (const std::string &b) const; // Inequality using string
 		private:
+			// Comparator operators
+			enum class Operator {
+				lessThan,
+				lessThanOrEqual,
+				greaterThan,
+				greaterThanOrEqual,
+				equal
+			};
+
 			/* Version Comparator Class */
 			class comparator {
 				public:
-					comparator(std::string c);
-					bool satisfiedBy(Version v) const;
+					comparator();
+					comparator(Operator o, const Version &v);
+
+					static const char *const invalidComparatorString;
+					static const char *lex(std::string_view comp, comparator &out);
 
-					std::string oper;
+					Operator oper;
 					Version version;
 			};
 
 			/* Version Comparator Set Class */
 			class set {
 				public:
-					set(std::string s);
-					bool satisfiedBy(const Version version) const;
+					set();
+					static const char *lex(std::string_view s, set &out, std::string_view &malformed);
+
 					std::vector<comparator> comparators;
 			};
 
-			// List of comparator sets as parsed by constructor
-			std::vector<set> sets;
+			/* Range Data Class */
+			class data {
+				public:
+					// List of comparator sets as parsed by constructor
+					std::vector<set> sets;
+					// Sorted, disjoint intervals compiled from the comparator sets
+					std::vector<interval> intervals;
+			};
+
+			// Immutable once constructed, so copies of a range share it
+			std::shared_ptr<const data> _data;
+
+			Range(std::shared_ptr<const data> d);
+
+			static const char *lex(std::string_view range, data &d, std::string_view &malformed);
+
+			static void compile(data &d);
+			static void decompile(data &d);
+			static std::vector<interval> normalize(std::vector<interval> list);
 	};
 }
@@ -0,0 +1,107 @@
+#include "threadpool.hpp"
+
+using namespace MUtilities;
+
+/* Thread Pool Class */
+
+// [constructor] Start the worker threads
+ThreadPool::ThreadPool(std::size_t threads) {
+	if (threads == 0)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+
+	this->_workers.reserve(threads);
+	for (std::size_t i = 0; i < threads; i++)
+		this->_workers.emplace_back(&ThreadPool::work, this);
+}
+
+// [destructor] Finish queued tasks and join the workers
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(this->_mutex);
+		this->_stopping = true;
+	}
+
+	this->_available.notify_all();
+	for (auto &worker: this->_workers)
+		worker.join();
+}
+
+// [void] Queue a task
+void ThreadPool::submit(std::function<void()> task) {
+	{
+		std::lock_guard<std::mutex> lock(this->_mutex);
+		this->_tasks.push_back(std::move(task));
+		this->_pending++;
+	}
+
+	this->_available.notify_one();
+}
+
+// [void] Block until every submitted task has finished, rethrowing the first exception one of them threw
+void ThreadPool::wait() {
+	std::unique_lock<std::mutex> lock(this->_mutex);
+	this->_idle.wait(lock, [this]() { return this->_pending == 0; });
+
+	if (this->_error) {
+		std::exception_ptr error = this->_error;
+		this->_error = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+// [void] Run body over [0, count) split into chunks of at least grain indices, and wait for it
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t begin, std::size_t end)> &body,
+		std::size_t grain) {
+	if (count == 0)
+		return;
+
+	// Chunks are claimed dynamically, so uneven work still balances across workers
+	std::size_t chunk = std::max(grain, count / (this->_workers.size() * 8) + 1);
+	std::atomic<std::size_t> next(0);
+	std::size_t tasks = std::min(this->_workers.size(), (count + chunk - 1) / chunk);
+
+	for (std::size_t t = 0; t < tasks; t++) {
+		this->submit([&]() {
+			std::size_t begin;
+			while ((begin = next.fetch_add(chunk, std::memory_order_relaxed)) < count)
+				body(begin, std::min(begin + chunk, count));
+		});
+	}
+
+	this->wait();
+}
+
+// [size_t] Get number of worker threads
+std::size_t ThreadPool::size() const {
+	return this->_workers.size();
+}
+
+// [void] Worker loop
+void ThreadPool::work() {
+	while (true) {
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock(this->_mutex);
+			this->_available.wait(lock, [this]() { return this->_stopping || !this->_tasks.empty(); });
+
+			if (this->_tasks.empty())
+				return;
+
+			task = std::move(this->_tasks.front());
+			this->_tasks.pop_front();
+		}
+
+		try {
+			task();
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(this->_mutex);
+			if (!this->_error)
+				this->_error = std::current_exception();
+		}
+
+		std::lock_guard<std::mutex> lock(this->_mutex);
+		if (--this->_pending == 0)
+			this->_idle.notify_all();
+	}
+}
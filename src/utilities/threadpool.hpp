@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+
+namespace MUtilities {
+
+/* Thread Pool Class */
+
+// Fixed set of worker threads running submitted tasks in FIFO order. Tasks must not wait on the pool.
+class ThreadPool {
+	public:
+		ThreadPool(std::size_t threads = 0); // 0 uses one thread per hardware thread
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool &operator = (const ThreadPool &) = delete;
+
+		void submit(std::function<void()> task);
+		void wait();
+		void parallelFor(std::size_t count, const std::function<void(std::size_t begin, std::size_t end)> &body,
+			std::size_t grain = 1);
+
+		std::size_t size() const;
+	private:
+		std::vector<std::thread> _workers;
+		std::deque<std::function<void()>> _tasks;
+		std::mutex _mutex;
+		std::condition_variable _available; // Signalled when a task is queued or the pool stops
+		std::condition_variable _idle; // Signalled when the last pending task finishes
+		std::size_t _pending = 0; // Queued plus running tasks
+		std::exception_ptr _error; // First exception thrown by a task since the last wait
+		bool _stopping = false;
+
+		void work();
+};
+
+}
@@ -1,22 +1,46 @@
 #include "utility.hpp"
 
+namespace {
+	// [CharReader] Get the JSON reader of this thread, built once with the default settings
+	Json::CharReader &reader() {
+		thread_local std::unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
+		return *reader;
+	}
+}
+
 namespace MUtilities::Utility {
 	// [Json Value] Parse string to JSON object
-	Json::Value stojson(std::string str) {
-		Json::CharReaderBuilder builder;
-		Json::CharReader *reader = builder.newCharReader();
-		std::string errors;
-
+	Json::Value stojson(std::string_view str) {
 		Json::Value obj;
-		reader->parse(str.c_str(), str.c_str() + str.size(), &obj, &errors);
-
-		delete reader;
+		std::string errors;
+		stojson(str, obj, errors);
 		return obj;
 	}
+	// [bool] Parse string to JSON value, without copying it; on failure, errors describes why
+	bool stojson(std::string_view str, Json::Value &out, std::string &errors) {
+		errors.clear();
+		return reader().parse(str.data(), str.data() + str.size(), &out, &errors);
+	}
+	// [bool] Parse a JSON file, mapped into memory instead of being read into a string; on failure, errors describes
+	// why. Throws if the file can not be opened.
+	bool ftojson(const std::string &path, Json::Value &out, std::string &errors) {
+		MappedFile file(path);
+		return stojson(file.view(), out, errors);
+	}
 
 	// [bool] Check if string ends with a suffix
-	bool hasSuffix(const std::string &str, const std::string &suffix) {
+	bool hasSuffix(std::string_view str, std::string_view suffix) {
 		return str.size() >= suffix.size() &&
 			str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
 	}
+
+	// [uint64] Hash bytes with 64-bit FNV-1a, or continue a hash of the bytes before them; fast and stable
+	// across platforms, but not collision resistant
+	std::uint64_t fnv1a(std::string_view bytes, std::uint64_t hash) {
+		for (unsigned char c: bytes) {
+			hash ^= c;
+			hash *= 0x100000001b3ull;
+		}
+		return hash;
+	}
 }
@@ -2,8 +2,16 @@
 
 #include <json/json.h>
 #include <string>
+#include <string_view>
+#include <memory>
+#include <cstdint>
+
+#include "mappedfile.hpp"
 
 namespace MUtilities::Utility {
-	Json::Value stojson(std::string str);
-	bool hasSuffix(const std::string &str, const std::string &suffix);
+	Json::Value stojson(std::string_view str); // Parse errors are discarded
+	bool stojson(std::string_view str, Json::Value &out, std::string &errors);
+	bool ftojson(const std::string &path, Json::Value &out, std::string &errors); // Parses the file mapped in place
+	bool hasSuffix(std::string_view str, std::string_view suffix);
+	std::uint64_t fnv1a(std::string_view bytes, std::uint64_t hash = 0xcbf29ce484222325ull);
 }
@@ -1,48 +1,296 @@
 #include "validate.hpp"
 
 namespace MUtilities::Validate {
+	namespace {
+		// Character classes used by the validators below. Each one mirrors a bracket expression of the
+		// regular expression the validator used to be written as, so the accepted language is unchanged.
+		enum : unsigned char {
+			emailAtom = 1 << 0, // [^<>()\[\]\\.,;:\s@"]
+			domainLabel = 1 << 1, // [a-zA-Z\-0-9]
+			alpha = 1 << 2, // [a-zA-Z]
+			digit = 1 << 3, // [0-9]
+			hex = 1 << 4, // [0-9A-F]
+			uriPlain = 1 << 5, // [a-z0-9-._~!$&'()*+,;=]
+			scheme = 1 << 6, // [a-z0-9+.-]
+			nameChar = 1 << 7 // [a-z0-9\-_\.]
+		};
+
+		struct charTable {
+			unsigned char flags[256] = {};
+
+			constexpr charTable() {
+				for (int c = 0; c < 256; c++)
+					this->flags[c] = emailAtom;
+
+				for (char c : std::string_view("<>()[]\\.,;:@\" \t\n\v\f\r"))
+					this->flags[static_cast<unsigned char>(c)] = 0;
+
+				for (int c = 'a'; c <= 'z'; c++)
+					this->flags[c] |= domainLabel | alpha | uriPlain | scheme | nameChar;
+				for (int c = 'A'; c <= 'Z'; c++)
+					this->flags[c] |= domainLabel | alpha;
+				for (int c = '0'; c <= '9'; c++)
+					this->flags[c] |= domainLabel | digit | hex | uriPlain | scheme | nameChar;
+				for (int c = 'A'; c <= 'F'; c++)
+					this->flags[c] |= hex;
+
+				this->flags[static_cast<unsigned char>('-')] |= domainLabel | uriPlain | scheme | nameChar;
+				this->flags[static_cast<unsigned char>('.')] |= uriPlain | scheme | nameChar;
+				this->flags[static_cast<unsigned char>('_')] |= uriPlain | nameChar;
+				this->flags[static_cast<unsigned char>('+')] |= scheme;
+
+				for (char c : std::string_view("~!$&'()*+,;="))
+					this->flags[static_cast<unsigned char>(c)] |= uriPlain;
+			}
+
+			constexpr bool is(char c, unsigned char cls) const {
+				return this->flags[static_cast<unsigned char>(c)] & cls;
+			}
+		};
+
+		constexpr charTable table;
+
+		// [bool] True if the ECMAScript "." would match c
+		bool anyChar(char c) {
+			return c != '\n' && c != '\r';
+		}
+
+		// [bool] Match atom(\.atom)* for the unquoted local part of an email address
+		bool emailDotAtoms(std::string_view s) {
+			bool atomStart = true;
+
+			for (char c : s) {
+				if (c == '.') {
+					if (atomStart)
+						return false;
+					atomStart = true;
+				} else if (table.is(c, emailAtom)) {
+					atomStart = false;
+				} else {
+					return false;
+				}
+			}
+
+			return !atomStart;
+		}
+
+		// [bool] Match \[d{1,3}\.d{1,3}\.d{1,3}\.d{1,3}\]
+		bool emailAddressLiteral(std::string_view s) {
+			if (s.size() < 2 || s.front() != '[' || s.back() != ']')
+				return false;
+
+			std::size_t digits = 0;
+			std::size_t dots = 0;
+
+			for (char c : s.substr(1, s.size() - 2)) {
+				if (table.is(c, digit)) {
+					if (++digits > 3)
+						return false;
+				} else if (c == '.' && digits > 0 && dots < 3) {
+					digits = 0;
+					dots++;
+				} else {
+					return false;
+				}
+			}
+
+			return dots == 3 && digits > 0;
+		}
+
+		// [bool] Match ([a-zA-Z\-0-9]+\.)+[a-zA-Z]{2,}
+		bool emailHostname(std::string_view s) {
+			std::size_t last = s.rfind('.');
+			if (last == std::string_view::npos)
+				return false;
+
+			std::string_view tld = s.substr(last + 1);
+			if (tld.size() < 2)
+				return false;
+
+			for (char c : tld)
+				if (!table.is(c, alpha))
+					return false;
+
+			std::size_t length = 0;
+			for (char c : s.substr(0, last + 1)) {
+				if (c == '.') {
+					if (length == 0)
+						return false;
+					length = 0;
+				} else if (table.is(c, domainLabel)) {
+					length++;
+				} else {
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// [bool] Match (plain|%[0-9A-F]{2})*, where plain is uriPlain plus the given extra characters
+		bool uriSegment(std::string_view s, std::string_view extra) {
+			for (std::size_t i = 0; i < s.size(); i++) {
+				char c = s[i];
+
+				if (table.is(c, uriPlain) || extra.find(c) != std::string_view::npos)
+					continue;
+
+				if (c != '%' || i + 2 >= s.size() || !table.is(s[i + 1], hex) || !table.is(s[i + 2], hex))
+					return false;
+
+				i += 2;
+			}
+
+			return true;
+		}
+
+		// [bool] Match the hierarchical part of a url (authority and path)
+		bool uriHierarchy(std::string_view s) {
+			if (s.empty())
+				return true;
+
+			if (s.substr(0, 2) != "//") {
+				// (/?segment-nz(/segment)*)
+				std::string_view path = (s.front() == '/') ? s.substr(1) : s;
+				if (path.empty() || path.front() == '/')
+					return false;
+
+				return uriSegment(path, ":@/");
+			}
+
+			s.remove_prefix(2);
+
+			std::size_t slash = s.find('/');
+			std::string_view authority = s.substr(0, slash);
+
+			if (slash != std::string_view::npos && !uriSegment(s.substr(slash), ":@/"))
+				return false;
+
+			std::size_t at = authority.find('@');
+			if (at != std::string_view::npos) {
+				if (!uriSegment(authority.substr(0, at), ":"))
+					return false;
+				authority.remove_prefix(at + 1);
+			}
+
+			std::size_t colon = authority.find(':');
+			if (!uriSegment(authority.substr(0, colon), ""))
+				return false;
+
+			if (colon != std::string_view::npos)
+				for (char c : authority.substr(colon + 1))
+					if (!table.is(c, digit))
+						return false;
+
+			return true;
+		}
+	}
+
 	// [bool] Validate Email Address
-	bool email(std::string email) {
-		std::regex rgx(R"(^(([^<>()\[\]\\.,;:\s@"]+(\.[^<>()\[\]\\.,;:\s@"]+)*)|(".+"))@((\[[0-9]{1,3}\.)"
-			R"([0-9]{1,3}\.[0-9]{1,3}\.[0-9]{1,3}\])|(([a-zA-Z\-0-9]+\.)+[a-zA-Z]{2,}))$)");
+	bool email(std::string_view email) {
+		std::size_t at = email.rfind('@');
+		if (at == std::string_view::npos)
+			return false;
+
+		std::string_view local = email.substr(0, at);
+		std::string_view domain = email.substr(at + 1);
+
+		// Quoted local part (".+")
+		bool quoted = local.size() >= 3 && local.front() == '"' && local.back() == '"';
+		if (quoted)
+			for (char c : local.substr(1, local.size() - 2))
+				if (!anyChar(c))
+					quoted = false;
 
-		if (!std::regex_match(email, rgx))
+		if (!quoted && !emailDotAtoms(local))
 			return false;
 
-		return true;
+		return emailAddressLiteral(domain) || emailHostname(domain);
 	}
 
 	// [bool] Validate URL (with URI scheme)
-	bool url(std::string url) {
-		std::regex rgx(R"(^([a-z0-9+.-]+):(?://(?:((?:[a-z0-9-._~!$&'()*+,;=:]|%[0-9A-F]{2})*)@)?)"
-			R"(((?:[a-z0-9-._~!$&'()*+,;=]|%[0-9A-F]{2})*)(?::(\d*))?(/(?:[a-z0-9-._~!$&'()*+,;=:@/]|)"
-			R"(%[0-9A-F]{2})*)?|(/?(?:[a-z0-9-._~!$&'()*+,;=:@]|%[0-9A-F]{2})+(?:[a-z0-9-._~!$&'()*+,;=:@/]|)"
-			R"(%[0-9A-F]{2})*)?)(?:\?((?:[a-z0-9-._~!$&'()*+,;=:/?@]|%[0-9A-F]{2})*))?)"
-			R"((?:#((?:[a-z0-9-._~!$&'()*+,;=:/?@]|%[0-9A-F]{2})*))?$)");
-
-		if (!std::regex_match(url, rgx))
+	bool url(std::string_view url) {
+		std::size_t colon = url.find(':');
+		if (colon == 0 || colon == std::string_view::npos)
 			return false;
 
-		return true;
+		for (char c : url.substr(0, colon))
+			if (!table.is(c, scheme))
+				return false;
+
+		std::string_view rest = url.substr(colon + 1);
+
+		// Fragment can not contain '#', and neither can anything before it
+		std::size_t hash = rest.find('#');
+		if (hash != std::string_view::npos) {
+			if (!uriSegment(rest.substr(hash + 1), ":/?@"))
+				return false;
+			rest = rest.substr(0, hash);
+		}
+
+		// The query may contain '?', nothing before it can
+		std::size_t query = rest.find('?');
+		if (query != std::string_view::npos) {
+			if (!uriSegment(rest.substr(query + 1), ":/?@"))
+				return false;
+			rest = rest.substr(0, query);
+		}
+
+		return uriHierarchy(rest);
 	}
 
 	// [bool] Validate package name
-	bool packageName(std::string name) {
-		if (!std::regex_match(name, std::regex(R"(^[^_\-\.][a-z0-9\-_\.]+$)")))
+	bool packageName(std::string_view name) {
+		if (name.size() < 2 || name.front() == '_' || name.front() == '-' || name.front() == '.')
 			return false;
 
+		for (char c : name.substr(1))
+			if (!table.is(c, nameChar))
+				return false;
+
 		return true;
 	}
 
 	// [bool] Validate dependency name
-	bool dependName(std::string name) {
-		std::regex rgx(R"(^(collection|ssm|csm|res)\:(.+)$)");
-		std::smatch match;
+	bool dependName(std::string_view name) {
+		std::size_t colon = name.find(':');
+		if (colon == std::string_view::npos)
+			return false;
 
-		if (std::regex_search(name, match, rgx)) {
-			return packageName(match[2]);
-		}
+		std::string_view type = name.substr(0, colon);
+		if (type != "collection" && type != "ssm" && type != "csm" && type != "res")
+			return false;
+
+		std::string_view pkg = name.substr(colon + 1);
+		for (char c : pkg)
+			if (!anyChar(c))
+				return false;
+
+		return packageName(pkg);
+	}
+
+	// [std::vector<bool>] Validate count strings, result i is true if values[i] is valid
+	std::vector<bool> validateMany(bool (*validator)(std::string_view), const std::string_view *values, std::size_t count) {
+		std::vector<bool> results(count);
+
+		for (std::size_t i = 0; i < count; i++)
+			results[i] = validator(values[i]);
+
+		return results;
+	}
+
+	// [std::vector<bool>] Validate every string in values
+	std::vector<bool> validateMany(bool (*validator)(std::string_view), const std::vector<std::string> &values) {
+		std::vector<bool> results(values.size());
+
+		for (std::size_t i = 0; i < values.size(); i++)
+			results[i] = validator(values[i]);
+
+		return results;
+	}
 
-		return false;
+	// [std::vector<bool>] Validate every string in values
+	std::vector<bool> validateMany(bool (*validator)(std::string_view), const std::vector<std::string_view> &values) {
+		return validateMany(validator, values.data(), values.size());
 	}
 }
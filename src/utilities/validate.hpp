@@ -1,11 +1,18 @@
 #pragma once
 
 #include <string>
-#include <regex>
+#include <string_view>
+#include <vector>
+#include <cstddef>
 
 namespace MUtilities::Validate {
-	bool email(std::string email);
-	bool url(std::string url);
-	bool packageName(std::string name);
-	bool dependName(std::string name);
+	bool email(std::string_view email);
+	bool url(std::string_view url);
+	bool packageName(std::string_view name);
+	bool dependName(std::string_view name);
+
+	// Validate a batch of strings with one of the validators above
+	std::vector<bool> validateMany(bool (*validator)(std::string_view), const std::string_view *values, std::size_t count);
+	std::vector<bool> validateMany(bool (*validator)(std::string_view), const std::vector<std::string> &values);
+	std::vector<bool> validateMany(bool (*validator)(std::string_view), const std::vector<std::string_view> &values);
 }
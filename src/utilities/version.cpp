@@ -4,150 +4,203 @@ using namespace MUtilities;
 
 // Define within MUtilities namespace.
 namespace MUtilities {
-	// [Version] Convert string to a version object
-	void stringToVersion(Version &vobj, std::string version) {
-		int major = -1;
-		int minor = -1;
-		int patch = -1;
-		Version::Prerelease prerelease;
-		std::string meta;
-
-		std::string last = "";
-		// States: 0 - major, 1 - minor, 2 - patch, 3 - prerelease type, 4 - prerelease version, 5 - meta
-		unsigned int state = 0;
-
-		// Loop through characters of version string
-		for (std::string::size_type i = 0; i < version.size(); ++i) {
-			char c = version[i];
-
-			// Ensure that there are no leading zeros
-			if (last == "0" && (c != '.' && c != '-' && c != '+')) {
-				throw "Error::MUtilities::stringToVersion::leadingZerosDisallowed";
-			}
-
-			// Catch exceptions raised by stoi when the string does not represent a number
-			try {
-				// Check for extra `.`s
-				if ((state == 2) && c == '.')
-					throw 1;
-
-				// Handle major version
-				if (state == 0 && c == '.') {
-					major = std::stoi(last);
-					last = "";
-					state = 1;
-				// Handle minor version
-				} else if (state == 1 && c == '.') {
-					minor = std::stoi(last);
-					last = "";
-					state = 2;
-				// Handle patch version
-				} else if (state == 2 && (i == (version.size() - 1) || c == '-' || c == '+')) {
-					if (i == (version.size() - 1)) last += c;
-					patch = std::stoi(last);
-					last = "";
-					if (c == '-')
-						state = 3;
-					else if (c == '+')
-						state = 5;
-				// Handle prerelease type
-				} else if (state == 3 && (i == (version.size() - 1) || c == '.' || c == '+')) {
-					if (i == (version.size() - 1)) last += c;
-					prerelease.type = last;
-					last = "";
-					if (c == '.')
-						state = 4;
-					else if (c == '+')
-						state = 5;
-				// Handle prerelease version
-				} else if (state == 4 && (i == (version.size() - 1) || c == '+')) {
-					if (i == (version.size() - 1)) last += c;
-					prerelease.version = std::stoi(last);
-					last = "";
-					state = 5;
-				// Handle build metadata
-				} else if (state == 5 && i == (version.size() - 1)) {
-					meta = last + c;
-					break;
-				} else { // else, append to last
-					last += c;
-				}
-			} catch (...) {
-				throw "Error::MUtilities::stringToVersion::invalidVersionNumber";
-			}
-		}
+	// [Version] Convert string to a version object, throwing on malformed input
+	void stringToVersion(Version &vobj, std::string_view version) {
+		Version::ParseError error = Version::parse(version, vobj);
 
-		// Ensure major, minor, and patch always exist
-		if (major == -1 || minor == -1 || patch == -1) {
-			throw "Error::MUtilities::stringToVersion::invalidVersionStructure";
-		}
+		if (error != Version::ParseError::none)
+			throw Version::errorString(error);
+	}
+}
 
-		// Ensure prerelease version is not zero
-		if (prerelease.version == 0) {
-			throw "Error::MUtilities::stringToVersion::prereleaseVersionIsZero";
-		}
+namespace {
+	// [InternTable] Get the table shared by Version::intern and Version::tryIntern
+	MUtilities::InternTable<MUtilities::Version> &versions() {
+		static MUtilities::InternTable<MUtilities::Version> table;
+		return table;
+	}
+
+	// [ParseError] Read a numeric identifier (no leading zeros, must fit in an int) starting at pos
+	MUtilities::Version::ParseError parseNumber(std::string_view str, std::size_t &pos, int &out) {
+		std::size_t start = pos;
+		long long value = 0;
 
-		// Ensure build metadata comprises of only alphanumeric characters and hyphens
-		if (!meta.empty()) {
-			for (char &c: meta) {
-				if (!std::isalnum(c) && c != '-' && c != '.') {
-					throw "Error::MUTilities::stringToVersion::invalidBuildMeta";
-				}
-			}
+		while (pos < str.size() && str[pos] >= '0' && str[pos] <= '9') {
+			value = value * 10 + (str[pos] - '0');
+			if (value > 0x7FFFFFFF)
+				return MUtilities::Version::ParseError::invalidVersionNumber;
+			pos++;
 		}
 
-		vobj._major = major;
-		vobj._minor = minor;
-		vobj._patch = patch;
-		vobj._prerelease = prerelease;
-		vobj._meta = meta;
-		vobj._prerelease.setTypeWeight();
+		if (pos == start)
+			return MUtilities::Version::ParseError::invalidVersionNumber;
+		if (str[start] == '0' && pos - start > 1)
+			return MUtilities::Version::ParseError::leadingZerosDisallowed;
+
+		out = static_cast<int>(value);
+		return MUtilities::Version::ParseError::none;
 	}
 }
 
 /* Version Class */
 
 // [constructor] Clean with defaults
-Version::Version(): _major(0), _minor(1), _patch(0) {}
+Version::Version(): _major(0), _minor(1), _patch(0) {
+	this->pack();
+}
 // [constructor] From string
-Version::Version(std::string version) {
-	this->setFromString(*this, version);
+Version::Version(std::string_view version) {
+	stringToVersion(*this, version);
+}
+
+// [ParseError] Parse a version string without throwing; out is only modified on success
+Version::ParseError Version::parse(std::string_view str, Version &out) {
+	int fields[3] = {0, 0, 0};
+	std::size_t pos = 0;
+
+	// Parse major, minor, and patch
+	for (int i = 0; i < 3; i++) {
+		if (i > 0) {
+			if (pos >= str.size() || str[pos] == '-' || str[pos] == '+')
+				return ParseError::invalidVersionStructure;
+			if (str[pos] != '.')
+				return ParseError::invalidVersionNumber;
+			pos++;
+		}
+
+		if (pos >= str.size())
+			return ParseError::invalidVersionStructure;
+
+		ParseError error = parseNumber(str, pos, fields[i]);
+		if (error != ParseError::none)
+			return error;
+	}
+
+	// Parse prerelease type and optional version
+	std::string_view type;
+	int typeWeight = -1;
+	int preVersion = -1;
+	if (pos < str.size() && str[pos] == '-') {
+		std::size_t start = ++pos;
+		while (pos < str.size() && str[pos] != '.' && str[pos] != '+')
+			pos++;
+		type = str.substr(start, pos - start);
+
+		if (type == "alpha")
+			typeWeight = 0;
+		else if (type == "beta")
+			typeWeight = 1;
+		else if (type == "rc")
+			typeWeight = 2;
+		else
+			return ParseError::invalidPrereleaseType;
+
+		if (pos < str.size() && str[pos] == '.') {
+			pos++;
+			ParseError error = parseNumber(str, pos, preVersion);
+			if (error != ParseError::none)
+				return error;
+			if (preVersion == 0)
+				return ParseError::prereleaseVersionIsZero;
+		}
+	}
+
+	// Parse build metadata, comprising only alphanumerics, hyphens, and dots
+	std::string_view meta;
+	if (pos < str.size() && str[pos] == '+') {
+		meta = str.substr(pos + 1);
+		if (meta.empty())
+			return ParseError::invalidBuildMeta;
+		for (char c: meta) {
+			if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '.')
+				return ParseError::invalidBuildMeta;
+		}
+		pos = str.size();
+	}
+
+	// Anything left over is not part of the version grammar
+	if (pos != str.size())
+		return ParseError::invalidVersionNumber;
+
+	out._major = fields[0];
+	out._minor = fields[1];
+	out._patch = fields[2];
+	out._prerelease.type.assign(type.data(), type.size());
+	out._prerelease.version = preVersion;
+	out._prerelease.typeWeight = typeWeight;
+	out._meta.assign(meta.data(), meta.size());
+	out.pack();
+
+	return ParseError::none;
+}
+
+// [const char*] Get the exception message thrown for a parse error
+const char *Version::errorString(ParseError error) {
+	switch (error) {
+		case ParseError::none:
+			return "";
+		case ParseError::leadingZerosDisallowed:
+			return "Error::MUtilities::stringToVersion::leadingZerosDisallowed";
+		case ParseError::invalidVersionNumber:
+			return "Error::MUtilities::stringToVersion::invalidVersionNumber";
+		case ParseError::invalidVersionStructure:
+			return "Error::MUtilities::stringToVersion::invalidVersionStructure";
+		case ParseError::prereleaseVersionIsZero:
+			return "Error::MUtilities::stringToVersion::prereleaseVersionIsZero";
+		case ParseError::invalidPrereleaseType:
+			return "Error::MUtilities::stringToVersion::invalidPrereleaseType";
+		case ParseError::invalidBuildMeta:
+			return "Error::MUTilities::stringToVersion::invalidBuildMeta";
+	}
+
+	return "";
 }
 
 // Define within MUtilities namespace.
 namespace MUtilities {
 	// [std::ostream&] Ostream operator overload using object
 	std::ostream& operator << (std::ostream &strm, Version &a) {
-		std::string pre = "";
-		// Get prerelease information
-		if (!a._prerelease.type.empty()) {
-			pre = "-" + a._prerelease.type;
-			if (a._prerelease.version > 0) {
-				pre += "." + std::to_string(a._prerelease.version);
-			}
-		}
+		return strm << a.str();
+	}
+}
+
+// [string] Format as major.minor.patch[-prerelease[.n]][+meta]
+std::string Version::str() const {
+	std::string out = std::to_string(this->_major) + "." + std::to_string(this->_minor) + "." +
+		std::to_string(this->_patch);
 
-		std::string meta = "";
-		// Get metadata information
-		if (!a._meta.empty()) {
-			meta = "+" + a._meta;
+	// Get prerelease information
+	if (!this->_prerelease.type.empty()) {
+		out += "-" + this->_prerelease.type;
+		if (this->_prerelease.version > 0) {
+			out += "." + std::to_string(this->_prerelease.version);
 		}
+	}
 
-		return strm << a._major << "." << a._minor << "." << a._patch << pre << meta;
+	// Get metadata information
+	if (!this->_meta.empty()) {
+		out += "+" + this->_meta;
 	}
+
+	return out;
 }
 
-// [void] Assignment operator overload using string
-void Version::operator = (const std::string &n) {
-	this->setFromString(*this, n);
+// [shared_ptr] Get the shared immutable version parsed from the string, parsing it only on first use
+std::shared_ptr<const Version> Version::intern(std::string_view version) {
+	return versions().get(version);
+}
+// [shared_ptr] Get the shared version like intern, without throwing; on malformed input, sets the error intern
+// would throw and returns null
+std::shared_ptr<const Version> Version::tryIntern(std::string_view version, const char *&error) {
+	return versions().tryGet(version, [](std::string_view str, Version &out) {
+		ParseError e = Version::parse(str, out);
+		return (e == ParseError::none) ? nullptr : Version::errorString(e);
+	}, error);
 }
 
-// [bool] Equality operator overload using object
-bool Version::operator == (const Version &b) const {
-	bool pre = this->_prerelease == b._prerelease;
-	//std::cout << "Prerelease Equality: " << pre << ", " << this->_prerelease.type << ", " <<
-//		this->_prerelease.version << "; " << b._prerelease.type << ", " << b._prerelease.version << std::endl;
-	return (this->_major == b._major) && (this->_minor == b._minor) && (this->_patch == b._patch) && pre;
+// [void] Assignment operator overload using string
+void Version::operator = (const std::string &n) {
+	stringToVersion(*this, n);
 }
 
 // [bool] Equality operator overload using string
@@ -157,11 +210,6 @@ bool Version::operator == (const std::string &b) const {
 	return *this == obj;
 }
 
-// [bool] Inequality operator overload using object
-bool Version::operator != (const Version &b) const {
-	return !(*this == b);
-}
-
 // [bool] Inequality operator overload using string
 bool Version::operator != (const std::string &b) const {
 	Version obj;
@@ -169,21 +217,6 @@ bool Version::operator != (const std::string &b) const {
 	return *this != obj;
 }
 
-// [bool] Less than operator overload using object
-bool Version::operator < (const Version &b) const {
-	if (this->_major < b._major)
-		return true;
-	else if (this->_major == b._major && this->_minor < b._minor)
-		return true;
-	else if (this->_major == b._major && this->_minor == b._minor && this->_patch < b._patch)
-		return true;
-	else if (this->_major == b._major && this->_minor == b._minor && this->_patch == b._patch &&
-			this->_prerelease < b._prerelease)
-		return true;
-
-	return false;
-}
-
 // [bool] Less than operator overload using string
 bool Version::operator < (const std::string &b) const {
 	Version obj;
@@ -191,11 +224,6 @@ bool Version::operator < (const std::string &b) const {
 	return *this < obj;
 }
 
-// [bool] Greater than operator overload using object
-bool Version::operator > (const Version &b) const {
-	return !(*this < b) && *this != b;
-}
-
 // [bool] Greater than operator overload using string
 bool Version::operator > (const std::string &b) const {
 	Version obj;
@@ -203,11 +231,6 @@ bool Version::operator > (const std::string &b) const {
 	return *this > obj;
 }
 
-// [bool] Less than or equal to operator overload using object
-bool Version::operator <= (const Version &b) const {
-	return *this < b || *this == b;
-}
-
 // [bool] Less than or equal to operator overload using string
 bool Version::operator <= (const std::string &b) const {
 	Version obj;
@@ -215,11 +238,6 @@ bool Version::operator <= (const std::string &b) const {
 	return *this <= obj;
 }
 
-// [bool] Greater than or equal to operator overload using object
-bool Version::operator >= (const Version &b) const {
-	return !(*this <= b) || *this == b;
-}
-
 // [bool] Greater than or equal to operator overload using string
 bool Version::operator >= (const std::string &b) const {
 	Version obj;
@@ -227,30 +245,84 @@ bool Version::operator >= (const std::string &b) const {
 	return *this >= obj;
 }
 
+// [uint64_t] Get packed precedence sort key
+std::uint64_t Version::key() const {
+	return this->_key;
+}
+
 // [unsigned int] Get major version
-unsigned int Version::major() {
+unsigned int Version::major() const {
 	return this->_major;
 }
 // [unsigned int] Get minor version
-unsigned int Version::minor() {
+unsigned int Version::minor() const {
 	return this->_minor;
 }
 // [unsigned int] Get patch version
-unsigned int Version::patch() {
+unsigned int Version::patch() const {
 	return this->_patch;
 }
-// [Prerelease] Get prerelease data
-std::pair<std::string, int> Version::prerelease() {
-	return std::pair(this->_prerelease.type, this->_prerelease.version);
+// [pair of string view and int] Get prerelease data (type is viewed, not copied)
+std::pair<std::string_view, int> Version::prerelease() const {
+	return std::pair(std::string_view(this->_prerelease.type), this->_prerelease.version);
 }
 // [string] Get build metadata
-std::string Version::meta() {
+const std::string &Version::meta() const {
 	return this->_meta;
 }
 
-// [void] Set object properties based on string
-void Version::setFromString(Version &vobj, std::string version) {
-	stringToVersion(*this, version);
+// [void] Pack version fields into the precedence key
+void Version::pack() {
+	const std::uint64_t fields[3] = {this->_major, this->_minor, this->_patch};
+	const unsigned int shifts[3] = {48, 32, 16};
+
+	this->_key = 0;
+	this->_exact = true;
+
+	for (int i = 0; i < 3; i++) {
+		// if a field does not fit, fill it and every lower slot so that the key remains monotonic
+		if (fields[i] > 0xFFFF) {
+			this->_key |= ~std::uint64_t(0) >> (48 - shifts[i]);
+			this->_exact = false;
+			return;
+		}
+
+		this->_key |= fields[i] << shifts[i];
+	}
+
+	// Releases (no prerelease type) take precedence over alpha (0), beta (1), and rc (2)
+	std::uint64_t weight = (this->_prerelease.typeWeight == -1) ? 3 : this->_prerelease.typeWeight;
+	// A missing prerelease version sorts before any numbered one
+	std::uint64_t number = (this->_prerelease.version > 0) ? this->_prerelease.version : 0;
+
+	if (number > 0x3FFF) {
+		number = 0x3FFF;
+		this->_exact = false;
+	}
+
+	this->_key |= (weight << 14) | number;
+}
+
+// [int] Field by field three-way comparison, used when the packed keys cannot decide
+int Version::compareFields(const Version &b) const {
+	if (this->_major != b._major)
+		return (this->_major < b._major) ? -1 : 1;
+	if (this->_minor != b._minor)
+		return (this->_minor < b._minor) ? -1 : 1;
+	if (this->_patch != b._patch)
+		return (this->_patch < b._patch) ? -1 : 1;
+
+	int weight = (this->_prerelease.typeWeight == -1) ? 3 : this->_prerelease.typeWeight;
+	int bWeight = (b._prerelease.typeWeight == -1) ? 3 : b._prerelease.typeWeight;
+	if (weight != bWeight)
+		return (weight < bWeight) ? -1 : 1;
+
+	int number = std::max(this->_prerelease.version, 0);
+	int bNumber = std::max(b._prerelease.version, 0);
+	if (number != bNumber)
+		return (number < bNumber) ? -1 : 1;
+
+	return 0;
 }
 
 /* Prerelease Class */
@@ -277,32 +349,3 @@ void Version::Prerelease::setTypeWeight() {
 		}
 	}
 }
-
-// [bool] Equality operator overload using object
-bool Version::Prerelease::operator == (const Prerelease &b) const {
-	return (this->type == b.type) && (this->version == b.version);
-}
-
-// [bool] Less than operator overload using object
-bool Version::Prerelease::operator < (const Prerelease &b) const {
-	// if neither have prerelease data, return false
-	if (this->type.empty() && this->version == -1 && b.type.empty() && b.version == -1)
-		return false;
-
-	// if there is no prerelease data, return true
-	if (b.type.empty() && b.version == -1)
-		return true;
-
-	// if this type weight is less than the other, return true
-	if (this->typeWeight < b.typeWeight)
-		return true;
-
-	// if this weight type is equal to the other, compare prerelease versions
-	if (this->typeWeight == b.typeWeight) {
-		// if there is no version information or this version is less than the other, return true
-		if ((this->version == -1 && b.version > 0) || this->version < b.version)
-			return true;
-	}
-
-	return false;
-}
@@ -2,10 +2,16 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <iterator>
 #include <utility>
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <memory>
+
+#include "intern.hpp"
 
 #undef major // Undefine major for use in class
 #undef minor // Undefine minor for use in class
@@ -14,8 +20,24 @@ namespace MUtilities {
 
 class Version {
 	public:
+		// Errors reported by parse
+		enum class ParseError {
+			none,
+			leadingZerosDisallowed,
+			invalidVersionNumber,
+			invalidVersionStructure,
+			prereleaseVersionIsZero,
+			invalidPrereleaseType,
+			invalidBuildMeta
+		};
+
 		Version();
-		Version(std::string version);
+		Version(std::string_view version);
+
+		static ParseError parse(std::string_view str, Version &out);
+		static const char *errorString(ParseError error);
+		static std::shared_ptr<const Version> intern(std::string_view version);
+		static std::shared_ptr<const Version> tryIntern(std::string_view version, const char *&error); // Null on error
 
 		friend std::ostream& operator << (std::ostream &strm, Version &a); // Ostream
 		void operator = (const std::string &n); // Assignment with string
@@ -32,13 +54,17 @@ class Version {
 		bool operator >= (const Version &b) const; // Greater than or equal to
 		bool operator >= (const std::string &b) const; // Greater than or equal to  with string
 
-		unsigned int major();
-		unsigned int minor();
-		unsigned int patch();
-		std::pair<std::string, int> prerelease();
-		std::string meta();
+		int compare(const Version &b) const; // Three-way precedence comparison
+		std::uint64_t key() const; // Packed precedence sort key
+		std::string str() const; // Version string, parses back to an equal version
+
+		unsigned int major() const;
+		unsigned int minor() const;
+		unsigned int patch() const;
+		std::pair<std::string_view, int> prerelease() const;
+		const std::string &meta() const;
 
-		friend void stringToVersion(Version &vobj, std::string version);
+		friend void stringToVersion(Version &vobj, std::string_view version);
 	private:
 		class Prerelease {
 			public:
@@ -49,9 +75,6 @@ class Version {
 				int version = -1;
 				int typeWeight = -1;
 
-				bool operator == (const Prerelease &b) const;
-				bool operator < (const Prerelease &b) const;
-
 				void setTypeWeight();
 		};
 
@@ -61,7 +84,50 @@ class Version {
 		Prerelease _prerelease;
 		std::string _meta;
 
-		void setFromString(Version &vobj, std::string version);
+		// Packed precedence key: major (16) | minor (16) | patch (16) | prerelease weight (2) | prerelease (14)
+		std::uint64_t _key = 0;
+		bool _exact = true; // false if a field did not fit into its slot of the key
+
+		void pack();
+		int compareFields(const Version &b) const;
 };
 
+// [int] Three-way comparison of precedence (build metadata is ignored); negative, zero, or positive
+inline int Version::compare(const Version &b) const {
+	// Keys are monotonic, so differing keys already decide the order
+	if (this->_key != b._key)
+		return (this->_key < b._key) ? -1 : 1;
+
+	// Equal keys are only conclusive if no field had to be saturated while packing
+	if (this->_exact && b._exact)
+		return 0;
+
+	return this->compareFields(b);
+}
+
+// [bool] Equality operator overload using object
+inline bool Version::operator == (const Version &b) const {
+	return this->compare(b) == 0;
+}
+// [bool] Inequality operator overload using object
+inline bool Version::operator != (const Version &b) const {
+	return this->compare(b) != 0;
+}
+// [bool] Less than operator overload using object
+inline bool Version::operator < (const Version &b) const {
+	return this->compare(b) < 0;
+}
+// [bool] Greater than operator overload using object
+inline bool Version::operator > (const Version &b) const {
+	return this->compare(b) > 0;
+}
+// [bool] Less than or equal to operator overload using object
+inline bool Version::operator <= (const Version &b) const {
+	return this->compare(b) <= 0;
+}
+// [bool] Greater than or equal to operator overload using object
+inline bool Version::operator >= (const Version &b) const {
+	return this->compare(b) >= 0;
+}
+
 }
@@ -0,0 +1,154 @@
+#include "versionindex.hpp"
+
+using namespace MUtilities;
+
+/* Version Index Class */
+
+// [constructor] Empty index
+VersionIndex::VersionIndex() {}
+// [constructor] From a list of versions in any order (duplicates are dropped)
+VersionIndex::VersionIndex(std::vector<Version> versions) {
+	std::sort(versions.begin(), versions.end());
+	versions.erase(std::unique(versions.begin(), versions.end()), versions.end());
+
+	this->_keys.reserve(versions.size());
+	for (auto const &v: versions)
+		this->_keys.push_back(v.key());
+	this->_versions = std::move(versions);
+}
+
+// [bool] Insert a version, keeping the index sorted; false if an equal version is already present
+bool VersionIndex::insert(const Version &version) {
+	std::size_t i = this->lowerIndex(version, true);
+	if (i < this->_versions.size() && this->_versions[i] == version)
+		return false;
+
+	this->_keys.insert(this->_keys.begin() + i, version.key());
+	this->_versions.insert(this->_versions.begin() + i, version);
+	return true;
+}
+
+// [bool] Remove a version; false if it was not present
+bool VersionIndex::erase(const Version &version) {
+	std::size_t i = this->lowerIndex(version, true);
+	if (i >= this->_versions.size() || this->_versions[i] != version)
+		return false;
+
+	this->_keys.erase(this->_keys.begin() + i);
+	this->_versions.erase(this->_versions.begin() + i);
+	return true;
+}
+
+// [bool] Check if an equal version is present
+bool VersionIndex::contains(const Version &version) const {
+	std::size_t i = this->lowerIndex(version, true);
+	return i < this->_versions.size() && this->_versions[i] == version;
+}
+
+// [size_t] Get number of versions
+std::size_t VersionIndex::size() const {
+	return this->_versions.size();
+}
+
+// [vector of versions] Get versions in ascending precedence
+const std::vector<Version> &VersionIndex::versions() const {
+	return this->_versions;
+}
+
+// [Version*] Get the highest version satisfying the range, or nullptr
+const Version *VersionIndex::maxSatisfying(const Range &range) const {
+	const std::vector<Range::interval> &intervals = range.intervals();
+
+	for (auto it = intervals.rbegin(); it != intervals.rend(); ++it) {
+		std::pair<std::size_t, std::size_t> s = this->span(*it);
+		if (s.first < s.second)
+			return &this->_versions[s.second - 1];
+	}
+
+	return nullptr;
+}
+
+// [Version*] Get the lowest version satisfying the range, or nullptr
+const Version *VersionIndex::minSatisfying(const Range &range) const {
+	for (auto const &iv: range.intervals()) {
+		std::pair<std::size_t, std::size_t> s = this->span(iv);
+		if (s.first < s.second)
+			return &this->_versions[s.first];
+	}
+
+	return nullptr;
+}
+
+// [vector of Version*] Get all versions satisfying the range in ascending precedence
+std::vector<const Version *> VersionIndex::allSatisfying(const Range &range) const {
+	std::vector<const Version *> out;
+
+	for (auto const &iv: range.intervals()) {
+		std::pair<std::size_t, std::size_t> s = this->span(iv);
+		for (std::size_t i = s.first; i < s.second; i++)
+			out.push_back(&this->_versions[i]);
+	}
+
+	return out;
+}
+
+// [vector of Version*] Get the highest version satisfying each range (nullptr where none does)
+std::vector<const Version *> VersionIndex::maxSatisfying(const std::vector<Range> &ranges) const {
+	std::vector<const Version *> out;
+	out.reserve(ranges.size());
+
+	for (auto const &r: ranges)
+		out.push_back(this->maxSatisfying(r));
+
+	return out;
+}
+
+// [vector of Version*] Get the lowest version satisfying each range (nullptr where none does)
+std::vector<const Version *> VersionIndex::minSatisfying(const std::vector<Range> &ranges) const {
+	std::vector<const Version *> out;
+	out.reserve(ranges.size());
+
+	for (auto const &r: ranges)
+		out.push_back(this->minSatisfying(r));
+
+	return out;
+}
+
+// [size_t] Get the index of the first version above the bound (or equal to it, if inclusive)
+std::size_t VersionIndex::lowerIndex(const Version &bound, bool inclusive) const {
+	std::uint64_t key = bound.key();
+	std::size_t i = std::lower_bound(this->_keys.begin(), this->_keys.end(), key) - this->_keys.begin();
+
+	// Keys are monotonic, so only versions sharing the bound's key need a full comparison
+	while (i < this->_keys.size() && this->_keys[i] == key) {
+		int c = this->_versions[i].compare(bound);
+		if (c > 0 || (c == 0 && inclusive))
+			break;
+		i++;
+	}
+
+	return i;
+}
+
+// [size_t] Get the index one past the last version below the bound (or equal to it, if inclusive)
+std::size_t VersionIndex::upperIndex(const Version &bound, bool inclusive) const {
+	std::uint64_t key = bound.key();
+	std::size_t i = std::upper_bound(this->_keys.begin(), this->_keys.end(), key) - this->_keys.begin();
+
+	while (i > 0 && this->_keys[i - 1] == key) {
+		int c = this->_versions[i - 1].compare(bound);
+		if (c < 0 || (c == 0 && inclusive))
+			break;
+		i--;
+	}
+
+	return i;
+}
+
+// [pair of indices] Get the half-open index span of versions within an interval
+std::pair<std::size_t, std::size_t> VersionIndex::span(const Range::interval &iv) const {
+	std::size_t first = iv.hasLower ? this->lowerIndex(iv.lower, iv.lowerInclusive) : 0;
+	std::size_t last = iv.hasUpper ? this->upperIndex(iv.upper, iv.upperInclusive) : this->_versions.size();
+
+	return std::pair(first, std::max(first, last));
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+
+#include "version.hpp"
+#include "range.hpp"
+
+namespace MUtilities {
+
+/* Version Index Class */
+
+// Sorted set of the available versions of one package, searchable by Range in O(log n) per interval
+class VersionIndex {
+	public:
+		VersionIndex();
+		VersionIndex(std::vector<Version> versions);
+
+		bool insert(const Version &version);
+		bool erase(const Version &version);
+		bool contains(const Version &version) const;
+		std::size_t size() const;
+		const std::vector<Version> &versions() const; // Ascending precedence
+
+		const Version *maxSatisfying(const Range &range) const;
+		const Version *minSatisfying(const Range &range) const;
+		std::vector<const Version *> allSatisfying(const Range &range) const;
+
+		// Batch queries, answering each range in order
+		std::vector<const Version *> maxSatisfying(const std::vector<Range> &ranges) const;
+		std::vector<const Version *> minSatisfying(const std::vector<Range> &ranges) const;
+	private:
+		std::vector<std::uint64_t> _keys; // Packed precedence keys, parallel to _versions
+		std::vector<Version> _versions;
+
+		std::size_t lowerIndex(const Version &bound, bool inclusive) const;
+		std::size_t upperIndex(const Version &bound, bool inclusive) const;
+		std::pair<std::size_t, std::size_t> span(const Range::interval &iv) const;
+};
+
+}
@@ -0,0 +1,117 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+
+#include <packages/archive.hpp>
+
+#include "fixture.hpp"
+
+using namespace MPackages;
+using namespace MTests;
+
+namespace fs = std::filesystem;
+
+namespace {
+	// [void] Overwrite bytes of a file at offset
+	void patch(const fs::path &file, std::size_t offset, const std::string &bytes) {
+		std::fstream stream(file, std::ios::binary | std::ios::in | std::ios::out);
+		stream.seekp(static_cast<std::streamoff>(offset));
+		stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+}
+
+TEST_CASE("archives pack a package directory into one mapped file", "[archive]") {
+	fs::path root = fs::temp_directory_path() / "eden-archive-test";
+	fs::path dir = root / "package";
+	fs::path file = root / ("package" + std::string(Archive::extension));
+	fs::remove_all(root);
+
+	std::string binary("\0\1\2\3binary\0", 11);
+	std::string large(200000, 'x');
+	writeFile(dir / "package.json", R"({"name": "packed", "version": "1.0.0"})");
+	writeFile(dir / "textures" / "stone.png", binary);
+	writeFile(dir / "textures" / "nested" / "large.dat", large);
+	writeFile(dir / "empty", "");
+	writeFile(dir / "with space.txt", "spaced");
+
+	SECTION("files are read in place from the archive") {
+		REQUIRE(Archive::pack(dir.string(), file.string()) == 5);
+		REQUIRE(!fs::exists(file.string() + ".tmp"));
+
+		Archive archive(file.string());
+		REQUIRE(archive.size() == 5);
+		REQUIRE(archive.read("package.json") == R"({"name": "packed", "version": "1.0.0"})");
+		REQUIRE(archive.read("textures/stone.png") == binary);
+		REQUIRE(archive.read("textures/nested/large.dat") == large);
+		REQUIRE(archive.read("empty").empty());
+		REQUIRE(archive.read("with space.txt") == "spaced");
+
+		std::set<std::string> paths;
+		for (auto const &e: archive.entries()) {
+			paths.insert(std::string(e.path));
+			REQUIRE(reinterpret_cast<std::uintptr_t>(e.data.data()) % Archive::alignment == 0);
+			REQUIRE(archive.find(e.path) == &e);
+		}
+		REQUIRE(paths == std::set<std::string>({"empty", "package.json", "textures/nested/large.dat",
+			"textures/stone.png", "with space.txt"}));
+	}
+
+	SECTION("missing files are not found") {
+		Archive::pack(dir.string(), file.string());
+		Archive archive(file.string());
+
+		REQUIRE(archive.find("textures") == nullptr);
+		REQUIRE(archive.find("/package.json") == nullptr);
+		REQUIRE(archive.find("") == nullptr);
+		REQUIRE_THROWS_WITH(archive.read("missing.png"), "MPackages::Archive::missingFile");
+	}
+
+	SECTION("packing again replaces the archive, which is not packed into itself") {
+		fs::path inside = dir / "self.epk";
+		REQUIRE(Archive::pack(dir.string(), inside.string()) == 5);
+		writeFile(dir / "added", "new");
+		REQUIRE(Archive::pack(dir.string(), inside.string()) == 6);
+
+		Archive archive(inside.string());
+		REQUIRE(archive.read("added") == "new");
+		REQUIRE(archive.find("self.epk") == nullptr);
+	}
+
+	SECTION("empty directories pack into empty archives") {
+		fs::create_directories(root / "nothing");
+		REQUIRE(Archive::pack((root / "nothing").string(), file.string()) == 0);
+		REQUIRE(Archive(file.string()).size() == 0);
+	}
+
+	SECTION("invalid archives are rejected") {
+		REQUIRE_THROWS_WITH(Archive((root / "missing").string()), "MPackages::Archive::openFailed");
+		REQUIRE_THROWS_WITH(Archive::pack((root / "missing").string(), file.string()),
+			"MPackages::Archive::invalidDirectory");
+
+		writeFile(file, "not an archive");
+		REQUIRE_THROWS_WITH(Archive(file.string()), "MPackages::Archive::invalidFile");
+
+		Archive::pack(dir.string(), file.string());
+		fs::resize_file(file, fs::file_size(file) - 1);
+		REQUIRE_THROWS_WITH(Archive(file.string()), "MPackages::Archive::invalidFile");
+
+		// Contents of the first entry past the end of the file, then misaligned
+		Archive::pack(dir.string(), file.string());
+		patch(file, 40, std::string("\xff\xff\xff\x7f", 4));
+		REQUIRE_THROWS_WITH(Archive(file.string()), "MPackages::Archive::invalidFile");
+
+		Archive::pack(dir.string(), file.string());
+		patch(file, 40, std::string("\x01", 1));
+		REQUIRE_THROWS_WITH(Archive(file.string()), "MPackages::Archive::invalidFile");
+
+		// Table out of order
+		Archive::pack(dir.string(), file.string());
+		patch(file, 32, std::string(8, '\xff'));
+		REQUIRE_THROWS_WITH(Archive(file.string()), "MPackages::Archive::invalidFile");
+	}
+
+	fs::remove_all(root);
+}
@@ -0,0 +1,108 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <packages/cache.hpp>
+
+#include "fixture.hpp"
+
+using namespace MPackages;
+using namespace MTests;
+
+namespace fs = std::filesystem;
+
+namespace {
+	const char *manifest = R"json({
+		"name": "cached",
+		"version": "1.2.3-rc.2+build",
+		"title": "Cached Package",
+		"description": "Round trips through the cache",
+		"keywords": ["one", "two"],
+		"homepage": "https://example.com",
+		"bugs": {"email": "bugs@example.com", "url": "https://example.com/issues"},
+		"license": "MIT",
+		"author": "John Doe <john@example.com> (https://example.com/~john)",
+		"contributors": [{"name": "Jane Doe", "email": "jane@example.com"}, "Sam"],
+		"repository": "https://example.com/cached.git",
+		"dependencies": {"res:base": ">=1.0.0 <2.0.0 || 3.0.0"},
+		"optionalDependencies": {"ssm:extra": "<1.0.0"},
+		"private": true
+	})json";
+}
+
+TEST_CASE("cache records reproduce packages", "[cache]") {
+	Pkg original("dir", Manifest(manifest));
+	std::string record = ManifestCache::encode(original);
+	Pkg copy("dir", Manifest(record, Manifest::Format::record));
+
+	SECTION("every field survives encoding") {
+		REQUIRE(copy.name() == original.name());
+		REQUIRE(copy.version() == original.version());
+		REQUIRE(copy.version().meta() == "build");
+		REQUIRE(copy.title() == original.title());
+		REQUIRE(copy.description() == original.description());
+		REQUIRE(copy.keywords() == original.keywords());
+		REQUIRE(copy.homepage() == original.homepage());
+		REQUIRE(copy.bugs() == original.bugs());
+		REQUIRE(copy.license() == original.license());
+		REQUIRE(copy.author() == original.author());
+		REQUIRE(copy.contributors() == original.contributors());
+		REQUIRE(copy.repository() == original.repository());
+		REQUIRE(copy.dependencies() == original.dependencies());
+		REQUIRE(copy.optionalDependencies() == original.optionalDependencies());
+		REQUIRE(copy.isPrivate());
+	}
+
+	SECTION("truncated or padded records are rejected") {
+		REQUIRE_THROWS_WITH(Pkg("dir", Manifest(std::string_view(record).substr(0, record.size() - 1),
+			Manifest::Format::record)), "MPackages::ManifestCache::corruptRecord");
+		REQUIRE_THROWS_WITH(Pkg("dir", Manifest(record + "x", Manifest::Format::record)),
+			"MPackages::ManifestCache::corruptRecord");
+	}
+}
+
+TEST_CASE("cache files find unchanged manifests", "[cache]") {
+	fs::path file = fs::temp_directory_path() / "eden-cache-test";
+	Pkg a("a", Manifest(R"({"name": "alpha", "version": "1.0.0"})"));
+	Pkg b("b", Manifest(manifest));
+
+	ManifestCache::write(file.string(), {{"b/package.json", 20, 7, &b}, {"a/package.json", 10, 5, &a}});
+
+	SECTION("entries are found by path, size and modification time") {
+		ManifestCache cache(file.string());
+		REQUIRE(cache.size() == 2);
+
+		auto found = cache.find("b/package.json", 20, 7);
+		REQUIRE(found);
+		REQUIRE(found->format() == Manifest::Format::record);
+		REQUIRE(Pkg("b", *found).name() == "cached");
+		REQUIRE(Pkg("a", *cache.find("a/package.json", 10, 5)).name() == "alpha");
+
+		REQUIRE_FALSE(cache.find("b/package.json", 21, 7));
+		REQUIRE_FALSE(cache.find("b/package.json", 20, 8));
+		REQUIRE_FALSE(cache.find("c/package.json", 20, 7));
+	}
+
+	SECTION("missing and invalid files are empty caches") {
+		REQUIRE(ManifestCache((file.string() + "-missing")).size() == 0);
+
+		std::string bytes;
+		{
+			std::ifstream in(file, std::ios::binary);
+			bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		}
+
+		std::ofstream(file, std::ios::binary | std::ios::trunc) << bytes.substr(0, bytes.size() - 1);
+		REQUIRE(ManifestCache(file.string()).size() == 0);
+
+		bytes[0] = 'X';
+		std::ofstream(file, std::ios::binary | std::ios::trunc) << bytes;
+		ManifestCache cache(file.string());
+		REQUIRE(cache.size() == 0);
+		REQUIRE_FALSE(cache.find("a/package.json", 10, 5));
+	}
+
+	fs::remove(file);
+}
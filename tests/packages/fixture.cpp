@@ -0,0 +1,54 @@
+#include <fstream>
+#include <memory>
+
+#include "fixture.hpp"
+
+using namespace MTests;
+
+namespace fs = std::filesystem;
+
+/* Test Package Class */
+
+// [constructor] Pass manifest on to the package
+Pkg::Pkg(std::string path, const MPackages::Manifest &manifest): Package(path, manifest) {}
+Pkg::Pkg(std::string path, std::string_view manifest): Package(path, manifest) {}
+Pkg::Pkg(std::string path, const std::string &manifest): Package(path, std::string_view(manifest)) {}
+Pkg::Pkg(std::string path, const char *manifest): Package(path, std::string_view(manifest)) {}
+Pkg::Pkg(std::string path, const Json::Value &obj): Package(path, obj) {}
+Pkg::Pkg(std::string path, Package::checked &&fields): Package(path, std::move(fields)) {}
+
+// [bool] Nothing to run
+bool Pkg::run() {
+	return true;
+}
+
+namespace MTests {
+	// [string] Manifest text with the given dependency and optional dependency members
+	std::string manifestText(const std::string &name, const std::string &version, const std::string &dependencies,
+			const std::string &optional) {
+		std::string manifest = R"({"name": ")" + name + R"(", "version": ")" + version + "\"";
+		if (!dependencies.empty())
+			manifest += R"(, "dependencies": {)" + dependencies + "}";
+		if (!optional.empty())
+			manifest += R"(, "optionalDependencies": {)" + optional + "}";
+		return manifest + "}";
+	}
+
+	// [void] Write a file, creating its directory
+	void writeFile(const fs::path &file, const std::string &contents) {
+		fs::create_directories(file.parent_path());
+		std::ofstream(file, std::ios::binary) << contents;
+	}
+
+	// [void] Write a manifest into dir, creating it
+	void writeManifest(const fs::path &dir, const std::string &manifest) {
+		writeFile(dir / MPackages::Loader::manifestName, manifest);
+	}
+
+	// [Loader] Loader constructing Pkg objects
+	MPackages::Loader makeLoader(std::size_t threads) {
+		return MPackages::Loader([](std::string path, const MPackages::Manifest &manifest) {
+			return std::unique_ptr<MPackages::Package>(new Pkg(std::move(path), manifest));
+		}, threads);
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <filesystem>
+#include <json/json.h>
+
+#include <packages/package.hpp>
+#include <packages/manifest.hpp>
+#include <packages/loader.hpp>
+
+namespace MTests {
+
+// [class] Concrete package of the package tests; derived test packages override run
+class Pkg: public MPackages::Package {
+	public:
+		Pkg(std::string path, const MPackages::Manifest &manifest);
+		Pkg(std::string path, std::string_view manifest);
+		Pkg(std::string path, const std::string &manifest);
+		Pkg(std::string path, const char *manifest);
+		Pkg(std::string path, const Json::Value &obj);
+		Pkg(std::string path, MPackages::Package::checked &&fields);
+
+		bool run();
+};
+
+// Manifest text with the given dependency and optional dependency members
+std::string manifestText(const std::string &name, const std::string &version, const std::string &dependencies = "",
+	const std::string &optional = "");
+
+void writeFile(const std::filesystem::path &file, const std::string &contents); // Creates its directory
+void writeManifest(const std::filesystem::path &dir, const std::string &manifest); // Creates dir
+
+MPackages::Loader makeLoader(std::size_t threads = 2); // Constructs Pkg objects
+
+}
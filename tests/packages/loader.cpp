@@ -0,0 +1,105 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <string>
+
+#include <packages/loader.hpp>
+
+#include "fixture.hpp"
+
+using namespace MPackages;
+using namespace MTests;
+
+namespace fs = std::filesystem;
+
+
+TEST_CASE("loaders find and construct packages below root directories", "[loader]") {
+	fs::path root = fs::temp_directory_path() / "eden-loader-test";
+	fs::remove_all(root);
+
+	writeManifest(root / "a" / "one", R"({"name": "one", "version": "1.0.0"})");
+	writeManifest(root / "a" / "one" / "nested", R"({"name": "nested", "version": "1.0.0"})");
+	writeManifest(root / "b" / "deep" / "two", R"({"name": "two", "version": "2.0.0"})");
+	writeManifest(root / "c", R"({"name": "_invalid", "version": "1.0.0"})");
+	writeManifest(root / "d", R"({"name": "one", "version": "1.0.0+other"})");
+	fs::create_directories(root / "empty");
+
+	SECTION("packages are found, sorted by path, and errors are reported per manifest") {
+		for (std::size_t threads: {1, 4}) {
+			Loader loader = makeLoader(threads);
+			loader.addRoot(root.string());
+			loader.addRoot((root / "missing").string());
+
+			Loader::result result = loader.load();
+
+			REQUIRE(result.packages.size() == 2);
+			REQUIRE(result.packages[0]->name() == "one");
+			REQUIRE(result.packages[0]->path() == (root / "a" / "one").string());
+			REQUIRE(result.packages[1]->name() == "two");
+
+			REQUIRE(result.errors.size() == 3);
+			REQUIRE(result.errors[0].path == (root / "missing").string());
+			REQUIRE(result.errors[0].message == "MPackages::Loader::invalidRoot");
+			REQUIRE(result.errors[1].path == (root / "c" / Loader::manifestName).string());
+			REQUIRE(result.errors[1].message == "MPackages::Package::invalidName");
+			REQUIRE(result.errors[2].path == (root / "d" / Loader::manifestName).string());
+			REQUIRE(result.errors[2].message == "MPackages::Loader::duplicatePackage");
+
+			REQUIRE(result.time.total >= result.time.scan + result.time.validate);
+			REQUIRE(result.time.read.count() >= 0);
+			REQUIRE(result.time.parse.count() > 0);
+		}
+	}
+
+	SECTION("a root may itself be a package") {
+		Loader loader = makeLoader();
+		loader.addRoot((root / "b" / "deep" / "two").string());
+
+		Loader::result result = loader.load();
+		REQUIRE(result.packages.size() == 1);
+		REQUIRE(result.errors.empty());
+		REQUIRE(loader.roots().size() == 1);
+	}
+
+	SECTION("unchanged manifests are constructed from the cache") {
+		fs::path cache = fs::temp_directory_path() / "eden-loader-test.cache";
+		fs::remove(cache);
+
+		Loader loader = makeLoader();
+		loader.addRoot(root.string());
+		loader.setCache(cache.string());
+		REQUIRE(loader.cache() == cache.string());
+
+		Loader::result cold = loader.load();
+		REQUIRE(cold.cached == 0);
+		REQUIRE(fs::exists(cache));
+
+		Loader::result warm = loader.load();
+		REQUIRE(warm.cached == 3); // Including the duplicate, which is still rejected
+		REQUIRE(warm.packages.size() == 2);
+		REQUIRE(warm.packages[0]->name() == "one");
+		REQUIRE(warm.packages[0]->path() == (root / "a" / "one").string());
+		REQUIRE(warm.errors.size() == cold.errors.size());
+
+		// A changed manifest is parsed again; an invalid one falls out of the cache
+		writeManifest(root / "b" / "deep" / "two", R"({"name": "two", "version": "2.1.0"})");
+		writeManifest(root / "a" / "one", R"({"name": "one", "version": "1.0.0", "private": 1})");
+		for (fs::path changed: {root / "b" / "deep" / "two", root / "a" / "one"})
+			fs::last_write_time(changed / Loader::manifestName,
+				fs::last_write_time(changed / Loader::manifestName) + std::chrono::seconds(1));
+
+		Loader::result changed = loader.load();
+		REQUIRE(changed.cached == 1);
+		REQUIRE(changed.packages.size() == 2);
+		REQUIRE(changed.packages[0]->version() == MUtilities::Version("2.1.0"));
+		REQUIRE(changed.packages[1]->name() == "one");
+		REQUIRE(changed.packages[1]->path() == (root / "d").string());
+
+		REQUIRE(loader.load().cached == 2);
+		REQUIRE(ManifestCache(cache.string()).size() == 2);
+
+		fs::remove(cache);
+	}
+
+	fs::remove_all(root);
+}
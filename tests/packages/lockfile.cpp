@@ -0,0 +1,125 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <packages/loader.hpp>
+#include <packages/lockfile.hpp>
+
+#include "fixture.hpp"
+
+using namespace MPackages;
+using namespace MTests;
+
+namespace fs = std::filesystem;
+
+namespace {
+	// [vector of strings] Entries as name@version hash path
+	std::vector<std::string> lines(const Lockfile &lock) {
+		std::vector<std::string> out;
+		for (auto const &e: lock.entries())
+			out.push_back(std::string(e.name) + "@" + std::string(e.version) + " " + std::to_string(e.hash) + " " +
+				std::string(e.path));
+		return out;
+	}
+}
+
+TEST_CASE("lockfiles record resolved packages and their manifests", "[lockfile]") {
+	fs::path root = fs::temp_directory_path() / "eden-lockfile-test";
+	fs::remove_all(root);
+
+	writeManifest(root / "zeta", R"({"name": "zeta", "version": "1.0.0", "dependencies": {"res:alpha": "*"}})");
+	writeManifest(root / "alpha", R"({"name": "alpha", "version": "2.1.0-rc.1"})");
+	writeManifest(root / "with space", R"({"name": "spaced", "version": "0.1.0"})");
+
+	Loader loader = makeLoader();
+	loader.addRoot(root.string());
+	Registry registry(loader.load().packages);
+	REQUIRE(registry.size() == 3);
+
+	std::vector<Registry::id> ids{0, 1, 2};
+	Lockfile lock(registry, ids);
+
+	SECTION("entries are sorted by name and hash their manifest") {
+		REQUIRE(lock.size() == 3);
+		REQUIRE(lock.entries()[0].name == "alpha");
+		REQUIRE(lock.entries()[0].version == "2.1.0-rc.1");
+		REQUIRE(lock.entries()[0].path == (root / "alpha" / Loader::manifestName).string());
+		REQUIRE(lock.entries()[0].hash == MUtilities::Utility::fnv1a(R"({"name": "alpha", "version": "2.1.0-rc.1"})"));
+		REQUIRE(lock.entries()[2].name == "zeta");
+		REQUIRE(lock.text().rfind("# EdenGame lockfile 1\nalpha@2.1.0-rc.1 ", 0) == 0);
+	}
+
+	SECTION("both forms round trip") {
+		lock.write((root / "packages.lock").string());
+		lock.writeBinary((root / "packages.lockb").string());
+
+		Lockfile text((root / "packages.lock").string());
+		Lockfile binary((root / "packages.lockb").string());
+		REQUIRE(lines(text) == lines(lock));
+		REQUIRE(lines(binary) == lines(lock));
+		REQUIRE(binary.text() == lock.text());
+
+		Lockfile moved(std::move(binary));
+		REQUIRE(lines(moved) == lines(lock));
+	}
+
+	SECTION("changed and missing manifests are found") {
+		REQUIRE(lock.verify().empty());
+
+		writeManifest(root / "zeta", R"({"name": "zeta", "version": "1.0.0"})");
+		fs::remove(root / "with space" / Loader::manifestName);
+		REQUIRE(lock.verify(1) == std::vector<std::size_t>{1, 2});
+	}
+
+	SECTION("loaders boot from a lockfile without scanning") {
+		writeManifest(root / "unlocked", R"({"name": "unlocked", "version": "1.0.0"})");
+
+		Loader::result result = loader.load(lock);
+		REQUIRE(result.errors.empty());
+		REQUIRE(result.packages.size() == 3);
+		REQUIRE(result.packages[0]->name() == "alpha");
+		REQUIRE(result.time.scan.count() == 0);
+
+		writeManifest(root / "alpha", R"({"name": "alpha", "version": "2.1.0"})");
+		result = loader.load(lock);
+		REQUIRE(result.packages.size() == 2);
+		REQUIRE(result.errors.size() == 1);
+		REQUIRE(result.errors[0].path == (root / "alpha" / Loader::manifestName).string());
+		REQUIRE(result.errors[0].message == "MPackages::Loader::lockMismatch");
+	}
+
+	SECTION("locked manifests are constructed from the cache once verified") {
+		loader.setCache((root / "manifests.cache").string());
+		REQUIRE(loader.load(lock).cached == 0);
+
+		Loader::result result = loader.load(lock);
+		REQUIRE(result.errors.empty());
+		REQUIRE(result.cached == 3);
+
+		// A changed manifest fails its hash before its cached record is looked up
+		writeManifest(root / "alpha", R"({"name": "alpha", "version": "2.1.1"})");
+		result = loader.load(lock);
+		REQUIRE(result.cached == 2);
+		REQUIRE(result.errors[0].message == "MPackages::Loader::lockMismatch");
+	}
+
+	SECTION("invalid lockfiles are rejected") {
+		std::ofstream(root / "bad.lock") << "# comment\nalpha@1.0.0 12345 path\n";
+		REQUIRE_THROWS_WITH(Lockfile((root / "bad.lock").string()), "MPackages::Lockfile::invalidFile");
+
+		lock.writeBinary((root / "packages.lockb").string());
+		fs::resize_file(root / "packages.lockb", fs::file_size(root / "packages.lockb") - 1);
+		REQUIRE_THROWS_WITH(Lockfile((root / "packages.lockb").string()), "MPackages::Lockfile::invalidFile");
+
+		REQUIRE_THROWS_WITH(Lockfile((root / "missing.lock").string()), "MPackages::Lockfile::openFailed");
+		REQUIRE(Lockfile().size() == 0);
+
+		registry.add(std::unique_ptr<Package>(new Pkg("nowhere", Manifest(R"({"name": "ghost", "version": "1.0.0"})"))));
+		REQUIRE_THROWS_WITH(Lockfile(registry, {3}), "MPackages::Lockfile::unreadableManifest");
+	}
+
+	fs::remove_all(root);
+}
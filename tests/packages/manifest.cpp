@@ -0,0 +1,116 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+
+#include <utilities/utility.hpp>
+#include <packages/package.hpp>
+
+#include "fixture.hpp"
+
+using namespace MPackages;
+using namespace MTests;
+
+namespace {
+	// [string] Error thrown while constructing a package from a DOM, or "" if none
+	std::string domError(const std::string &manifest) {
+		try {
+			Pkg("", MUtilities::Utility::stojson(manifest));
+		} catch (const char *e) {
+			return e;
+		}
+		return "";
+	}
+
+	// [string] Error thrown while streaming a package from manifest text, or "" if none
+	std::string streamError(const std::string &manifest) {
+		try {
+			Pkg("", std::string_view(manifest));
+		} catch (const char *e) {
+			return e;
+		}
+		return "";
+	}
+}
+
+TEST_CASE("manifests can be streamed into packages", "[manifest]") {
+	SECTION("all fields are parsed accurately") {
+		std::string str = R"r({"name": "pkg", "version": "0.1.0", "title": "Package",)r"
+			R"r("description": "My Package", "keywords": ["one", "two"], "homepage": "https://doe.com",)r"
+			R"r("bugs": {"url": "https://doe.com", "email": "j@doe.com"}, "license": "MIT",)r"
+			R"r("author": "John Doe <j@doe.com> (https://doe.com)", "contributors": ["Johnny Doe", {"name": "Johnson Doe"}],)r"
+			R"r("repository": "https://doe.com/repo.git", "dependencies": {"ssm:one": ">1.2.6",)r"
+			R"r("csm:two": ">3.1.7"}, "optionalDependencies": {"res:another": ">0.1.0"}, "private": true})r";
+		Pkg pkg("", std::string_view(str));
+
+		REQUIRE(pkg.name() == "pkg");
+		REQUIRE(pkg.version() == "0.1.0");
+		REQUIRE(pkg.title() == "Package");
+		REQUIRE(pkg.description() == "My Package");
+		REQUIRE(std::vector<std::string_view>(pkg.keywords().begin(), pkg.keywords().end()) ==
+			std::vector<std::string_view>{"one", "two"});
+		REQUIRE(pkg.homepage() == "https://doe.com");
+		REQUIRE(pkg.bugs().first == "https://doe.com");
+		REQUIRE(pkg.bugs().second == "j@doe.com");
+		REQUIRE(pkg.license() == "MIT");
+		REQUIRE(pkg.author() == std::string("John Doe <j@doe.com> (https://doe.com)"));
+		REQUIRE(pkg.contributors()[0] == std::string("Johnny Doe"));
+		REQUIRE(pkg.contributors()[1] == std::string("Johnson Doe"));
+		REQUIRE(pkg.repository() == "https://doe.com/repo.git");
+		REQUIRE(pkg.dependencies().at("ssm:one") == ">1.2.6");
+		REQUIRE(pkg.dependencies().at("csm:two") == ">3.1.7");
+		REQUIRE(pkg.optionalDependencies().at("res:another") == ">0.1.0");
+		REQUIRE(pkg.isPrivate());
+	}
+
+	SECTION("escapes, comments and unknown fields are handled") {
+		std::string str = "// manifest\n{\"name\": \"pkg\", /* required */ \"version\": \"0.1.0\","
+			"\"title\": \"Tab\\there \\u00e9\\ud83d\\ude00\", \"extra\": {\"nested\": [1, 2.5e3, null, true]}}";
+		Pkg pkg("", std::string_view(str));
+
+		REQUIRE(pkg.title() == "Tab\there \xC3\xA9\xF0\x9F\x98\x80");
+		REQUIRE_FALSE(pkg.isPrivate());
+		REQUIRE_FALSE(pkg.hasAuthor());
+	}
+
+	SECTION("malformed manifests are rejected") {
+		REQUIRE(streamError(R"({"name": "pkg", "version": "0.1.0")") == "MPackages::Package::invalidManifest");
+		REQUIRE(streamError(R"({"name": "pkg" "version": "0.1.0"})") == "MPackages::Package::invalidManifest");
+		REQUIRE(streamError(R"({"name": "pkg", "version": "0.1.0", "title": "\q"})") ==
+			"MPackages::Package::invalidManifest");
+		REQUIRE(streamError(R"(["pkg"])") == "MPackages::Package::invalidManifest");
+		REQUIRE(streamError("") == "MPackages::Package::invalidManifest");
+	}
+}
+
+TEST_CASE("streamed manifests are validated like JSON documents", "[manifest]") {
+	const char *manifests[] = {
+		R"({"name": "pkg", "version": "0.1.0"})",
+		R"({"title": "Hello World!"})",
+		R"({"name": "_package", "version": "0.1.0"})",
+		R"({"name": "pkg", "version": "0.1.0-rc.0"})",
+		R"({"name": "pkg", "version": "0.1.0", "homepage": "doe.com"})",
+		R"({"name": "pkg", "version": "0.1.0", "keywords": ["one", 2]})",
+		R"({"name": "pkg", "version": "0.1.0", "bugs": {"url": "https://doe.com"}})",
+		R"({"name": "pkg", "version": "0.1.0", "author": {"name": "J0hn", "email": 5}})",
+		R"({"name": "pkg", "version": "0.1.0", "author": {"name": "John", "email": 5}})",
+		R"({"name": "pkg", "version": "0.1.0", "contributors": ["John Doe", 7]})",
+		R"({"name": "pkg", "version": "0.1.0", "repository": "https://doe.com/repo"})",
+		R"({"name": "pkg", "version": "0.1.0", "dependencies": {}})",
+		R"({"name": "pkg", "version": "0.1.0", "dependencies": {"ssm:pkg": null, "invalid": null}})",
+		R"({"name": "pkg", "version": "0.1.0", "dependencies": {"ssm:pkg": "0.1.0", "invalid:pkg": "0.1.0"}})",
+		R"({"name": "pkg", "version": "0.1.0", "optionalDependencies": {"res:pkg": 1}})",
+		R"({"name": "pkg", "version": "0.1.0", "private": "yes"})",
+		// Several errors: the field validated first wins, not the one that comes first in the text
+		R"({"private": 1, "title": 2, "version": "0.1.0", "name": "pkg"})",
+		// Repeated keys: the last value counts
+		R"({"name": "_bad", "version": "0.1.0", "name": "pkg"})",
+		R"({"name": "pkg", "version": "0.1.0", "name": "_bad"})",
+		R"({"name": "pkg", "version": "0.1.0", "dependencies": {"ssm:pkg": "x", "ssm:pkg": "0.1.0"}})"
+	};
+
+	for (auto manifest: manifests) {
+		INFO(manifest);
+		REQUIRE(streamError(manifest) == domError(manifest));
+	}
+}
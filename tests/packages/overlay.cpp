@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <packages/overlay.hpp>
+
+#include "fixture.hpp"
+
+using namespace MPackages;
+using namespace MTests;
+
+namespace fs = std::filesystem;
+
+namespace {
+	// [string] Contents of the file a path resolves to
+	std::string read(const Overlay &overlay, std::string_view path) {
+		std::string buffer;
+		return std::string(overlay.read(path, buffer));
+	}
+}
+
+TEST_CASE("overlays layer the files of packages in load order", "[overlay]") {
+	fs::path root = fs::temp_directory_path() / "eden-overlay-test";
+	fs::remove_all(root);
+
+	writeFile(root / "base" / "textures" / "stone.png", "base stone");
+	writeFile(root / "base" / "textures" / "dirt.png", "base dirt");
+	writeFile(root / "base" / "scripts" / "init.lua", "base init");
+	writeFile(root / "mod" / "textures" / "stone.png", "mod stone");
+	writeFile(root / "mod" / "scripts" / "mod.lua", "mod script");
+	writeFile(root / "patch" / "textures" / "stone.png", "patch stone");
+
+	Overlay overlay;
+	Overlay::handle base = overlay.mount("base", (root / "base").string());
+	Overlay::handle mod = overlay.mount("mod", (root / "mod").string());
+
+	SECTION("paths resolve to the last mount having them") {
+		REQUIRE(overlay.size() == 4);
+		REQUIRE(overlay.files(base) == 3);
+		REQUIRE(overlay.mounts() == std::vector<Overlay::handle>({base, mod}));
+
+		REQUIRE(read(overlay, "textures/stone.png") == "mod stone");
+		REQUIRE(read(overlay, "textures/dirt.png") == "base dirt");
+		REQUIRE(read(overlay, "scripts/mod.lua") == "mod script");
+		REQUIRE(overlay.owner("textures/stone.png") == mod);
+		REQUIRE(overlay.owner("scripts/init.lua") == base);
+
+		std::string buffer;
+		REQUIRE(overlay.read(base, "textures/stone.png", buffer) == "base stone");
+		REQUIRE_THROWS_WITH(overlay.read(base, "scripts/mod.lua", buffer), "MPackages::Overlay::missingFile");
+	}
+
+	SECTION("missing paths and mounts are reported") {
+		REQUIRE(!overlay.exists("textures"));
+		REQUIRE(!overlay.exists("/textures/stone.png"));
+		REQUIRE(overlay.owner("missing.png") == Overlay::none);
+		REQUIRE_THROWS_WITH(read(overlay, "missing.png"), "MPackages::Overlay::missingFile");
+		REQUIRE_THROWS_WITH(overlay.mount("missing", (root / "missing").string()), "MPackages::Overlay::invalidMount");
+		REQUIRE_THROWS_WITH(overlay.files(7), "MPackages::Overlay::invalidMount");
+	}
+
+	SECTION("unmounting uncovers shadowed files") {
+		Overlay::handle patch = overlay.mount("patch", (root / "patch").string());
+		REQUIRE(read(overlay, "textures/stone.png") == "patch stone");
+
+		overlay.unmount(mod);
+		REQUIRE(read(overlay, "textures/stone.png") == "patch stone");
+		REQUIRE(!overlay.exists("scripts/mod.lua"));
+		REQUIRE(overlay.size() == 3);
+
+		overlay.unmount(patch);
+		REQUIRE(read(overlay, "textures/stone.png") == "base stone");
+		REQUIRE(overlay.mounts() == std::vector<Overlay::handle>({base}));
+
+		overlay.unmount(base);
+		REQUIRE(overlay.size() == 0);
+		REQUIRE_THROWS_WITH(overlay.unmount(base), "MPackages::Overlay::invalidMount");
+	}
+
+	SECTION("remounting picks up changes and keeps the load order") {
+		writeFile(root / "base" / "textures" / "grass.png", "base grass");
+		writeFile(root / "base" / "scripts" / "mod.lua", "base script");
+		fs::remove(root / "base" / "textures" / "dirt.png");
+		overlay.remount(base);
+
+		REQUIRE(overlay.size() == 4);
+		REQUIRE(read(overlay, "textures/grass.png") == "base grass");
+		REQUIRE(!overlay.exists("textures/dirt.png"));
+		REQUIRE(read(overlay, "scripts/mod.lua") == "mod script");
+		REQUIRE(read(overlay, "textures/stone.png") == "mod stone");
+
+		overlay.unmount(mod);
+		REQUIRE(read(overlay, "scripts/mod.lua") == "base script");
+		REQUIRE(read(overlay, "textures/stone.png") == "base stone");
+
+		fs::remove_all(root / "base");
+		REQUIRE_THROWS_WITH(overlay.remount(base), "MPackages::Overlay::invalidMount");
+		REQUIRE(overlay.mounts().empty());
+		REQUIRE(overlay.size() == 0);
+	}
+
+	SECTION("archives mount like directories") {
+		std::string file = (root / "patch").string() + Archive::extension;
+		Archive::pack((root / "patch").string(), file);
+		Pkg pkg((root / "patch").string(), R"({"name": "patch", "version": "1.0.0"})");
+		fs::remove_all(root / "patch");
+
+		Overlay::handle patch = overlay.mount(pkg);
+		REQUIRE(overlay.path(patch) == file);
+		REQUIRE(overlay.mounted("patch") == patch);
+		REQUIRE(overlay.name(patch) == "patch");
+
+		std::string buffer;
+		REQUIRE(overlay.read("textures/stone.png", buffer) == "patch stone");
+		REQUIRE(buffer.empty());
+
+		overlay.unmount(mod);
+		overlay.unmount(patch);
+		REQUIRE(read(overlay, "textures/stone.png") == "base stone");
+		REQUIRE(overlay.mounted("patch") == Overlay::none);
+	}
+
+	SECTION("packages without an archive mount their directory") {
+		Pkg pkg((root / "patch").string(), R"({"name": "patch", "version": "1.0.0"})");
+		Overlay::handle patch = overlay.mount(pkg);
+		REQUIRE(overlay.path(patch) == (root / "patch").string());
+		REQUIRE(read(overlay, "textures/stone.png") == "patch stone");
+	}
+
+	fs::remove_all(root);
+}
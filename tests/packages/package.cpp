@@ -3,9 +3,13 @@
 
 #include <utilities/utility.hpp>
 #include <fstream>
+#include <memory>
+#include <cstdint>
 
 #include <packages/package.hpp>
 
+#include "fixture.hpp"
+
 using namespace MPackages;
 
 class Pkg: public Package {
@@ -97,3 +101,111 @@ TEST_CASE("package objects are generated based off of json data", "[package]") {
 		REQUIRE(pkg.isPrivate() == false);
 	}
 }
+
+TEST_CASE("package getters expose stored fields without copying", "[package]") {
+	Pkg pkg("catalog/pkg", MUtilities::Utility::stojson(R"({"name": "pkg", "version": "0.1.0", "keywords": ["one"],)"
+		R"("contributors": ["Johnny Doe"], "dependencies": {"ssm:one": ">1.2.6"}})"));
+
+	SECTION("references refer to the package's own storage") {
+		REQUIRE(pkg.name().data() == pkg.name().data());
+		REQUIRE(&pkg.keywords() == &pkg.keywords());
+		REQUIRE(&pkg.contributors() == &pkg.contributors());
+		REQUIRE(&pkg.dependencies() == &pkg.dependencies());
+		REQUIRE(pkg.path() == "catalog/pkg");
+		REQUIRE(pkg.version().major() == 0);
+	}
+
+	SECTION("fields live in one block owned by the package") {
+		// Everything is within one block, no larger than the package's memory usage
+		auto distance = [&](const void *p) {
+			auto a = reinterpret_cast<std::uintptr_t>(p), b = reinterpret_cast<std::uintptr_t>(pkg.keywords().begin());
+			return a > b ? a - b : b - a;
+		};
+		REQUIRE(distance(pkg.name().data()) < pkg.memoryUsage());
+		REQUIRE(distance(pkg.contributors().begin()) < pkg.memoryUsage());
+		REQUIRE(distance(pkg.dependencies().begin()) < pkg.memoryUsage());
+		REQUIRE(pkg.dependencies().find("ssm:one")->second == ">1.2.6");
+		REQUIRE(pkg.dependencies().find("ssm:two") == pkg.dependencies().end());
+		REQUIRE_THROWS_WITH(pkg.dependencies().at("ssm:two"), "MPackages::DependencyList::missingDependency");
+	}
+
+	SECTION("the author is optional") {
+		REQUIRE_FALSE(pkg.hasAuthor());
+		REQUIRE_THROWS(pkg.author());
+
+		Pkg authored("", MUtilities::Utility::stojson(R"({"name": "pkg", "version": "0.1.0", "author": "John Doe"})"));
+		REQUIRE(authored.hasAuthor());
+		REQUIRE(authored.author().name() == "John Doe");
+	}
+
+	SECTION("packages can be owned through a base pointer") {
+		std::unique_ptr<Package> owned(new Pkg("", MUtilities::Utility::stojson(
+			R"({"name": "pkg", "version": "0.1.0", "author": {"name": "John Doe"}})")));
+		REQUIRE(owned->author().name() == "John Doe");
+	}
+}
+
+TEST_CASE("manifests can be parsed without throwing", "[package]") {
+	SECTION("valid manifests are constructed") {
+		Json::Value manifest = MUtilities::Utility::stojson(R"({"name": "pkg", "version": "0.1.0", "keywords": ["one"],)"
+			R"("contributors": ["John Doe"], "dependencies": {"ssm:one": ">1.2.6"}})");
+		Package::parsed<MTests::Pkg> result = Package::tryParse<MTests::Pkg>("catalog/pkg", manifest);
+		REQUIRE(result.diagnostics.empty());
+		REQUIRE(result.package);
+		REQUIRE(result.package->path() == "catalog/pkg");
+		REQUIRE(result.package->name() == "pkg");
+		REQUIRE(result.package->keywords()[0] == "one");
+		REQUIRE(result.package->contributors()[0].name() == "John Doe");
+		REQUIRE(result.package->dependencies().at("ssm:one") == ">1.2.6");
+
+		// The constructor still validates documents that were not just checked
+		REQUIRE_THROWS_WITH(MTests::Pkg("", MUtilities::Utility::stojson(R"({"name": "pkg"})")),
+			"MPackages::Package::invalidVersion");
+	}
+
+	SECTION("every error of a manifest is reported, with its location") {
+		Package::parsed<MTests::Pkg> result = Package::tryParse<MTests::Pkg>("", MUtilities::Utility::stojson(
+			R"({"name": "x", "version": "1.2", "keywords": ["one", 2, "three", false],)"
+			R"("bugs": {"url": "http://bugs.com"}, "contributors": ["John Doe", "<j@doe.com>"],)"
+			R"("dependencies": {"ssm:one": ">1.0", "ssm:two": 2, "ssm:a/b": 3}, "private": "no"})"));
+		REQUIRE_FALSE(result.package);
+
+		std::vector<std::string> fields, paths, codes;
+		for (auto const &d: result.diagnostics) {
+			fields.push_back(d.field);
+			paths.push_back(d.path);
+			codes.push_back(d.code);
+		}
+		REQUIRE(fields == std::vector<std::string>({"name", "version", "keywords", "keywords", "bugs", "contributors",
+			"dependencies", "dependencies", "dependencies", "private"}));
+		REQUIRE(paths == std::vector<std::string>({"/name", "/version", "/keywords/1", "/keywords/3", "/bugs/email",
+			"/contributors/1", "/dependencies/ssm:a~1b", "/dependencies/ssm:one", "/dependencies/ssm:two", "/private"}));
+		REQUIRE(codes == std::vector<std::string>({"MPackages::Package::invalidName",
+			MUtilities::Version::errorString(MUtilities::Version::ParseError::invalidVersionStructure),
+			"MPackages::Package::invalidKeyword", "MPackages::Package::invalidKeyword",
+			"MPackages::Package::invalidBugReportemail", "MUtilities::Person::invalidPersonString",
+			"MPackages::Package::invalidDependency",
+			MUtilities::Version::errorString(MUtilities::Version::ParseError::invalidVersionStructure),
+			"MPackages::Package::invalidDependency", "MPackages::Package::invalidPrivateStatus"}));
+	}
+
+	SECTION("the codes are those the constructor throws first") {
+		Json::Value manifest = MUtilities::Utility::stojson(R"({"name": "pkg", "version": "1.0.0", "title": 1,)"
+			R"("license": []})");
+		Package::parsed<MTests::Pkg> result = Package::tryParse<MTests::Pkg>("", manifest);
+		REQUIRE(result.diagnostics.size() == 2);
+		REQUIRE_THROWS_WITH(MTests::Pkg("", manifest), result.diagnostics[0].code);
+	}
+
+	SECTION("documents that are not objects are reported as a whole") {
+		Package::parsed<MTests::Pkg> result = Package::tryParse<MTests::Pkg>("", MUtilities::Utility::stojson("[1, 2]"));
+		REQUIRE(result.diagnostics.size() == 1);
+		REQUIRE(result.diagnostics[0].field.empty());
+		REQUIRE(result.diagnostics[0].path.empty());
+		REQUIRE(result.diagnostics[0].code == std::string("MPackages::Package::invalidManifest"));
+
+		// The constructor throws the same code, as it does for streamed manifests
+		REQUIRE_THROWS_WITH(MTests::Pkg("", Json::Value()), "MPackages::Package::invalidManifest");
+		REQUIRE_THROWS_WITH(MTests::Pkg("", MUtilities::Utility::stojson("[1, 2]")), "MPackages::Package::invalidManifest");
+	}
+}
@@ -0,0 +1,96 @@
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <packages/registry.hpp>
+
+#include "fixture.hpp"
+
+using namespace MPackages;
+using namespace MUtilities;
+using namespace MTests;
+
+namespace {
+	// [unique_ptr] Package with just a name and version
+	std::unique_ptr<Package> make(const std::string &name, const std::string &version) {
+		return std::unique_ptr<Package>(new Pkg(name + "@" + version, manifestText(name, version)));
+	}
+}
+
+TEST_CASE("registries index packages by name and version", "[registry]") {
+	std::vector<std::unique_ptr<Package>> packages;
+	for (const char *v: {"1.2.0", "1.0.0", "2.0.0-rc.1", "2.0.0", "1.10.0"})
+		packages.push_back(make("foo", v));
+	packages.push_back(make("bar", "0.1.0"));
+
+	Registry registry(std::move(packages));
+	REQUIRE(registry.size() == 6);
+	REQUIRE(registry.nameCount() == 2);
+
+	SECTION("versions of a name are listed in ascending precedence") {
+		std::vector<std::string> paths;
+		for (Registry::id i: registry.versions("foo"))
+			paths.emplace_back(registry.get(i).path());
+
+		REQUIRE(paths == std::vector<std::string>{"foo@1.0.0", "foo@1.2.0", "foo@1.10.0", "foo@2.0.0-rc.1", "foo@2.0.0"});
+		REQUIRE(registry.versions("missing").empty());
+	}
+
+	SECTION("lookups accept dependency keys and ranges") {
+		REQUIRE(registry.get(registry.maxSatisfying("collection:foo", Range(">=1.0.0 <1.20.0"))).path() == "foo@1.10.0");
+		REQUIRE(registry.get(registry.maxSatisfying("foo", Range(">=1.0.0"))).path() == "foo@2.0.0");
+		REQUIRE(registry.maxSatisfying("res:foo", Range(">=3.0.0")) == Registry::none);
+		REQUIRE(registry.maxSatisfying("res:baz", Range(">=0.0.0")) == Registry::none);
+
+		std::vector<Registry::id> all = registry.allSatisfying("ssm:foo", Range("<1.5.0 || >=2.0.0"));
+		REQUIRE(all.size() == 3);
+		REQUIRE(registry.get(all[0]).path() == "foo@1.0.0");
+		REQUIRE(registry.get(all[2]).path() == "foo@2.0.0");
+
+		REQUIRE(registry.get(registry.find("bar", Version("0.1.0"))).name() == "bar");
+		REQUIRE(registry.find("bar", Version("0.2.0")) == Registry::none);
+	}
+
+	SECTION("ids are dense and stable") {
+		Registry::id id = registry.add(make("baz", "1.0.0"));
+		REQUIRE(id == 6);
+		REQUIRE(registry.get(id).name() == "baz");
+		REQUIRE(registry.get(0).path() == "foo@1.2.0");
+		REQUIRE_THROWS_WITH(registry.get(7), "MPackages::Registry::invalidId");
+	}
+
+	SECTION("a name and version may only be added once") {
+		REQUIRE_THROWS_WITH(registry.add(make("foo", "1.0.0+meta")), "MPackages::Registry::duplicatePackage");
+		REQUIRE(registry.size() == 6);
+		REQUIRE(registry.versions("foo").size() == 5);
+	}
+
+	SECTION("replaced packages keep their id") {
+		Registry::id id = registry.find("foo", Version("1.2.0"));
+		registry.replace(id, make("foo", "1.2.0"));
+		REQUIRE(registry.find("foo", Version("1.2.0")) == id);
+
+		registry.replace(id, make("foo", "3.0.0"));
+		REQUIRE(registry.find("foo", Version("1.2.0")) == Registry::none);
+		REQUIRE(registry.maxSatisfying("foo", Range("*")) == id);
+		REQUIRE(registry.versions("foo").size() == 5);
+
+		// The first package added holds the name the index is keyed by
+		registry.replace(registry.find("bar", Version("0.1.0")), make("bar", "0.1.0"));
+		REQUIRE(registry.versions("bar").size() == 1);
+
+		REQUIRE_THROWS_WITH(registry.replace(id, make("qux", "1.0.0")), "MPackages::Registry::renamedPackage");
+		REQUIRE_THROWS_WITH(registry.replace(id, make("foo", "2.0.0")), "MPackages::Registry::duplicatePackage");
+		REQUIRE_THROWS_WITH(registry.replace(9, make("foo", "9.0.0")), "MPackages::Registry::invalidId");
+	}
+
+	SECTION("memory is reported for packages and the index") {
+		Registry::memory m = registry.memoryUsage();
+		REQUIRE(m.count == 6);
+		REQUIRE(m.packages >= 6 * sizeof(Package));
+		REQUIRE(m.index > 0);
+		REQUIRE(m.perPackage() == Approx(static_cast<double>(m.index) / 6));
+	}
+}
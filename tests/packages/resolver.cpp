@@ -0,0 +1,287 @@
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <packages/resolver.hpp>
+
+#include "fixture.hpp"
+
+using namespace MPackages;
+using namespace MTests;
+using MUtilities::Range;
+
+namespace {
+	// [void] Add a package with the given dependency and optional dependency members
+	void add(Registry &registry, const std::string &name, const std::string &version, const std::string &dependencies = "",
+			const std::string &optional = "") {
+		registry.add(std::unique_ptr<Package>(new Pkg(name + "@" + version,
+			manifestText(name, version, dependencies, optional))));
+	}
+
+	// [void] Replace a package by a manifest with other dependencies
+	void replace(Registry &registry, const std::string &name, const std::string &version,
+			const std::string &dependencies = "") {
+		registry.replace(registry.find(name, MUtilities::Version(version)),
+			std::unique_ptr<Package>(new Pkg(name + "@" + version, manifestText(name, version, dependencies))));
+	}
+
+	// [vector of strings] Version swaps as name@from -> name@to, with "-" for none
+	std::vector<std::string> swaps(const Registry &registry, const Resolver::result &result) {
+		std::vector<std::string> out;
+		for (auto const &s: result.delta)
+			out.push_back(std::string((s.from == Registry::none) ? "-" : registry.get(s.from).path()) + " -> " +
+				std::string((s.to == Registry::none) ? "-" : registry.get(s.to).path()));
+		return out;
+	}
+
+	// [vector of strings] Paths (name@version) of the chosen packages
+	std::vector<std::string> chosen(const Registry &registry, const Resolver::result &result) {
+		std::vector<std::string> out;
+		for (Registry::id id: result.packages)
+			out.emplace_back(registry.get(id).path());
+		return out;
+	}
+}
+
+TEST_CASE("resolvers choose one version per package", "[resolver]") {
+	Registry registry;
+
+	SECTION("the newest versions are chosen when nothing conflicts") {
+		add(registry, "app", "1.0.0", R"("res:lib": ">=1.0.0 <2.0.0", "ssm:util": "*")");
+		add(registry, "lib", "1.0.0");
+		add(registry, "lib", "1.4.0", R"("ssm:util": "<3.0.0")");
+		add(registry, "lib", "2.0.0");
+		add(registry, "util", "1.0.0");
+		add(registry, "util", "2.5.0");
+		add(registry, "util", "3.0.0");
+		add(registry, "unused", "1.0.0");
+
+		Resolver resolver(registry);
+		Resolver::result result = resolver.resolve(registry.find("app", MUtilities::Version("1.0.0")));
+
+		REQUIRE(result.solved);
+		REQUIRE(chosen(registry, result) == std::vector<std::string>{"app@1.0.0", "lib@1.4.0", "util@2.5.0"});
+		REQUIRE(result.explanation.empty());
+	}
+
+	SECTION("conflicts are learned and backtracked out of") {
+		// The newest foo needs a bar that needs a baz that boo rules out
+		add(registry, "foo", "1.0.0", R"("res:bar": "1.0.0")");
+		add(registry, "foo", "2.0.0", R"("res:bar": "2.0.0")");
+		add(registry, "bar", "1.0.0", R"("res:baz": "1.0.0")");
+		add(registry, "bar", "2.0.0", R"("res:baz": "2.0.0")");
+		add(registry, "baz", "1.0.0");
+		add(registry, "baz", "2.0.0");
+		add(registry, "boo", "1.0.0", R"("res:baz": "1.0.0")");
+
+		Resolver resolver(registry);
+		Resolver::result result = resolver.resolve({{"res:foo", Range("*")}, {"res:boo", Range("*")}});
+
+		REQUIRE(result.solved);
+		REQUIRE(chosen(registry, result) == std::vector<std::string>{"bar@1.0.0", "baz@1.0.0", "boo@1.0.0", "foo@1.0.0"});
+		REQUIRE(result.conflicts > 0);
+	}
+
+	SECTION("packages left undecided by a conflict are still decided") {
+		// Deciding util conflicts with lib 2.0.0 while util is still waiting for a version
+		add(registry, "app", "1.0.0", R"("res:lib": "*", "res:util": "1.0.0")");
+		add(registry, "lib", "1.0.0");
+		add(registry, "lib", "2.0.0");
+		add(registry, "util", "1.0.0", "", R"("res:lib": "1.0.0")");
+
+		Resolver resolver(registry);
+		Resolver::result result = resolver.resolve({{"app", Range("*")}});
+
+		REQUIRE(result.solved);
+		REQUIRE(chosen(registry, result) == std::vector<std::string>{"app@1.0.0", "lib@1.0.0", "util@1.0.0"});
+	}
+
+	SECTION("optional dependencies only constrain packages that are chosen anyway") {
+		add(registry, "app", "1.0.0", R"("res:lib": "*")", R"("csm:extra": ">=2.0.0")");
+		add(registry, "lib", "1.0.0", R"("csm:extra": "<3.0.0")");
+		add(registry, "lib", "2.0.0", R"("csm:extra": "<2.0.0")");
+		add(registry, "extra", "1.0.0");
+		add(registry, "extra", "2.0.0");
+
+		Resolver resolver(registry);
+		Resolver::result result = resolver.resolve({{"app", Range("1.0.0")}});
+		REQUIRE(result.solved);
+		REQUIRE(chosen(registry, result) == std::vector<std::string>{"app@1.0.0", "extra@2.0.0", "lib@1.0.0"});
+
+		result = resolver.resolve({{"app", Range("1.0.0")}, {"lib", Range("2.0.0")}});
+		REQUIRE_FALSE(result.solved);
+
+		add(registry, "solo", "1.0.0", "", R"("csm:extra": ">=5.0.0")");
+		result = resolver.resolve({{"solo", Range("*")}});
+		REQUIRE(result.solved);
+		REQUIRE(chosen(registry, result) == std::vector<std::string>{"solo@1.0.0"});
+	}
+
+	SECTION("failures are explained step by step") {
+		add(registry, "foo", "1.0.0", R"("res:shared": "<2.0.0")");
+		add(registry, "foo", "1.1.0", R"("res:shared": "<2.0.0")");
+		add(registry, "bar", "1.0.0", R"("res:shared": ">=2.0.0")");
+		add(registry, "shared", "1.0.0");
+		add(registry, "shared", "2.0.0");
+
+		Resolver resolver(registry);
+		Resolver::result result = resolver.resolve({{"foo", Range("*")}, {"bar", Range("*")}});
+
+		REQUIRE_FALSE(result.solved);
+		REQUIRE(result.packages.empty());
+		REQUIRE(result.explanation.find("foo >=1.0.0 <=1.1.0 depends on shared <2.0.0") != std::string::npos);
+		REQUIRE(result.explanation.find("bar 1.0.0 depends on shared >=2.0.0") != std::string::npos);
+		REQUIRE(result.explanation.find("version solving failed.") != std::string::npos);
+		REQUIRE(result.explanation.find("foo is forbidden (4)") != std::string::npos);
+		REQUIRE(result.explanation.rfind("(1) Because", 0) == 0);
+	}
+
+	SECTION("missing packages and versions are reported") {
+		add(registry, "app", "1.0.0", R"("res:ghost": "*")");
+		add(registry, "lib", "1.0.0");
+
+		Resolver resolver(registry);
+		Resolver::result result = resolver.resolve({{"app", Range("*")}});
+		REQUIRE_FALSE(result.solved);
+		REQUIRE(result.explanation.find("no package named ghost is available") != std::string::npos);
+
+		result = resolver.resolve({{"lib", Range(">=2.0.0")}});
+		REQUIRE_FALSE(result.solved);
+		REQUIRE(result.explanation.find("no versions of lib >=2.0.0 are available") != std::string::npos);
+	}
+
+	SECTION("dependency cycles resolve") {
+		add(registry, "ping", "1.0.0", R"("res:pong": "1.0.0")");
+		add(registry, "pong", "1.0.0", R"("res:ping": "1.0.0", "res:pong": "*")");
+
+		Resolver resolver(registry);
+		Resolver::result result = resolver.resolve({{"ping", Range("*")}});
+		REQUIRE(result.solved);
+		REQUIRE(chosen(registry, result) == std::vector<std::string>{"ping@1.0.0", "pong@1.0.0"});
+	}
+}
+
+TEST_CASE("resolvers update their last solution", "[resolver]") {
+	Registry registry;
+
+	SECTION("a solution that still holds is kept without searching") {
+		add(registry, "app", "1.0.0", R"("res:lib": "*", "res:util": "*")");
+		add(registry, "lib", "1.0.0");
+		add(registry, "lib", "2.0.0", R"("res:util": ">=2.0.0")");
+		add(registry, "util", "1.0.0");
+		add(registry, "util", "2.0.0");
+		add(registry, "extra", "1.0.0");
+
+		Resolver resolver(registry);
+		REQUIRE_THROWS_WITH(resolver.update({}), "MPackages::Resolver::notResolved");
+
+		Resolver::result result = resolver.resolve({{"app", Range("*")}});
+		REQUIRE(result.delta.size() == 3);
+		REQUIRE(result.delta[0].from == Registry::none);
+
+		// Newer versions alone do not move a solution
+		Registry::id util = registry.add(std::unique_ptr<Package>(new Pkg("util@3.0.0",
+			R"({"name": "util", "version": "3.0.0"})")));
+		replace(registry, "lib", "2.0.0", R"("res:util": ">=1.0.0")");
+		result = resolver.update({util, registry.find("lib", MUtilities::Version("2.0.0"))});
+		REQUIRE(result.solved);
+		REQUIRE(result.decisions == 0);
+		REQUIRE(result.delta.empty());
+		REQUIRE(chosen(registry, result) == std::vector<std::string>{"app@1.0.0", "lib@2.0.0", "util@2.0.0"});
+
+		// Packages nothing requires any more are dropped
+		replace(registry, "app", "1.0.0", R"("res:lib": "*")");
+		replace(registry, "lib", "2.0.0");
+		result = resolver.update({registry.find("app", MUtilities::Version("1.0.0")),
+			registry.find("lib", MUtilities::Version("2.0.0"))});
+		REQUIRE(result.decisions == 0);
+		REQUIRE(swaps(registry, result) == std::vector<std::string>{"util@2.0.0 -> -"});
+
+		// New dependencies are searched for
+		replace(registry, "app", "1.0.0", R"("res:lib": "*", "res:extra": "*")");
+		result = resolver.update({registry.find("app", MUtilities::Version("1.0.0"))});
+		REQUIRE(result.solved);
+		REQUIRE(swaps(registry, result) == std::vector<std::string>{"- -> extra@1.0.0"});
+		REQUIRE(chosen(registry, result) == std::vector<std::string>{"app@1.0.0", "extra@1.0.0", "lib@2.0.0"});
+	}
+
+	SECTION("changed ranges swap as few versions as possible") {
+		add(registry, "app", "1.0.0", R"("res:lib": "*", "res:util": "*", "res:other": "*")");
+		add(registry, "lib", "1.0.0");
+		add(registry, "lib", "2.0.0", R"("res:util": ">=2.0.0")");
+		add(registry, "util", "1.0.0");
+		add(registry, "util", "2.0.0");
+		add(registry, "other", "1.0.0");
+
+		Resolver resolver(registry);
+		Resolver::result result = resolver.resolve({{"app", Range("*")}});
+		REQUIRE(chosen(registry, result) == std::vector<std::string>{"app@1.0.0", "lib@2.0.0", "other@1.0.0", "util@2.0.0"});
+
+		add(registry, "other", "2.0.0");
+		replace(registry, "app", "1.0.0", R"("res:lib": "*", "res:util": "<2.0.0", "res:other": "*")");
+		result = resolver.update({registry.find("app", MUtilities::Version("1.0.0")),
+			registry.find("other", MUtilities::Version("2.0.0"))});
+
+		REQUIRE(result.solved);
+		REQUIRE(swaps(registry, result) == std::vector<std::string>{"lib@2.0.0 -> lib@1.0.0", "util@2.0.0 -> util@1.0.0"});
+	}
+
+	SECTION("only the packages around a broken range are searched again") {
+		std::string leaves;
+		for (char c = 'a'; c <= 'j'; c++) {
+			add(registry, std::string("leaf") + c, "1.0.0");
+			leaves += std::string(R"(, "res:leaf)") + c + R"(": "*")";
+		}
+		add(registry, "app", "1.0.0", R"("res:lib": "*", "res:util": "*")" + leaves);
+		add(registry, "lib", "1.0.0");
+		add(registry, "lib", "2.0.0", R"("res:util": ">=2.0.0")");
+		add(registry, "util", "1.0.0");
+		add(registry, "util", "2.0.0");
+
+		Resolver resolver(registry);
+		Resolver::result result = resolver.resolve({{"app", Range("*")}});
+		REQUIRE(result.packages.size() == 13);
+		REQUIRE(result.decisions == 13);
+
+		replace(registry, "app", "1.0.0", R"("res:lib": "*", "res:util": "<2.0.0")" + leaves);
+		result = resolver.update({registry.find("app", MUtilities::Version("1.0.0"))});
+		REQUIRE(result.solved);
+		REQUIRE(result.decisions < 13);
+		REQUIRE(result.packages.size() == 13);
+		REQUIRE(swaps(registry, result) == std::vector<std::string>{"lib@2.0.0 -> lib@1.0.0", "util@2.0.0 -> util@1.0.0"});
+	}
+
+	SECTION("what was learned from changed packages is forgotten") {
+		add(registry, "foo", "1.0.0", R"("res:bar": "1.0.0")");
+		add(registry, "foo", "2.0.0", R"("res:bar": "2.0.0")");
+		add(registry, "bar", "1.0.0", R"("res:baz": "1.0.0")");
+		add(registry, "bar", "2.0.0", R"("res:baz": "2.0.0")");
+		add(registry, "baz", "1.0.0");
+		add(registry, "baz", "2.0.0");
+		add(registry, "boo", "1.0.0", R"("res:baz": "1.0.0")");
+
+		Resolver resolver(registry);
+		Resolver::result result = resolver.resolve({{"res:foo", Range("*")}, {"res:boo", Range("*")}});
+		REQUIRE(result.conflicts > 0);
+
+		// foo 2.0.0 was ruled out because of boo, which now allows it
+		replace(registry, "boo", "1.0.0", R"("res:baz": "2.0.0")");
+		result = resolver.update({registry.find("boo", MUtilities::Version("1.0.0"))});
+		REQUIRE(result.solved);
+		REQUIRE(swaps(registry, result) == std::vector<std::string>{"bar@1.0.0 -> bar@2.0.0", "baz@1.0.0 -> baz@2.0.0",
+			"foo@1.0.0 -> foo@2.0.0"});
+
+		// A failed update keeps the last solution to compare against
+		replace(registry, "boo", "1.0.0", R"("res:baz": "3.0.0")");
+		result = resolver.update({registry.find("boo", MUtilities::Version("1.0.0"))});
+		REQUIRE_FALSE(result.solved);
+		REQUIRE(result.delta.empty());
+
+		replace(registry, "boo", "1.0.0", R"("res:baz": "2.0.0")");
+		result = resolver.update({registry.find("boo", MUtilities::Version("1.0.0"))});
+		REQUIRE(result.solved);
+		REQUIRE(result.delta.empty());
+	}
+}
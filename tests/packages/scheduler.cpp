@@ -0,0 +1,171 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <packages/scheduler.hpp>
+
+#include "fixture.hpp"
+
+using namespace MPackages;
+using namespace MTests;
+
+namespace {
+	// Names of the packages in the order they finished running
+	std::mutex finishedMutex;
+	std::vector<std::string> finished;
+
+	class TimedPkg: public Pkg {
+		public:
+			TimedPkg(std::string path, std::string_view manifest, int milliseconds, bool succeed):
+				Pkg(path, manifest), _milliseconds(milliseconds), _succeed(succeed) {}
+
+			bool run() {
+				std::this_thread::sleep_for(std::chrono::milliseconds(this->_milliseconds));
+				std::lock_guard<std::mutex> lock(finishedMutex);
+				finished.emplace_back(this->name());
+				return this->_succeed;
+			}
+		private:
+			int _milliseconds;
+			bool _succeed;
+	};
+
+	// [id] Add a package with the given dependency and optional dependency members, sleeping while it runs
+	Registry::id add(Registry &registry, const std::string &name, const std::string &dependencies = "",
+			const std::string &optional = "", int milliseconds = 0, bool succeed = true) {
+		return registry.add(std::unique_ptr<Package>(new TimedPkg(name, manifestText(name, "1.0.0", dependencies, optional),
+			milliseconds, succeed)));
+	}
+
+	// [size_t] Position of a package in the finishing order
+	std::size_t position(const std::string &name) {
+		return std::find(finished.begin(), finished.end(), name) - finished.begin();
+	}
+
+	// [vector of strings] Names of packages
+	std::vector<std::string> names(const Registry &registry, const std::vector<Registry::id> &packages) {
+		std::vector<std::string> out;
+		for (Registry::id id: packages)
+			out.emplace_back(registry.get(id).name());
+		return out;
+	}
+}
+
+TEST_CASE("schedulers run packages after their dependencies", "[scheduler]") {
+	Registry registry;
+	finished.clear();
+
+	SECTION("every package runs once, after every dependency in the set") {
+		std::vector<Registry::id> packages;
+		for (int i = 0; i < 200; i++) {
+			// Packages outside of the set are not waited for
+			std::string dependencies = R"("res:missing": "*")";
+			for (int d: {i / 2, i / 3, i - 1})
+				if (d >= 0 && d < i && dependencies.find("pkg-" + std::to_string(d) + "\"") == std::string::npos)
+					dependencies += R"(, "res:pkg-)" + std::to_string(d) + R"(": "*")";
+			packages.push_back(add(registry, "pkg-" + std::to_string(i), dependencies));
+		}
+
+		Scheduler::result result = Scheduler(registry, 4).run(packages);
+		REQUIRE(result.completed);
+		REQUIRE(result.cycle.empty());
+		REQUIRE(result.workers == 4);
+		REQUIRE(finished.size() == 200);
+
+		for (int i = 1; i < 200; i++) {
+			REQUIRE(position("pkg-" + std::to_string(i / 2)) < position("pkg-" + std::to_string(i)));
+			REQUIRE(position("pkg-" + std::to_string(i - 1)) < position("pkg-" + std::to_string(i)));
+		}
+
+		for (std::size_t i = 0; i < packages.size(); i++) {
+			REQUIRE(result.timings[i].package == packages[i]);
+			REQUIRE(result.timings[i].status == Scheduler::Status::succeeded);
+			REQUIRE(result.timings[i].worker < 4);
+		}
+	}
+
+	SECTION("optional dependencies in the set are waited for") {
+		Registry::id app = add(registry, "app", "", R"("res:extra": "*")");
+		Registry::id extra = add(registry, "extra", "", "", 20);
+
+		REQUIRE(Scheduler(registry, 2).run({app, extra}).completed);
+		REQUIRE(finished == std::vector<std::string>({"extra", "app"}));
+	}
+
+	SECTION("the critical path is the chain taking longest to run") {
+		Registry::id base = add(registry, "base", "", "", 10);
+		Registry::id slow = add(registry, "slow", R"("res:base": "*")", "", 30);
+		Registry::id fast = add(registry, "fast", R"("res:base": "*")", "", 0);
+		Registry::id app = add(registry, "app", R"("res:slow": "*", "res:fast": "*")", "", 5);
+
+		Scheduler::result result = Scheduler(registry, 2).run({app, fast, slow, base});
+		REQUIRE(result.completed);
+		REQUIRE(names(registry, result.criticalPath) == std::vector<std::string>({"base", "slow", "app"}));
+		REQUIRE(result.criticalLength >= std::chrono::milliseconds(45));
+		REQUIRE(result.criticalLength <= result.work);
+		REQUIRE(result.wall >= result.criticalLength);
+		REQUIRE(result.timings[0].start >= result.timings[2].start + result.timings[2].duration);
+	}
+
+	SECTION("parallelism is capped by the number of threads") {
+		std::vector<Registry::id> packages;
+		for (int i = 0; i < 8; i++)
+			packages.push_back(add(registry, "pkg-" + std::to_string(i)));
+
+		Scheduler scheduler(registry, 3);
+		REQUIRE(scheduler.threads() == 3);
+		Scheduler::result result = scheduler.run(packages);
+		REQUIRE(result.workers == 3);
+		for (auto const &t: result.timings)
+			REQUIRE(t.worker < 3);
+
+		REQUIRE(Scheduler(registry, 16).run({packages[0], packages[1]}).workers == 2);
+		REQUIRE(Scheduler(registry).threads() >= 1);
+	}
+
+	SECTION("packages depending on a failed package are skipped") {
+		Registry::id base = add(registry, "base", "", "", 0, false);
+		Registry::id lib = add(registry, "lib", R"("res:base": "*")");
+		Registry::id app = add(registry, "app", R"("res:lib": "*")");
+		Registry::id other = add(registry, "other");
+
+		Scheduler::result result = Scheduler(registry, 2).run({base, lib, app, other});
+		REQUIRE(!result.completed);
+		REQUIRE(result.timings[0].status == Scheduler::Status::failed);
+		REQUIRE(result.timings[1].status == Scheduler::Status::skipped);
+		REQUIRE(result.timings[2].status == Scheduler::Status::skipped);
+		REQUIRE(result.timings[3].status == Scheduler::Status::succeeded);
+		REQUIRE(finished.size() == 2);
+	}
+
+	SECTION("cycles are reported and nothing runs") {
+		Registry::id a = add(registry, "alpha", R"("res:beta": "*")");
+		Registry::id b = add(registry, "beta", R"("res:gamma": "*")");
+		Registry::id c = add(registry, "gamma", "", R"("res:alpha": "*")");
+		Registry::id d = add(registry, "delta");
+		Registry::id e = add(registry, "epsilon", R"("res:alpha": "*")");
+
+		Scheduler::result result = Scheduler(registry, 2).run({e, d, a, b, c});
+		REQUIRE(!result.completed);
+		REQUIRE(names(registry, result.cycle) == std::vector<std::string>({"alpha", "beta", "gamma"}));
+		REQUIRE(finished.empty());
+
+		Registry::id self = add(registry, "loop", R"("res:loop": "*")");
+		REQUIRE(names(registry, Scheduler(registry, 2).run({self}).cycle) == std::vector<std::string>({"loop"}));
+	}
+
+	SECTION("sets with two versions of a package are rejected") {
+		Registry::id a = add(registry, "alpha");
+		Registry::id b = registry.add(std::unique_ptr<Package>(new TimedPkg("alpha",
+			R"({"name": "alpha", "version": "2.0.0"})", 0, true)));
+
+		REQUIRE_THROWS_WITH(Scheduler(registry, 2).run({a, b}), "MPackages::Scheduler::duplicatePackage");
+		REQUIRE(Scheduler(registry, 2).run({}).completed);
+	}
+}
@@ -0,0 +1,173 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <packages/watcher.hpp>
+
+#include "fixture.hpp"
+
+using namespace MPackages;
+using namespace MTests;
+
+namespace fs = std::filesystem;
+
+namespace {
+	// Names of the packages in the order they ran
+	std::vector<std::string> ran;
+
+	class RecordedPkg: public Pkg {
+		public:
+			RecordedPkg(std::string path, const Manifest &manifest): Pkg(path, manifest) {}
+
+			bool run() {
+				ran.emplace_back(this->name());
+				return true;
+			}
+	};
+
+	// [vector of strings] Poll until the changes have settled
+	std::vector<std::string> settle(Watcher &watcher) {
+		for (int i = 0; i < 500; i++) {
+			std::vector<std::string> changed = watcher.poll();
+			if (!changed.empty())
+				return changed;
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		return std::vector<std::string>();
+	}
+
+	// [id] Get the package of a name, of which the registry holds a single version
+	Registry::id find(const Registry &registry, const std::string &name) {
+		return registry.versions(name).at(0);
+	}
+}
+
+TEST_CASE("watchers reload changed manifests", "[watcher]") {
+	fs::path root = fs::temp_directory_path() / "eden-watcher-test";
+	fs::remove_all(root);
+
+	writeManifest(root / "alpha", manifestText("alpha", "1.0.0"));
+	writeManifest(root / "mods" / "beta", manifestText("beta", "1.0.0", R"("res:alpha": ">=1.0.0")"));
+	writeManifest(root / "mods" / "gamma", manifestText("gamma", "1.0.0", R"("res:beta": "*")"));
+	writeManifest(root / "delta", manifestText("delta", "1.0.0"));
+	fs::create_directories(root / "alpha" / "textures");
+
+	Loader loader([](std::string path, const Manifest &manifest) {
+		return std::unique_ptr<Package>(new RecordedPkg(std::move(path), manifest));
+	}, 1);
+	loader.addRoot(root.string());
+	Registry registry(loader.load().packages);
+	REQUIRE(registry.size() == 4);
+
+	Watcher watcher(registry, loader, std::chrono::milliseconds(0), 1);
+	std::vector<Registry::id> running;
+	for (std::string name: {"alpha", "beta", "delta", "gamma"})
+		running.push_back(find(registry, name));
+	watcher.setRunning(running);
+	ran.clear();
+
+	SECTION("package directories are watched, but not the directories below them") {
+		// The root, mods, and the four packages
+		REQUIRE(watcher.watches() == 6);
+		REQUIRE(watcher.descriptor() >= 0);
+		REQUIRE(watcher.poll().empty());
+	}
+
+	SECTION("a changed package is swapped in, and its running dependents run again in order") {
+		Registry::id alpha = find(registry, "alpha");
+		std::shared_ptr<const Package> before = registry.share(alpha);
+		writeManifest(root / "alpha", manifestText("alpha", "1.1.0"));
+
+		std::vector<std::string> changed = settle(watcher);
+		REQUIRE(changed == std::vector<std::string>({(root / "alpha" / Loader::manifestName).string()}));
+
+		Watcher::result result = watcher.reload(changed);
+		REQUIRE(result.errors.empty());
+		REQUIRE(result.changed == std::vector<Registry::id>({alpha}));
+		REQUIRE(result.affected.size() == 3);
+		REQUIRE(result.run.completed);
+		REQUIRE(ran == std::vector<std::string>({"alpha", "beta", "gamma"}));
+
+		// The id is kept, and a reader holding the old package keeps it
+		REQUIRE(registry.get(alpha).version() == std::string("1.1.0"));
+		REQUIRE(registry.share(alpha)->version() == std::string("1.1.0"));
+		REQUIRE(before->version() == std::string("1.0.0"));
+	}
+
+	SECTION("only the packages depending on a change run again") {
+		writeManifest(root / "mods" / "gamma", manifestText("gamma", "1.0.1", R"("res:beta": "*")"));
+		Watcher::result result = watcher.reload(settle(watcher));
+		REQUIRE(result.affected == std::vector<Registry::id>({find(registry, "gamma")}));
+		REQUIRE(ran == std::vector<std::string>({"gamma"}));
+
+		// Packages that are not running are swapped in, but do not run
+		watcher.setRunning({find(registry, "delta")});
+		writeManifest(root / "alpha", manifestText("alpha", "1.2.0"));
+		result = watcher.reload(settle(watcher));
+		REQUIRE(result.changed.size() == 1);
+		REQUIRE(result.affected.empty());
+		REQUIRE(ran.size() == 1);
+	}
+
+	SECTION("invalid and removed manifests keep their package") {
+		Registry::id beta = find(registry, "beta");
+		std::ofstream(root / "mods" / "beta" / Loader::manifestName) << R"({"name": "beta", "version": "x"})";
+		Watcher::result result = watcher.reload(settle(watcher));
+		REQUIRE(result.changed.empty());
+		REQUIRE(result.errors.size() == 1);
+		REQUIRE(registry.get(beta).version() == std::string("1.0.0"));
+		REQUIRE(ran.empty());
+
+		writeManifest(root / "mods" / "beta", manifestText("renamed", "1.0.0"));
+		result = watcher.reload(settle(watcher));
+		REQUIRE(result.errors.size() == 1);
+		REQUIRE(result.errors[0].message == "MPackages::Registry::renamedPackage");
+
+		fs::remove(root / "mods" / "beta" / Loader::manifestName);
+		result = watcher.reload(settle(watcher));
+		REQUIRE(result.errors.size() == 1);
+		REQUIRE(result.errors[0].message == "MPackages::Watcher::removedManifest");
+		REQUIRE(registry.get(beta).name() == "beta");
+	}
+
+	SECTION("packages in new directories are added") {
+		writeManifest(root / "mods" / "new" / "epsilon", manifestText("epsilon", "1.0.0"));
+		Watcher::result result = watcher.reload(settle(watcher));
+		REQUIRE(result.errors.empty());
+		REQUIRE(result.changed.size() == 1);
+		REQUIRE(registry.get(result.changed[0]).name() == "epsilon");
+		REQUIRE(registry.size() == 5);
+		REQUIRE(watcher.watches() == 8);
+
+		// Its manifest is now known
+		writeManifest(root / "mods" / "new" / "epsilon", manifestText("epsilon", "1.0.1"));
+		result = watcher.reload(settle(watcher));
+		REQUIRE(result.changed == std::vector<Registry::id>({4}));
+		REQUIRE(registry.size() == 5);
+	}
+
+	SECTION("a burst of edits is returned once it has settled") {
+		Watcher slow(registry, loader, std::chrono::milliseconds(100), 1);
+		for (int i = 0; i < 20; i++)
+			writeManifest(root / "alpha", manifestText("alpha", "1.0." + std::to_string(i)));
+		writeManifest(root / "delta", manifestText("delta", "1.0.1"));
+
+		auto start = std::chrono::steady_clock::now();
+		std::vector<std::string> changed = settle(slow);
+		REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(100));
+		REQUIRE(changed.size() == 2);
+
+		Watcher::result result = slow.reload(changed);
+		REQUIRE(result.changed.size() == 2);
+		REQUIRE(registry.get(find(registry, "alpha")).version() == std::string("1.0.19"));
+		REQUIRE(slow.poll().empty());
+	}
+
+	fs::remove_all(root);
+}
@@ -0,0 +1,168 @@
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <resources/loader.hpp>
+
+#include "../packages/fixture.hpp"
+
+using namespace MResources;
+using MTests::writeFile;
+
+namespace fs = std::filesystem;
+
+namespace {
+	// [string] Path of a numbered texture
+	std::string texture(int i) {
+		return "textures/" + std::to_string(i) + ".png";
+	}
+}
+
+TEST_CASE("resource loaders read files off the main thread", "[resources]") {
+	fs::path root = fs::temp_directory_path() / "eden-resources-test";
+	fs::remove_all(root);
+	for (int i = 0; i < 300; i++)
+		writeFile(root / "base" / texture(i), std::string(32768, static_cast<char>('a' + i % 26)));
+	writeFile(root / "base" / "scripts" / "init.lua", "print('init')");
+
+	MPackages::Overlay overlay;
+	overlay.mount("base", (root / "base").string());
+	std::vector<std::string> delivered;
+	auto record = [&delivered](const Loader::resource &res) {
+		delivered.push_back(std::string(res.path) + (res.error.empty() ? "" : " " + res.error) + " " +
+			std::to_string(res.data.size()));
+	};
+
+	SECTION("callbacks run from deliver with the file contents or an error") {
+		Loader loader(overlay, 2);
+		std::string contents;
+		loader.request("scripts/init.lua", Loader::Priority::soon, [&contents](const Loader::resource &res) {
+			contents = std::string(res.data);
+		});
+		loader.request("missing.png", Loader::Priority::soon, record);
+		REQUIRE(loader.pending() == 2);
+
+		loader.wait();
+		REQUIRE(contents.empty());
+		REQUIRE(loader.deliver(std::chrono::seconds(1)) == 2);
+		REQUIRE(contents == "print('init')");
+		REQUIRE(delivered == std::vector<std::string>({"missing.png MPackages::Overlay::missingFile 0"}));
+		REQUIRE(loader.pending() == 0);
+		REQUIRE(loader.deliver(std::chrono::seconds(1)) == 0);
+	}
+
+	SECTION("requests for a pending file share one read") {
+		Loader loader(overlay, 1);
+		for (int i = 0; i < 3; i++)
+			loader.request("scripts/init.lua", Loader::Priority::background, record);
+
+		loader.wait();
+		REQUIRE(loader.deliver(std::chrono::seconds(1)) == 3);
+		REQUIRE(delivered.size() == 3);
+		REQUIRE(loader.stats().reads == 1);
+		REQUIRE(loader.stats().coalesced == 2);
+
+		// A delivered file is read again
+		loader.request("scripts/init.lua", Loader::Priority::background, record);
+		loader.wait();
+		REQUIRE(loader.stats().reads == 2);
+	}
+
+	SECTION("cancelled requests get no callback") {
+		Loader loader(overlay, 1);
+		Loader::ticket kept = loader.request("scripts/init.lua", Loader::Priority::soon, record);
+		auto fail = [](const Loader::resource &) {
+			FAIL("cancelled callback ran");
+		};
+		Loader::ticket cancelled = loader.request("scripts/init.lua", Loader::Priority::soon, fail);
+		Loader::ticket alone = loader.request(texture(0), Loader::Priority::soon, fail);
+
+		REQUIRE(loader.cancel(cancelled));
+		REQUIRE(loader.cancel(alone));
+		REQUIRE(!loader.cancel(alone));
+		loader.wait();
+
+		REQUIRE(loader.deliver(std::chrono::seconds(1)) == 1);
+		REQUIRE(delivered == std::vector<std::string>({"scripts/init.lua 13"}));
+		REQUIRE(!loader.cancel(kept));
+		REQUIRE(loader.stats().cancelled == 2);
+	}
+
+	SECTION("urgent requests are read and delivered first") {
+		// Files swapped for FIFOs after mounting stop the I/O thread when it opens them, until they are
+		// opened for writing, which in turn waits for the thread
+		for (std::string name: {"a", "b", "c", "d"})
+			writeFile(root / "base" / "fifo" / name, "");
+		overlay.remount(overlay.mounted("base"));
+		for (std::string name: {"a", "b", "c", "d"}) {
+			fs::remove(root / "base" / "fifo" / name);
+			REQUIRE(::mkfifo((root / "base" / "fifo" / name).c_str(), 0600) == 0);
+		}
+		auto release = [&root](const std::string &name) {
+			::close(::open((root / "base" / "fifo" / name).c_str(), O_WRONLY));
+		};
+
+		// Expected order: a and b, then c, which a second request moves forward, then d and the prefetches
+		Loader loader(overlay, 1);
+		loader.request("fifo/a", Loader::Priority::now, record);
+		for (int i = 0; i < 300; i++)
+			loader.request(texture(i), Loader::Priority::background, record);
+		loader.request("fifo/c", Loader::Priority::background, record);
+		loader.request("fifo/b", Loader::Priority::now, record);
+		loader.request("fifo/c", Loader::Priority::soon, record);
+		loader.request("fifo/d", Loader::Priority::soon, record);
+
+		release("a");
+		release("b");
+		REQUIRE(loader.stats().reads <= 2);
+		release("c");
+		REQUIRE(loader.stats().reads <= 3);
+		release("d");
+		loader.wait();
+
+		for (int i = 0; i < 3; i++)
+			loader.deliver(std::chrono::nanoseconds(0));
+		REQUIRE(delivered == std::vector<std::string>({"fifo/a MPackages::Overlay::readFailed 0",
+			"fifo/b MPackages::Overlay::readFailed 0", "fifo/c MPackages::Overlay::readFailed 0",
+			"fifo/c MPackages::Overlay::readFailed 0"}));
+		REQUIRE(loader.deliver(std::chrono::seconds(1)) == 301);
+	}
+
+	SECTION("the budget limits the callbacks run per call") {
+		Loader loader(overlay, 2);
+		for (int i = 0; i < 10; i++)
+			loader.request(texture(i), Loader::Priority::soon, record);
+
+		loader.wait();
+		REQUIRE(loader.deliver(std::chrono::nanoseconds(0)) == 1);
+		REQUIRE(loader.deliver(std::chrono::seconds(1)) == 9);
+	}
+
+	SECTION("callbacks may request more files") {
+		Loader loader(overlay, 2);
+		loader.request("scripts/init.lua", Loader::Priority::now, [&](const Loader::resource &res) {
+			record(res);
+			loader.request(texture(1), Loader::Priority::now, record);
+		});
+
+		while (delivered.size() < 2) {
+			loader.wait();
+			loader.deliver(std::chrono::seconds(1));
+		}
+		REQUIRE(delivered[1] == texture(1) + " 32768");
+	}
+
+	SECTION("loaders with pending reads can be destroyed") {
+		Loader loader(overlay, 2);
+		for (int i = 0; i < 300; i++)
+			loader.request(texture(i), Loader::Priority::background, record);
+	}
+
+	fs::remove_all(root);
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <utilities/arena.hpp>
+
+using namespace MUtilities;
+
+TEST_CASE("arenas bump-allocate from a single block", "[arena]") {
+	SECTION("allocations are aligned and fill the block in order") {
+		Arena arena(64);
+		REQUIRE(arena.capacity() == 64);
+		REQUIRE(arena.used() == 0);
+
+		char *c = arena.allocate<char>(3);
+		std::uint64_t *n = arena.allocate<std::uint64_t>(2);
+		REQUIRE(reinterpret_cast<std::uintptr_t>(n) % alignof(std::uint64_t) == 0);
+		REQUIRE(reinterpret_cast<char *>(n) > c);
+		REQUIRE(arena.used() <= 3 + (alignof(std::uint64_t) - 1) + 2 * sizeof(std::uint64_t));
+	}
+
+	SECTION("strings are copied into the block") {
+		Arena arena(16);
+		std::string source = "eden";
+		std::string_view copy = arena.copy(source);
+		source[0] = 'x';
+		REQUIRE(copy == "eden");
+		REQUIRE(copy.data() != source.data());
+		REQUIRE(arena.used() == 4);
+
+		// Empty strings take no space
+		REQUIRE(arena.copy("").empty());
+		REQUIRE(arena.used() == 4);
+	}
+
+	SECTION("allocating past the capacity throws") {
+		Arena arena(8);
+		arena.allocate(6, 1);
+		REQUIRE_THROWS_WITH(arena.allocate(4, 1), "MUtilities::Arena::full");
+		REQUIRE_THROWS_WITH(Arena().allocate(1, 1), "MUtilities::Arena::full");
+		REQUIRE(arena.used() == 6);
+	}
+
+	SECTION("moving an arena keeps its contents in place") {
+		Arena arena(16);
+		std::string_view copy = arena.copy("moved");
+
+		Arena moved(std::move(arena));
+		REQUIRE(arena.capacity() == 0);
+		REQUIRE(moved.capacity() == 16);
+		REQUIRE(moved.used() == 5);
+		REQUIRE(copy == "moved");
+
+		Arena assigned(4);
+		assigned = std::move(moved);
+		REQUIRE(assigned.used() == 5);
+		REQUIRE(copy == "moved");
+	}
+}
+
+TEST_CASE("slices view consecutive objects", "[arena]") {
+	int values[] = {1, 2, 3};
+	Slice<int> slice(values, 3);
+	REQUIRE(slice.size() == 3);
+	REQUIRE(slice[1] == 2);
+	REQUIRE(*(slice.end() - 1) == 3);
+	REQUIRE(slice == Slice<int>(values, 3));
+	REQUIRE(slice != Slice<int>(values, 2));
+	REQUIRE(Slice<int>().empty());
+}
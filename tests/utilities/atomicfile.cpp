@@ -0,0 +1,60 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <utilities/atomicfile.hpp>
+
+using namespace MUtilities;
+
+namespace fs = std::filesystem;
+
+namespace {
+	// [string] Read a whole file
+	std::string contents(const fs::path &file) {
+		std::ifstream in(file, std::ios::binary);
+		std::stringstream out;
+		out << in.rdbuf();
+		return out.str();
+	}
+}
+
+TEST_CASE("atomic files replace their destination only once complete", "[atomicfile]") {
+	fs::path file = fs::temp_directory_path() / "eden-atomicfile-test";
+	fs::path temp = file.string() + ".tmp";
+	std::ofstream(file) << "old";
+
+	SECTION("whole contents are written at once") {
+		REQUIRE(AtomicFile::write(file.string(), std::string_view("new\0bytes", 9)));
+		REQUIRE(contents(file) == std::string("new\0bytes", 9));
+		REQUIRE_FALSE(fs::exists(temp));
+	}
+
+	SECTION("the destination is unchanged until the file is committed") {
+		{
+			AtomicFile atomic(file.string());
+			REQUIRE(atomic.write("par"));
+			atomic.stream() << "ts";
+			REQUIRE(contents(file) == "old");
+			REQUIRE(atomic.commit());
+		}
+		REQUIRE(contents(file) == "parts");
+		REQUIRE_FALSE(fs::exists(temp));
+	}
+
+	SECTION("files that are not committed are removed") {
+		{
+			AtomicFile atomic(file.string());
+			atomic.write("abandoned");
+		}
+		REQUIRE(contents(file) == "old");
+		REQUIRE_FALSE(fs::exists(temp));
+	}
+
+	SECTION("files that can not be created fail to commit") {
+		REQUIRE_FALSE(AtomicFile::write((file / "below-a-file").string(), "bytes"));
+	}
+
+	fs::remove(file);
+}
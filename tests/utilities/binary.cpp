@@ -0,0 +1,24 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <cstdint>
+
+#include <utilities/binary.hpp>
+
+using namespace MUtilities;
+
+TEST_CASE("integers are written and read back as bytes", "[binary]") {
+	std::string bytes = "x";
+	Binary::put<std::uint32_t>(bytes, 0xdeadbeef);
+	Binary::put<std::int64_t>(bytes, -2);
+	REQUIRE(bytes.size() == 13);
+	REQUIRE(Binary::get<std::uint32_t>(bytes, 1) == 0xdeadbeef);
+	REQUIRE(Binary::get<std::int64_t>(bytes, 5) == -2);
+}
+
+TEST_CASE("offsets are aligned to powers of two", "[binary]") {
+	REQUIRE(Binary::align(0, 64) == 0);
+	REQUIRE(Binary::align(1, 64) == 64);
+	REQUIRE(Binary::align(64, 64) == 64);
+	REQUIRE(Binary::align(65, 8) == 72);
+}
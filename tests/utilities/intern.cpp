@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <utilities/intern.hpp>
+#include <utilities/range.hpp>
+#include <utilities/version.hpp>
+
+using namespace MUtilities;
+
+TEST_CASE("intern tables share one object per source string", "[intern]") {
+	InternTable<Version> table;
+
+	SECTION("repeated lookups return the same instance") {
+		auto a = table.get("1.2.3");
+		auto b = table.get(std::string("1.2.3"));
+		auto c = table.get("1.2.4");
+		REQUIRE(a == b);
+		REQUIRE(a != c);
+		REQUIRE(*a == Version("1.2.3"));
+		REQUIRE(table.size() == 2);
+	}
+
+	SECTION("parse errors propagate and are not cached") {
+		REQUIRE_THROWS(table.get("1.2"));
+		REQUIRE(table.size() == 0);
+	}
+
+	SECTION("cleared entries stay valid for existing holders") {
+		auto a = table.get("2.0.0");
+		table.clear();
+		REQUIRE(table.size() == 0);
+		REQUIRE(*a == Version("2.0.0"));
+		REQUIRE(table.get("2.0.0") != a);
+	}
+
+	SECTION("concurrent lookups agree on a single instance") {
+		std::vector<std::shared_ptr<const Version>> results(8);
+		std::vector<std::thread> threads;
+		for (int i = 0; i < 8; i++) {
+			threads.push_back(std::thread([&table, &results, i] {
+				results[i] = table.get("3.1.4");
+			}));
+		}
+		for (auto &t: threads)
+			t.join();
+
+		for (auto const &r: results)
+			REQUIRE(r == results[0]);
+	}
+}
+
+TEST_CASE("versions and ranges have global intern tables", "[intern]") {
+	REQUIRE(Version::intern("0.2.0") == Version::intern("0.2.0"));
+	REQUIRE(Range::intern(">=0.2.0 <1.0.0") == Range::intern(">=0.2.0 <1.0.0"));
+
+	SECTION("copies of an interned range share its compiled data") {
+		Range a = *Range::intern(">=0.2.0 <1.0.0");
+		Range b = a;
+		REQUIRE(a == b);
+		REQUIRE(&a.intervals() == &b.intervals());
+		REQUIRE(b.satisfiedBy("0.5.0"));
+	}
+}
@@ -0,0 +1,41 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+#include <utilities/mappedfile.hpp>
+
+using namespace MUtilities;
+
+namespace fs = std::filesystem;
+
+TEST_CASE("mapped files expose the contents of a file", "[mappedfile]") {
+	fs::path file = fs::temp_directory_path() / "eden-mappedfile-test";
+
+	SECTION("contents are mapped whole") {
+		std::ofstream(file, std::ios::binary) << std::string("map\0me", 6);
+		MappedFile mapped(file.string());
+		REQUIRE(mapped.size() == 6);
+		REQUIRE(mapped.view() == std::string_view("map\0me", 6));
+	}
+
+	SECTION("lazy mappings read the same contents") {
+		std::ofstream(file, std::ios::binary) << "lazy";
+		MappedFile mapped(file.string(), false);
+		REQUIRE(mapped.view() == "lazy");
+	}
+
+	SECTION("empty files map to no bytes") {
+		std::ofstream(file, std::ios::binary).close();
+		MappedFile mapped(file.string());
+		REQUIRE(mapped.data() == nullptr);
+		REQUIRE(mapped.view().empty());
+	}
+
+	SECTION("missing files and directories can not be mapped") {
+		REQUIRE_THROWS_WITH(MappedFile((file / "missing").string()), "MUtilities::MappedFile::openFailed");
+		REQUIRE_THROWS_WITH(MappedFile(fs::temp_directory_path().string()), "MUtilities::MappedFile::openFailed");
+	}
+
+	fs::remove(file);
+}
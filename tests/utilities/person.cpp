@@ -114,3 +114,61 @@ TEST_CASE("person objects can be compared", "[person]") {
 			Utility::stojson(R"({"name": "John Doe", "url": "https://doe.com"})"));
 	}
 }
+
+TEST_CASE("person strings follow the name <email> (url) grammar", "[person]") {
+	SECTION("whitespace separates the name from the email and url") {
+		Person person(std::string("Dr. John Doe   <j@doe.com>\t(http://doe.com)"));
+		REQUIRE(person.name() == "Dr. John Doe");
+		REQUIRE(person.email() == "j@doe.com");
+		REQUIRE(person.url() == "http://doe.com");
+		REQUIRE_THROWS(Person(std::string("John Doe<j@doe.com>")));
+	}
+
+	SECTION("email and url must be in order") {
+		REQUIRE_THROWS(Person(std::string("John Doe (http://doe.com) <j@doe.com>")));
+	}
+
+	SECTION("email and url are validated") {
+		REQUIRE_THROWS(Person(std::string("John Doe <jdoe.com>")));
+		REQUIRE_THROWS(Person(std::string("John Doe (doe.com)")));
+	}
+
+	SECTION("views can be parsed directly") {
+		std::string_view str = "John Doe <j@doe.com>, Jane Doe";
+		Person person(str.substr(0, 20));
+		REQUIRE(person.email() == "j@doe.com");
+	}
+}
+
+TEST_CASE("identical people share interned storage", "[person]") {
+	Person a(std::string("John Doe <j@doe.com>"));
+	Person b(Utility::stojson(R"({"name": "John Doe", "email": "j@doe.com"})"));
+	Person c(std::string("John Doe <j@doe.com> (http://doe.com)"));
+
+	REQUIRE(a == b);
+	REQUIRE(a != c);
+	REQUIRE(Person::intern("John Doe <j@doe.com>") == Person::intern(std::string("John Doe <j@doe.com>")));
+	REQUIRE(*Person::intern("John Doe <j@doe.com>") == a);
+	REQUIRE_THROWS(Person::intern("<j@doe.com>"));
+}
+
+TEST_CASE("people can be parsed without throwing", "[person]") {
+	std::optional<Person> person;
+
+	SECTION("errors are returned as the constructor throws them") {
+		REQUIRE(Person::parse(std::string_view("John Doe <jdoe.com>"), person) ==
+			std::string("MUtilities::Person::invalidEmail"));
+		REQUIRE(Person::parse(std::string_view("<j@doe.com>"), person) ==
+			std::string("MUtilities::Person::invalidPersonString"));
+		REQUIRE(Person::parse(Utility::stojson(R"({"email": "j@doe.com"})"), person) ==
+			std::string("MUtilities::Person::nameCannotBeNull"));
+		REQUIRE_FALSE(person.has_value());
+	}
+
+	SECTION("valid people are stored") {
+		REQUIRE(Person::parse(std::string_view("John Doe <j@doe.com>"), person) == nullptr);
+		REQUIRE(*person == Person(std::string("John Doe <j@doe.com>")));
+		REQUIRE(Person::parse(Utility::stojson(R"({"name": "Jane Doe"})"), person) == nullptr);
+		REQUIRE(person->name() == "Jane Doe");
+	}
+}
@@ -145,3 +145,132 @@ TEST_CASE("range objects can be compared", "[range]") {
 		REQUIRE_FALSE(Range(">6.8.3 <9.1.3") != ">6.8.3 <9.1.3");
 	}
 }
+
+TEST_CASE("ranges are compiled into sorted, disjoint intervals", "[range]") {
+	SECTION("overlapping and adjacent comparator sets are merged") {
+		Range r("<2.0.0 || >=1.5.0 <3.0.0 || >=3.0.0 <4.0.0");
+		REQUIRE(r.intervals().size() == 1);
+		REQUIRE_FALSE(r.intervals()[0].hasLower);
+		REQUIRE(r.intervals()[0].upper == Version("4.0.0"));
+		REQUIRE_FALSE(r.intervals()[0].upperInclusive);
+	}
+
+	SECTION("unsatisfiable comparator sets are dropped") {
+		Range r(">2.0.0 <1.0.0 || 1.2.3");
+		REQUIRE(r.intervals().size() == 1);
+		REQUIRE(r.satisfiedBy("1.2.3"));
+		REQUIRE_FALSE(r.satisfiedBy("1.5.0"));
+	}
+
+	SECTION("bounds respect inclusivity at the edges") {
+		Range r(">1.0.0 <=2.0.0 || 3.0.0 || >=5.0.0");
+		REQUIRE(r.intervals().size() == 3);
+		REQUIRE_FALSE(r.satisfiedBy("1.0.0"));
+		REQUIRE(r.satisfiedBy("1.0.1-alpha"));
+		REQUIRE(r.satisfiedBy("2.0.0"));
+		REQUIRE_FALSE(r.satisfiedBy("2.0.1"));
+		REQUIRE(r.satisfiedBy("3.0.0"));
+		REQUIRE_FALSE(r.satisfiedBy("4.9.9"));
+		REQUIRE(r.satisfiedBy("5.0.0"));
+		REQUIRE(r.satisfiedBy("99.0.0"));
+	}
+
+	SECTION("an empty range is satisfied by nothing") {
+		REQUIRE_FALSE(Range().satisfiedBy("1.0.0"));
+		REQUIRE_FALSE(Range("").satisfiedBy("1.0.0"));
+	}
+}
+
+TEST_CASE("ranges can be intersected and united", "[range]") {
+	SECTION("intersection keeps versions satisfying both ranges") {
+		Range r = Range(">=1.0.0 <3.0.0 || >=4.0.0").intersect(Range(">2.0.0 <4.5.0"));
+		REQUIRE(r == ">2.0.0 <3.0.0 || >=4.0.0 <4.5.0");
+		REQUIRE(r.satisfiedBy("2.5.0"));
+		REQUIRE(r.satisfiedBy("4.2.0"));
+		REQUIRE_FALSE(r.satisfiedBy("2.0.0"));
+		REQUIRE_FALSE(r.satisfiedBy("3.5.0"));
+		REQUIRE_FALSE(r.satisfiedBy("4.5.0"));
+
+		REQUIRE(Range("<=1.0.0").intersect(Range(">=1.0.0")) == "=1.0.0");
+		REQUIRE(Range("<1.0.0").intersect(Range(">=1.0.0")).intervals().empty());
+	}
+
+	SECTION("union keeps versions satisfying either range") {
+		Range r = Range("<1.0.0").unite(Range(">=1.0.0 <2.0.0")).unite(Range("3.0.0"));
+		REQUIRE(r == "<2.0.0 || =3.0.0");
+		REQUIRE(r.satisfiedBy("0.1.0"));
+		REQUIRE(r.satisfiedBy("1.5.0"));
+		REQUIRE(r.satisfiedBy("3.0.0"));
+		REQUIRE_FALSE(r.satisfiedBy("2.5.0"));
+	}
+}
+
+TEST_CASE("malformed ranges are rejected", "[range]") {
+	REQUIRE_THROWS_WITH(Range("1.0.0 | 2.0.0"), "MUtilities::Range::invalidRange");
+	REQUIRE_THROWS_WITH(Range(">1.0.0  <2.0.0"), "MUtilities::Range::set::invalidComparatorSet");
+	REQUIRE_THROWS(Range("=>1.0.0"));
+	REQUIRE_THROWS(Range(">1.0.0 <"));
+	REQUIRE_THROWS(Range(">1.0"));
+	REQUIRE_NOTHROW(Range("  >=1.0.0 <2.0.0 ||  3.0.0 "));
+
+	SECTION("parsing returns the error instead of throwing it") {
+		Range r;
+		REQUIRE(Range::parse("1.0.0 | 2.0.0", r) == std::string("MUtilities::Range::invalidRange"));
+		REQUIRE(Range::parse(">1.0.0 <", r) == std::string("MUtilities::Range::comparator::invalidComparatorString"));
+		REQUIRE(Range::parse(">1.0", r) == std::string(Version::errorString(Version::ParseError::invalidVersionStructure)));
+		REQUIRE(r.empty());
+		REQUIRE(Range::parse(">=1.0.0 <2.0.0", r) == nullptr);
+		REQUIRE(r == Range(">=1.0.0 <2.0.0"));
+	}
+
+	SECTION("interning without throwing shares the interned range") {
+		const char *error = nullptr;
+		REQUIRE(Range::tryIntern(">1.0.0  <2.0.0", error) == nullptr);
+		REQUIRE(error == std::string("MUtilities::Range::set::invalidComparatorSet"));
+		REQUIRE(Range::tryIntern(">=4.0.0", error) == Range::intern(">=4.0.0"));
+	}
+}
+
+TEST_CASE("ranges format back to equal ranges", "[range]") {
+	REQUIRE(Range(">=1.0.0 <2.0.0 || 3.0.0-rc.1").str() == ">=1.0.0 <2.0.0 || 3.0.0-rc.1");
+	REQUIRE(Range("  =1.0.0 ||  <=0.5.0 ").str() == "1.0.0 || <=0.5.0");
+	REQUIRE(Range().str().empty());
+
+	Range r = Range(">=1.0.0 <3.0.0 || >=4.0.0").intersect(Range(">2.0.0 <4.5.0"));
+	REQUIRE(Range(r.str()) == r);
+}
+
+TEST_CASE("ranges support set algebra", "[range]") {
+	SECTION("an asterisk matches every version") {
+		REQUIRE(Range("*").satisfiedBy("0.0.0-alpha"));
+		REQUIRE(Range("*").satisfiedBy("99.0.0"));
+		REQUIRE(Range("*").str() == "*");
+		REQUIRE(Range::all().str() == "*");
+		REQUIRE(Range("<1.0.0 || *").subsetOf(Range::all()));
+		REQUIRE(Range::all().subsetOf(Range("*")));
+	}
+
+	SECTION("complements hold exactly the versions a range does not") {
+		Range r(">=1.0.0 <2.0.0 || =3.0.0 || >4.0.0");
+		Range c = r.complement();
+		REQUIRE(c.str() == "<1.0.0 || >=2.0.0 <3.0.0 || >3.0.0 <=4.0.0");
+		for (const char *v: {"0.9.0", "1.0.0", "1.5.0", "2.0.0", "3.0.0", "3.0.1", "4.0.0", "4.0.1"})
+			REQUIRE(r.satisfiedBy(v) != c.satisfiedBy(v));
+
+		REQUIRE(Range().complement().str() == "*");
+		REQUIRE(Range::all().complement().empty());
+		REQUIRE(c.complement().str() == ">=1.0.0 <2.0.0 || 3.0.0 || >4.0.0");
+	}
+
+	SECTION("subsets and overlaps are decided on intervals") {
+		REQUIRE(Range(">=1.2.0 <1.5.0").subsetOf(Range(">=1.0.0 <2.0.0")));
+		REQUIRE(Range("1.0.0 || 1.5.0").subsetOf(Range(">=1.0.0 <2.0.0")));
+		REQUIRE_FALSE(Range(">=1.2.0 <2.5.0").subsetOf(Range(">=1.0.0 <2.0.0")));
+		REQUIRE(Range().subsetOf(Range()));
+
+		REQUIRE(Range(">=1.2.0").intersects(Range("<1.3.0")));
+		REQUIRE_FALSE(Range("<1.0.0").intersects(Range(">=1.0.0")));
+		REQUIRE_FALSE(Range("<1.0.0 || >2.0.0").intersects(Range("1.0.0 || 2.0.0")));
+		REQUIRE_FALSE(Range().intersects(Range::all()));
+	}
+}
@@ -0,0 +1,39 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include <utilities/threadpool.hpp>
+
+using namespace MUtilities;
+
+TEST_CASE("thread pools run submitted tasks", "[threadpool]") {
+	ThreadPool pool(4);
+	REQUIRE(pool.size() == 4);
+
+	SECTION("wait blocks until every task has finished") {
+		std::atomic<int> count(0);
+		for (int i = 0; i < 1000; i++)
+			pool.submit([&]() { count++; });
+
+		pool.wait();
+		REQUIRE(count == 1000);
+	}
+
+	SECTION("parallelFor covers every index exactly once") {
+		std::vector<int> hits(10007, 0);
+		pool.parallelFor(hits.size(), [&](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; i++)
+				hits[i]++;
+		});
+
+		REQUIRE(std::all_of(hits.begin(), hits.end(), [](int h) { return h == 1; }));
+		REQUIRE_NOTHROW(pool.parallelFor(0, [](std::size_t, std::size_t) {}));
+	}
+
+	SECTION("exceptions thrown by tasks are rethrown by wait") {
+		pool.submit([]() { throw "error"; });
+		REQUIRE_THROWS(pool.wait());
+		REQUIRE_NOTHROW(pool.wait());
+	}
+}
@@ -2,6 +2,8 @@
 #include <iostream>
 
 #include <json/json.h>
+#include <filesystem>
+#include <fstream>
 
 #include <utilities/utility.hpp>
 
@@ -26,8 +28,49 @@ TEST_CASE("a string is parsed to a json value", "[utility]") {
 	REQUIRE(obj["int"].asInt() == 11);
 }
 
+TEST_CASE("parse errors are returned instead of discarded", "[utility]") {
+	Json::Value obj;
+	std::string errors;
+
+	SECTION("strings are parsed in place") {
+		std::string_view str = R"({"key": [1, 2]} trailing)";
+		REQUIRE(stojson(str.substr(0, 15), obj, errors));
+		REQUIRE(errors.empty());
+		REQUIRE(obj["key"][1].asInt() == 2);
+
+		REQUIRE_FALSE(stojson(R"({"key": })", obj, errors));
+		REQUIRE_FALSE(errors.empty());
+	}
+
+	SECTION("files are mapped and parsed") {
+		std::string file = (std::filesystem::temp_directory_path() / "eden-utility-test.json").string();
+		std::ofstream(file) << R"({"name": "pkg", "keywords": ["one"]})";
+		REQUIRE(ftojson(file, obj, errors));
+		REQUIRE(obj["keywords"][0].asString() == "one");
+
+		std::ofstream(file) << R"({"name": "pkg",)";
+		REQUIRE_FALSE(ftojson(file, obj, errors));
+		REQUIRE(errors.find("Line 1") != std::string::npos);
+
+		std::ofstream(file).close();
+		REQUIRE_FALSE(ftojson(file, obj, errors));
+		REQUIRE_FALSE(errors.empty());
+
+		std::filesystem::remove(file);
+		REQUIRE_THROWS_WITH(ftojson(file, obj, errors), "MUtilities::MappedFile::openFailed");
+	}
+}
+
 TEST_CASE("check if a string ends with the provided suffix", "[utility]") {
 	REQUIRE_FALSE(hasSuffix("no", ".git"));
 	REQUIRE_FALSE(hasSuffix("verylong.com", ".git"));
 	REQUIRE(hasSuffix("https://doe.com/hello.git", ".git"));
 }
+
+TEST_CASE("bytes are hashed with fnv-1a", "[utility]") {
+	REQUIRE(fnv1a("") == 0xcbf29ce484222325ull);
+	REQUIRE(fnv1a("a") == 0xaf63dc4c8601ec8cull);
+	REQUIRE(fnv1a("foobar") == 0x85944171f73967e8ull);
+	REQUIRE(fnv1a(std::string_view("a\0b", 3)) != fnv1a("ab"));
+	REQUIRE(fnv1a("bar", fnv1a("foo")) == fnv1a("foobar"));
+}
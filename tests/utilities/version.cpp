@@ -227,3 +227,79 @@ TEST_CASE("operator overloads compare the main version and prerelease but ignore
 		}
 	}
 }
+
+TEST_CASE("versions are ordered through a packed precedence key", "[version]") {
+	SECTION("three-way comparison agrees with the operators") {
+		REQUIRE(Version("1.2.3").compare(Version("1.2.3+meta")) == 0);
+		REQUIRE(Version("1.2.3").compare(Version("1.2.4")) < 0);
+		REQUIRE(Version("2.0.0").compare(Version("1.9.9")) > 0);
+		REQUIRE(Version("1.0.0-rc.1").compare(Version("1.0.0")) < 0);
+		REQUIRE(Version("1.0.0").compare(Version("1.0.0-alpha")) > 0);
+		REQUIRE_FALSE(Version("1.0.0") < Version("1.0.0-alpha"));
+	}
+
+	SECTION("keys sort in precedence order") {
+		REQUIRE(Version("1.0.0-alpha").key() < Version("1.0.0-alpha.1").key());
+		REQUIRE(Version("1.0.0-alpha.1").key() < Version("1.0.0-beta").key());
+		REQUIRE(Version("1.0.0-rc.11").key() < Version("1.0.0").key());
+		REQUIRE(Version("1.0.0").key() < Version("1.0.1").key());
+		REQUIRE(Version("1.2.3+one").key() == Version("1.2.3+two").key());
+	}
+
+	SECTION("fields too large for the key still compare correctly") {
+		REQUIRE(Version("70000.1.0") > Version("65535.9.9"));
+		REQUIRE(Version("70000.1.0") < Version("70000.2.0"));
+		REQUIRE(Version("80000.0.0") > Version("70000.5.0"));
+		REQUIRE(Version("1.0.0-rc.20000") < Version("1.0.0-rc.30000"));
+		REQUIRE(Version("1.0.0-rc.20000") == Version("1.0.0-rc.20000"));
+	}
+}
+
+TEST_CASE("versions can be parsed without throwing", "[version]") {
+	SECTION("valid strings fill the output version") {
+		Version v;
+		REQUIRE(Version::parse("43.12.38-rc.25+build", v) == Version::ParseError::none);
+		REQUIRE(v.major() == 43);
+		REQUIRE(v.minor() == 12);
+		REQUIRE(v.patch() == 38);
+		REQUIRE(v.prerelease().first == "rc");
+		REQUIRE(v.prerelease().second == 25);
+		REQUIRE(v.meta() == "build");
+	}
+
+	SECTION("malformed strings return an error code and leave the output untouched") {
+		Version v("1.2.3");
+		REQUIRE(Version::parse("01.2.5", v) == Version::ParseError::leadingZerosDisallowed);
+		REQUIRE(Version::parse("1.2.5-rc.05", v) == Version::ParseError::leadingZerosDisallowed);
+		REQUIRE(Version::parse("a.b.c", v) == Version::ParseError::invalidVersionNumber);
+		REQUIRE(Version::parse("1.2.3.4", v) == Version::ParseError::invalidVersionNumber);
+		REQUIRE(Version::parse("1.6.3-rc.d", v) == Version::ParseError::invalidVersionNumber);
+		REQUIRE(Version::parse("99999999999.0.0", v) == Version::ParseError::invalidVersionNumber);
+		REQUIRE(Version::parse("", v) == Version::ParseError::invalidVersionStructure);
+		REQUIRE(Version::parse("1.2", v) == Version::ParseError::invalidVersionStructure);
+		REQUIRE(Version::parse("1.2-rc", v) == Version::ParseError::invalidVersionStructure);
+		REQUIRE(Version::parse("1.6.3-rc.0", v) == Version::ParseError::prereleaseVersionIsZero);
+		REQUIRE(Version::parse("1.6.3-gamma", v) == Version::ParseError::invalidPrereleaseType);
+		REQUIRE(Version::parse("1.6.3+meta&!more", v) == Version::ParseError::invalidBuildMeta);
+		REQUIRE(v == Version("1.2.3"));
+	}
+
+	SECTION("the throwing constructor reports the same errors") {
+		REQUIRE_THROWS_WITH(Version("1.6.3-gamma"), Version::errorString(Version::ParseError::invalidPrereleaseType));
+	}
+
+	SECTION("interning without throwing reports the same errors") {
+		const char *error = nullptr;
+		REQUIRE(Version::tryIntern("1.6.3-gamma", error) == nullptr);
+		REQUIRE(error == Version::errorString(Version::ParseError::invalidPrereleaseType));
+		REQUIRE(Version::tryIntern("1.6.3", error) == Version::intern("1.6.3"));
+	}
+}
+
+TEST_CASE("versions format back to equal versions", "[version]") {
+	for (const char *v: {"0.0.0", "1.2.3", "1.2.3-beta", "1.2.3-rc.4", "10.20.30+build.5", "1.0.0-alpha.2+meta"})
+		REQUIRE(Version(v).str() == v);
+
+	Version big("70000.0.0");
+	REQUIRE(Version(big.str()) == big);
+}
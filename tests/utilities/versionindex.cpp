@@ -0,0 +1,77 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include <utilities/range.hpp>
+#include <utilities/version.hpp>
+#include <utilities/versionindex.hpp>
+
+using namespace MUtilities;
+
+namespace {
+	VersionIndex makeIndex() {
+		std::vector<Version> versions;
+		for (auto s: {"2.0.0", "0.9.0", "1.0.0-rc.1", "1.0.0", "1.2.0", "1.4.7", "3.0.0-beta", "1.2.0+dup"})
+			versions.push_back(Version(s));
+		return VersionIndex(versions);
+	}
+}
+
+TEST_CASE("version indexes keep versions sorted and unique", "[versionindex]") {
+	VersionIndex index = makeIndex();
+	REQUIRE(index.size() == 7);
+	for (std::size_t i = 1; i < index.size(); i++)
+		REQUIRE(index.versions()[i - 1] < index.versions()[i]);
+
+	SECTION("versions can be inserted and erased") {
+		REQUIRE(index.insert(Version("1.3.0")));
+		REQUIRE_FALSE(index.insert(Version("1.3.0")));
+		REQUIRE(index.contains(Version("1.3.0")));
+		REQUIRE(index.versions()[4] == Version("1.3.0"));
+		REQUIRE(index.erase(Version("1.3.0")));
+		REQUIRE_FALSE(index.erase(Version("1.3.0")));
+		REQUIRE_FALSE(index.contains(Version("1.3.0")));
+	}
+}
+
+TEST_CASE("version indexes answer range queries", "[versionindex]") {
+	VersionIndex index = makeIndex();
+
+	SECTION("highest and lowest satisfying versions") {
+		REQUIRE(*index.maxSatisfying(Range(">=1.0.0 <2.0.0")) == Version("1.4.7"));
+		REQUIRE(*index.minSatisfying(Range(">=1.0.0 <2.0.0")) == Version("1.0.0"));
+		REQUIRE(*index.maxSatisfying(Range("<1.0.0")) == Version("1.0.0-rc.1"));
+		REQUIRE(*index.maxSatisfying(Range("<=1.2.0 || 2.0.0")) == Version("2.0.0"));
+		REQUIRE(*index.minSatisfying(Range(">1.2.0")) == Version("1.4.7"));
+		REQUIRE(*index.maxSatisfying(Range(">2.0.0")) == Version("3.0.0-beta"));
+		REQUIRE(index.maxSatisfying(Range(">=4.0.0")) == nullptr);
+		REQUIRE(index.minSatisfying(Range("1.3.0")) == nullptr);
+	}
+
+	SECTION("all satisfying versions in ascending order") {
+		auto all = index.allSatisfying(Range("<1.0.0 || >1.2.0 <3.0.0"));
+		REQUIRE(all.size() == 5);
+		REQUIRE(*all[0] == Version("0.9.0"));
+		REQUIRE(*all[1] == Version("1.0.0-rc.1"));
+		REQUIRE(*all[2] == Version("1.4.7"));
+		REQUIRE(*all[3] == Version("2.0.0"));
+		REQUIRE(*all[4] == Version("3.0.0-beta"));
+	}
+
+	SECTION("batches of ranges are answered in order") {
+		std::vector<Range> ranges = {Range("<1.2.0"), Range(">=5.0.0"), Range("1.2.0")};
+		auto max = index.maxSatisfying(ranges);
+		auto min = index.minSatisfying(ranges);
+		REQUIRE(*max[0] == Version("1.0.0"));
+		REQUIRE(max[1] == nullptr);
+		REQUIRE(*max[2] == Version("1.2.0"));
+		REQUIRE(*min[0] == Version("0.9.0"));
+		REQUIRE(min[1] == nullptr);
+	}
+
+	SECTION("results agree with Range::maxSatisfiedBy") {
+		Range r(">0.9.0 <1.4.7");
+		REQUIRE(*index.maxSatisfying(r) == r.maxSatisfiedBy(index.versions()));
+	}
+}
@@ -0,0 +1,27 @@
+#include <iostream>
+#include <string>
+
+#include <packages/archive.hpp>
+
+// Packs a package directory into an archive, by default next to it: EdenPack <directory> [<archive>]
+int main(int argc, char **argv) {
+	if (argc < 2 || argc > 3) {
+		std::cout << "Usage: " << argv[0] << " <package directory> [<archive>]" << std::endl;
+		return 1;
+	}
+
+	std::string directory = argv[1];
+	while (directory.size() > 1 && directory.back() == '/')
+		directory.pop_back();
+	std::string archive = (argc == 3) ? argv[2] : directory + MPackages::Archive::extension;
+
+	try {
+		std::size_t files = MPackages::Archive::pack(directory, archive);
+		std::cout << "Packed " << files << " files into " << archive << std::endl;
+	} catch (const char *e) {
+		std::cout << "Failed to pack " << directory << ": " << e << std::endl;
+		return 1;
+	}
+
+	return 0;
+}